@@ -5,6 +5,13 @@
 #include <sstream>
 #include <libmem.h>
 #include "include/api.h"
+#include "include/input_events.h"
+#include "include/memory_scanner.h"
+#include "include/mod_commands.h"
+#include "include/pointer_paths.h"
+#include "include/texture_manager.h"
+#include "include/vmt_hooks.h"
+#include "include/vtable_index.h"
 
 ModApi* ModApi::instance = NULL;
 
@@ -30,4 +37,92 @@ uintptr_t ModApi::GetSkyBase() {
 
 uintptr_t ModApi::GetSkySize() {
     return skySize;
+}
+
+ModTexture* ModApi::LoadTextureAsync(const std::string& path) {
+    return TextureManager::Load(path);
+}
+
+void* ModApi::GetTextureId(ModTexture* texture, uint32_t* width, uint32_t* height) {
+    return TextureManager::GetId(texture, width, height);
+}
+
+void ModApi::ReleaseTexture(ModTexture* texture) {
+    TextureManager::Release(texture);
+}
+
+bool ModApi::GetRenderTarget(ModRenderTarget& target) {
+    return ModCommands::GetRenderTarget(target);
+}
+
+VkCommandBuffer ModApi::BeginCommandBuffer() {
+    return ModCommands::Begin();
+}
+
+void ModApi::SubmitCommandBuffer(VkCommandBuffer commandBuffer) {
+    ModCommands::Submit(commandBuffer);
+}
+
+ModInputCursor ModApi::OpenInput() {
+    return InputEvents::Open();
+}
+
+size_t ModApi::ReadInput(ModInputCursor& cursor, ModInputEvent* events, size_t maxEvents, uint64_t* dropped) {
+    return InputEvents::Read(cursor, events, maxEvents, dropped);
+}
+
+bool ModApi::IsKeyDown(uint32_t virtualKey) {
+    return InputEvents::IsKeyDown(virtualKey);
+}
+
+ModPointerPath* ModApi::RegisterPointerPath(const std::string& name, uintptr_t baseOffset, const std::vector<uintptr_t>& offsets, size_t size) {
+    return PointerPaths::Register(name, baseOffset, offsets, size);
+}
+
+ModPointerPath* ModApi::FindPointerPath(const std::string& name) {
+    return PointerPaths::Find(name);
+}
+
+const void* ModApi::GetSnapshot(ModPointerPath* path, size_t size) {
+    return PointerPaths::Get(path, size);
+}
+
+ModScan* ModApi::FirstScan(ModScanType type, const void* value, size_t size, float tolerance) {
+    return MemoryScanner::First(type, value, size, tolerance);
+}
+
+bool ModApi::NextScan(ModScan* scan, ModScanCondition condition, const void* value) {
+    return MemoryScanner::Next(scan, condition, value);
+}
+
+uint64_t ModApi::GetScanCount(ModScan* scan) {
+    return MemoryScanner::Count(scan);
+}
+
+size_t ModApi::GetScanResults(ModScan* scan, uintptr_t* addresses, size_t maxAddresses) {
+    return MemoryScanner::Results(scan, addresses, maxAddresses);
+}
+
+void ModApi::ReleaseScan(ModScan* scan) {
+    MemoryScanner::Release(scan);
+}
+
+uintptr_t ModApi::FindVTable(const std::string& name, uint32_t offset, size_t* slots) {
+    return VTableIndex::Find(name, offset, slots);
+}
+
+ModVmtHook* ModApi::HookVTable(uintptr_t vtable, size_t slot, void* hook, int priority) {
+    return VmtHooks::HookClass(vtable, slot, hook, priority);
+}
+
+ModVmtHook* ModApi::HookObject(void* object, size_t slot, void* hook, int priority) {
+    return VmtHooks::HookObject(object, slot, hook, priority);
+}
+
+void* ModApi::GetVmtNext(ModVmtHook* hook) {
+    return VmtHooks::GetNext(hook);
+}
+
+void ModApi::UnhookVmt(ModVmtHook* hook) {
+    VmtHooks::Unhook(hook);
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <imgui.h>
+
+#include "include/api_profiler.h"
+#include "include/layer_config.h"
+#include "include/proc_table.h"
+#include "include/thread_counters.h"
+
+namespace {
+
+enum ProfiledCall : uint32_t {
+#define VK_DEVICE_ENTRYPOINT(name) CALL_##name,
+#include "include/vk_device_entrypoints.h"
+    CALL_COUNT
+};
+
+// Two counters per entry point: call count and cumulative nanoseconds
+using CallCounters = ThreadCounters<struct ApiProfilerTag, CALL_COUNT * 2>;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kMaxDevices = 4;
+constexpr uint32_t kFramesPerSample = 30;
+
+/**
+ * @brief Next-layer dispatch of a device the profiler is wrapping
+ */
+struct DeviceSlot {
+    std::atomic<void*> key{nullptr};
+    VkLayerDispatchTable next = {};
+    bool available[CALL_COUNT] = {};
+};
+
+DeviceSlot devices[kMaxDevices];
+
+template <typename DispatchableType>
+void* GetKey(DispatchableType inst) {
+    return *(void**)inst;
+}
+
+std::atomic<bool> reportedUnknown{false};
+
+/**
+ * @brief Next-layer dispatch of the device a handle belongs to
+ * @return nullptr for a device the profiler does not wrap, such as one destroyed
+ *         while another thread still calls into it. The layer's own table cannot
+ *         stand in: its entries point back at the wrappers.
+ */
+const VkLayerDispatchTable* NextDispatch(void* key) {
+    for (DeviceSlot& slot : devices) {
+        if (slot.key.load(std::memory_order_acquire) == key) {
+            return &slot.next;
+        }
+    }
+    if (!reportedUnknown.exchange(true, std::memory_order_relaxed)) {
+        std::cerr << "[ERROR] API profiler called for unknown device key 0x" << key << std::endl;
+    }
+    return nullptr;
+}
+
+template <typename First, typename... Rest>
+void* DispatchKeyOf(First first, Rest...) {
+    return GetKey(first);
+}
+
+inline void Record(uint32_t index, Clock::time_point start) {
+    const uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    CallCounters::Block& block = CallCounters::Local();
+    block.Add(index * 2, 1);
+    block.Add(index * 2 + 1, elapsed);
+}
+
+/**
+ * @brief Wrapper that times one entry point and forwards to the next layer
+ */
+template <typename Pfn, Pfn VkLayerDispatchTable::*Member, uint32_t Index>
+struct Profiled;
+
+template <typename R, typename... Args, R (VKAPI_PTR* VkLayerDispatchTable::*Member)(Args...), uint32_t Index>
+struct Profiled<R (VKAPI_PTR*)(Args...), Member, Index> {
+    static R VKAPI_CALL Call(Args... args) {
+        const VkLayerDispatchTable* table = NextDispatch(DispatchKeyOf(args...));
+        if (!table) {
+            if constexpr (std::is_same_v<R, VkResult>) {
+                return VK_ERROR_INITIALIZATION_FAILED;
+            } else if constexpr (!std::is_void_v<R>) {
+                return R{};
+            } else {
+                return;
+            }
+        }
+
+        const auto next = table->*Member;
+        const Clock::time_point start = Clock::now();
+
+        if constexpr (std::is_void_v<R>) {
+            next(args...);
+            Record(Index, start);
+        } else {
+            R result = next(args...);
+            Record(Index, start);
+            return result;
+        }
+    }
+};
+
+#define PROFILED_CALL(name) Profiled<PFN_vk##name, &VkLayerDispatchTable::name, CALL_##name>::Call
+
+constexpr proc_table::PerfectHash kProfiledTable(std::to_array({
+#define VK_DEVICE_ENTRYPOINT(name) proc_table::ProcName{"vk" #name, FEATURE_PROFILER, 0},
+#include "include/vk_device_entrypoints.h"
+}));
+
+const PFN_vkVoidFunction kWrappers[] = {
+#define VK_DEVICE_ENTRYPOINT(name) reinterpret_cast<PFN_vkVoidFunction>(&PROFILED_CALL(name)),
+#include "include/vk_device_entrypoints.h"
+};
+
+static_assert(kProfiledTable.size() == CALL_COUNT, "Profiler table out of sync with the entry point list");
+
+/**
+ * @brief Averaged per-frame cost of one entry point
+ */
+struct CallStat {
+    uint32_t index;
+    double calls;
+    double micros;
+};
+
+uint64_t previousTotals[CALL_COUNT * 2] = {};
+uint64_t windowTotals[CALL_COUNT * 2] = {};
+uint32_t windowFrames = 0;
+std::vector<CallStat> publishedStats;
+double publishedCalls = 0.0;
+double publishedMicros = 0.0;
+
+} // namespace
+
+namespace ApiProfiler {
+
+/**
+ * @brief Start profiling a device
+ * @param device The new device
+ * @param table The layer's dispatch table for it, already filled from the next layer.
+ *              Its entries are redirected through the wrappers so the layer's own
+ *              calls are counted too.
+ */
+void OnCreateDevice(VkDevice device, VkLayerDispatchTable& table) {
+    for (DeviceSlot& slot : devices) {
+        // Reserve the slot first so lookups never see a half-filled table
+        void* expected = nullptr;
+        if (!slot.key.compare_exchange_strong(expected, &slot, std::memory_order_acquire)) {
+            continue;
+        }
+
+        slot.next = table;
+#define VK_DEVICE_ENTRYPOINT(name) \
+        slot.available[CALL_##name] = table.name != nullptr; \
+        if (table.name) table.name = &PROFILED_CALL(name);
+#include "include/vk_device_entrypoints.h"
+
+        slot.key.store(GetKey(device), std::memory_order_release);
+        std::cout << "[+] API profiler attached to device 0x" << device << std::endl;
+        return;
+    }
+    std::cerr << "[ERROR] API profiler has no free device slot" << std::endl;
+}
+
+void OnDestroyDevice(VkDevice device) {
+    void* key = GetKey(device);
+    for (DeviceSlot& slot : devices) {
+        void* expected = key;
+        slot.key.compare_exchange_strong(expected, nullptr, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Get the profiling wrapper for an entry point
+ * @return The wrapper, or nullptr if the next layer does not provide the function
+ */
+PFN_vkVoidFunction GetProcAddr(VkDevice device, const char* pName) {
+    const int index = kProfiledTable.Find(pName);
+    if (index < 0) {
+        return nullptr;
+    }
+
+    void* key = GetKey(device);
+    for (const DeviceSlot& slot : devices) {
+        if (slot.key.load(std::memory_order_acquire) == key) {
+            return slot.available[index] ? kWrappers[index] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Fold the calls made since the previous present into the frame statistics
+ */
+void EndFrame() {
+    uint64_t totals[CALL_COUNT * 2];
+    CallCounters::Sum(totals);
+
+    for (size_t i = 0; i < CALL_COUNT * 2; ++i) {
+        windowTotals[i] += totals[i] - previousTotals[i];
+        previousTotals[i] = totals[i];
+    }
+
+    if (++windowFrames < kFramesPerSample) {
+        return;
+    }
+
+    // Publish the averages of the last window, most expensive first
+    publishedStats.clear();
+    publishedCalls = 0.0;
+    publishedMicros = 0.0;
+    for (uint32_t i = 0; i < CALL_COUNT; ++i) {
+        if (windowTotals[i * 2] == 0) {
+            continue;
+        }
+
+        CallStat stat;
+        stat.index = i;
+        stat.calls = static_cast<double>(windowTotals[i * 2]) / windowFrames;
+        stat.micros = static_cast<double>(windowTotals[i * 2 + 1]) / 1000.0 / windowFrames;
+        publishedCalls += stat.calls;
+        publishedMicros += stat.micros;
+        publishedStats.push_back(stat);
+    }
+    std::sort(publishedStats.begin(), publishedStats.end(),
+        [](const CallStat& a, const CallStat& b) { return a.micros > b.micros; });
+
+    std::fill(std::begin(windowTotals), std::end(windowTotals), 0);
+    windowFrames = 0;
+}
+
+/**
+ * @brief Display the per-frame call statistics
+ */
+void RenderOverlay() {
+    if (!LayerConfig::IsEnabled(FEATURE_PROFILER)) {
+        return;
+    }
+
+    ImGui::SetNextWindowSize({ 420, 360 }, ImGuiCond_Once);
+    if (ImGui::Begin("Vulkan API Profiler")) {
+        ImGui::Text("Calls/frame: %.0f | API time/frame: %.3f ms", publishedCalls, publishedMicros / 1000.0);
+        ImGui::Separator();
+
+        constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
+        if (ImGui::BeginTable("##apiprofiler", 4, flags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Function", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("us/frame");
+            ImGui::TableSetupColumn("us/call");
+            ImGui::TableHeadersRow();
+
+            for (const CallStat& stat : publishedStats) {
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(kProfiledTable[stat.index].name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", stat.calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", stat.micros);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stat.micros / stat.calls);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+} // namespace ApiProfiler
@@ -0,0 +1,712 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <imgui.h>
+
+#include "include/capture.h"
+#include "include/frame_encode.h"
+#include "include/layer_config.h"
+#include "include/thread_pool.h"
+
+namespace {
+
+constexpr uint32_t kRingSize = 4;
+constexpr uint32_t kRowsPerTask = 32;            // Even, so strips never split a chroma row
+constexpr size_t kOutputBuffer = 8 * 1024 * 1024; // stdio buffer, turns frames into large sequential writes
+
+enum SlotState : uint32_t {
+    SLOT_FREE,      // Owned by the present thread, may be recorded into
+    SLOT_RECORDED,  // Copy recorded, waiting for EndFrame
+    SLOT_IN_FLIGHT, // Owned by the worker until its fence signals and the frame is written
+};
+
+/**
+ * @brief One host-visible readback buffer of the ring
+ */
+struct ReadbackSlot {
+    std::atomic<uint32_t> state{SLOT_FREE};
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize capacity = 0;
+    void* mapped = nullptr;
+    bool coherent = false;
+    VkFence fence = VK_NULL_HANDLE;
+    VkExtent2D extent = {};
+    FrameEncode::PixelFormat format = FrameEncode::PIXEL_BGRA8;
+    bool screenshot = false;
+    uint64_t session = 0; // Recording session the frame belongs to, 0 when not recording
+};
+
+/**
+ * @brief Counters shown in the recording overlay, written by both threads
+ */
+struct RecordingStats {
+    std::atomic<uint64_t> framesWritten{0};
+    std::atomic<uint64_t> framesDropped{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> overheadNs{0}; // Present-thread time spent recording copies
+    std::atomic<uint64_t> overheadFrames{0};
+};
+
+VkDevice device = VK_NULL_HANDLE;
+VkPhysicalDeviceMemoryProperties memoryProperties = {};
+VkFormat swapchainFormat = VK_FORMAT_UNDEFINED;
+bool swapchainReadable = false;
+
+std::atomic<bool> requested{false};
+ReadbackSlot slots[kRingSize];
+ReadbackSlot* recordedSlot = nullptr;
+uint64_t recordedOverheadNs = 0;
+
+// Recording state owned by the present thread
+std::atomic<bool> recordingWanted{false};
+bool recordingActive = false;
+uint64_t recordingSession = 0;
+uint64_t recordingFrame = 0;
+VkExtent2D recordingExtent = {};
+RecordingStats stats;
+
+// Recording output owned by the worker
+FILE* output = nullptr;
+bool outputIsPipe = false;
+uint64_t outputSession = 0;
+std::vector<uint8_t> yuvFrame;
+
+// Worker hand-off; the present thread only holds the lock to push a slot.
+// A null entry tells the worker to close the current recording.
+std::mutex queueMutex;
+std::condition_variable queueCondition;
+std::deque<ReadbackSlot*> pending;
+bool stopping = false;
+std::thread worker;
+
+bool ToPixelFormat(VkFormat format, FrameEncode::PixelFormat& out) {
+    switch (format) {
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+        out = FrameEncode::PIXEL_BGRA8;
+        return true;
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+        out = FrameEncode::PIXEL_RGBA8;
+        return true;
+    case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        out = FrameEncode::PIXEL_A2B10G10R10;
+        return true;
+    case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+        out = FrameEncode::PIXEL_A2R10G10B10;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Find a host-visible memory type, preferring cached memory for fast CPU reads
+ */
+uint32_t FindReadbackMemoryType(uint32_t typeBits, bool& coherent) {
+    constexpr VkMemoryPropertyFlags preferred[] = {
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+    };
+
+    for (VkMemoryPropertyFlags flags : preferred) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+            const VkMemoryPropertyFlags typeFlags = memoryProperties.memoryTypes[i].propertyFlags;
+            if ((typeBits & (1u << i)) && (typeFlags & flags) == flags) {
+                coherent = (typeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+                return i;
+            }
+        }
+    }
+    return UINT32_MAX;
+}
+
+void DestroySlot(ReadbackSlot& slot) {
+    if (slot.mapped) vkUnmapMemory(device, slot.memory);
+    if (slot.buffer) vkDestroyBuffer(device, slot.buffer, nullptr);
+    if (slot.memory) vkFreeMemory(device, slot.memory, nullptr);
+    slot.mapped = nullptr;
+    slot.buffer = VK_NULL_HANDLE;
+    slot.memory = VK_NULL_HANDLE;
+    slot.capacity = 0;
+}
+
+/**
+ * @brief Make sure a free slot can hold a frame, (re)allocating only when it grew
+ */
+bool EnsureSlot(ReadbackSlot& slot, VkDeviceSize size) {
+    if (slot.fence == VK_NULL_HANDLE) {
+        VkFenceCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(device, &info, nullptr, &slot.fence) != VK_SUCCESS) {
+            std::cerr << "[ERROR] Failed to create capture fence" << std::endl;
+            return false;
+        }
+    }
+
+    if (slot.capacity >= size) {
+        return true;
+    }
+    DestroySlot(slot);
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkResult result = vkCreateBuffer(device, &bufferInfo, nullptr, &slot.buffer);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create capture buffer: " << result << std::endl;
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, slot.buffer, &requirements);
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindReadbackMemoryType(requirements.memoryTypeBits, slot.coherent);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX) {
+        std::cerr << "[ERROR] No host-visible memory type for capture" << std::endl;
+        DestroySlot(slot);
+        return false;
+    }
+
+    result = vkAllocateMemory(device, &allocInfo, nullptr, &slot.memory);
+    if (result == VK_SUCCESS) result = vkBindBufferMemory(device, slot.buffer, slot.memory, 0);
+    if (result == VK_SUCCESS) result = vkMapMemory(device, slot.memory, 0, VK_WHOLE_SIZE, 0, &slot.mapped);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to allocate capture memory: " << result << std::endl;
+        DestroySlot(slot);
+        return false;
+    }
+
+    slot.capacity = size;
+    return true;
+}
+
+std::string MakeFileName(const char* extension) {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t time = std::chrono::system_clock::to_time_t(now);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+
+    std::tm local = {};
+    localtime_s(&local, &time);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+    char name[64];
+    snprintf(name, sizeof(name), "Sky_%s_%03d.%s", stamp, static_cast<int>(millis), extension);
+    return (std::filesystem::path(LayerConfig::Get().capture.directory) / name).string();
+}
+
+void CloseOutput() {
+    if (!output) {
+        return;
+    }
+
+    if (outputIsPipe) {
+        _pclose(output);
+    } else {
+        fclose(output);
+    }
+    output = nullptr;
+    std::cout << "[+] Recording stopped after " << stats.framesWritten.load(std::memory_order_relaxed) << " frames ("
+              << stats.framesDropped.load(std::memory_order_relaxed) << " dropped)" << std::endl;
+}
+
+/**
+ * @brief Open the file or pipe for a new recording session and write the stream header
+ */
+bool OpenOutput(uint64_t session, VkExtent2D extent) {
+    CloseOutput();
+    outputSession = session;
+
+    const RecordingSettings& settings = LayerConfig::Get().recording;
+    outputIsPipe = settings.output == "pipe";
+    try {
+        if (outputIsPipe) {
+            output = _popen(settings.pipeCommand.c_str(), "wb");
+            if (!output) {
+                std::cerr << "[ERROR] Failed to start recording pipe: " << settings.pipeCommand << std::endl;
+                return false;
+            }
+            std::cout << "[+] Recording to pipe: " << settings.pipeCommand << std::endl;
+        } else {
+            std::filesystem::create_directories(LayerConfig::Get().capture.directory);
+            const std::string path = MakeFileName(settings.output == "raw" ? "yuv" : "y4m");
+            output = fopen(path.c_str(), "wb");
+            if (!output) {
+                std::cerr << "[ERROR] Failed to open recording file " << path << std::endl;
+                return false;
+            }
+            std::cout << "[+] Recording " << extent.width << "x" << extent.height << " I420 to " << path << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] Failed to start recording: " << e.what() << std::endl;
+        return false;
+    }
+    setvbuf(output, nullptr, _IOFBF, kOutputBuffer);
+
+    if (settings.output != "raw") {
+        char header[128];
+        const int length = snprintf(header, sizeof(header), "YUV4MPEG2 W%u H%u F%u:%u Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n",
+            extent.width, extent.height, settings.frameRate, settings.frameInterval);
+        fwrite(header, 1, length, output);
+    }
+    return true;
+}
+
+/**
+ * @brief Convert a mapped frame to I420 in yuvFrame, spreading row strips over the shared pool
+ * @param headerSize Bytes reserved in front of the planes for the Y4M frame marker
+ */
+void ConvertToI420(const ReadbackSlot& slot, size_t headerSize) {
+    const uint32_t width = slot.extent.width;
+    const uint32_t height = slot.extent.height;
+    const uint32_t chromaWidth = (width + 1) / 2;
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t chromaSize = static_cast<size_t>(chromaWidth) * ((height + 1) / 2);
+    yuvFrame.resize(headerSize + lumaSize + chromaSize * 2);
+
+    uint8_t* planeY = yuvFrame.data() + headerSize;
+    uint8_t* planeU = planeY + lumaSize;
+    uint8_t* planeV = planeU + chromaSize;
+    const uint8_t* source = static_cast<const uint8_t*>(slot.mapped);
+    const size_t pitch = static_cast<size_t>(width) * 4;
+
+    const size_t tasks = (height + kRowsPerTask - 1) / kRowsPerTask;
+    ThreadPool::Shared().ParallelFor(tasks, [&](size_t task) {
+        thread_local std::vector<uint8_t> rows;
+        rows.resize(pitch * 2);
+        uint8_t* row0 = rows.data();
+        uint8_t* row1 = rows.data() + pitch;
+
+        const uint32_t first = static_cast<uint32_t>(task) * kRowsPerTask;
+        const uint32_t last = std::min(first + kRowsPerTask, height);
+        for (uint32_t y = first; y < last; y += 2) {
+            const bool pair = y + 1 < height;
+            FrameEncode::ToRGBA8(source + y * pitch, row0, width, slot.format);
+            if (pair) {
+                FrameEncode::ToRGBA8(source + (y + 1) * pitch, row1, width, slot.format);
+            }
+            FrameEncode::RGBA8ToI420Rows(row0, pair ? row1 : row0, width,
+                planeY + static_cast<size_t>(y) * width, pair ? planeY + static_cast<size_t>(y + 1) * width : nullptr,
+                planeU + static_cast<size_t>(y / 2) * chromaWidth, planeV + static_cast<size_t>(y / 2) * chromaWidth);
+        }
+    });
+}
+
+/**
+ * @brief Write the converted frame in yuvFrame as one sequential write
+ */
+void WriteRecordingFrame() {
+    if (fwrite(yuvFrame.data(), 1, yuvFrame.size(), output) != yuvFrame.size()) {
+        std::cerr << "[ERROR] Failed to write recording frame, stopping" << std::endl;
+        CloseOutput();
+        recordingWanted.store(false, std::memory_order_relaxed);
+        return;
+    }
+    stats.framesWritten.fetch_add(1, std::memory_order_relaxed);
+    stats.bytesWritten.fetch_add(yuvFrame.size(), std::memory_order_relaxed);
+}
+
+void SaveScreenshot(const std::vector<uint8_t>& rgba, VkExtent2D extent) {
+    const std::string& format = LayerConfig::Get().capture.format;
+    const FrameEncode::Encoder* encoder = FrameEncode::FindEncoder(format);
+    if (!encoder) {
+        std::cerr << "[ERROR] Unknown capture format \"" << format << "\", using png" << std::endl;
+        encoder = FrameEncode::FindEncoder("png");
+    }
+
+    std::vector<uint8_t> encoded;
+    if (!encoder->encode(rgba.data(), extent.width, extent.height, encoded)) {
+        std::cerr << "[ERROR] Failed to encode capture as " << encoder->name << std::endl;
+        return;
+    }
+
+    try {
+        std::filesystem::create_directories(LayerConfig::Get().capture.directory);
+        const std::string path = MakeFileName(encoder->extension);
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+        std::cout << "[+] Screenshot saved to " << path << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] Failed to save screenshot: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * @brief Convert and write one frame once the GPU has finished the copy
+ */
+void ProcessSlot(ReadbackSlot& slot) {
+    VkResult result = vkWaitForFences(device, 1, &slot.fence, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to wait for capture fence: " << result << std::endl;
+        slot.state.store(SLOT_FREE, std::memory_order_release);
+        return;
+    }
+
+    if (!slot.coherent) {
+        VkMappedMemoryRange range = {};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = slot.memory;
+        range.size = VK_WHOLE_SIZE;
+        vkInvalidateMappedMemoryRanges(device, 1, &range);
+    }
+
+    std::vector<uint8_t> rgba;
+    if (slot.screenshot) {
+        const size_t pixels = static_cast<size_t>(slot.extent.width) * slot.extent.height;
+        rgba.resize(pixels * 4);
+        FrameEncode::ToRGBA8(slot.mapped, rgba.data(), pixels, slot.format);
+    }
+
+    bool recorded = false;
+    if (slot.session) {
+        if (slot.session != outputSession) {
+            OpenOutput(slot.session, slot.extent);
+        }
+        if (output) {
+            static const char marker[] = "FRAME\n";
+            const size_t headerSize = LayerConfig::Get().recording.output == "raw" ? 0 : sizeof(marker) - 1;
+            ConvertToI420(slot, headerSize);
+            memcpy(yuvFrame.data(), marker, headerSize);
+            recorded = true;
+        }
+    }
+    const VkExtent2D extent = slot.extent;
+
+    // The buffer can be reused as soon as the pixels are out of it
+    vkResetFences(device, 1, &slot.fence);
+    slot.state.store(SLOT_FREE, std::memory_order_release);
+
+    if (recorded) {
+        WriteRecordingFrame();
+    }
+    if (!rgba.empty()) {
+        SaveScreenshot(rgba, extent);
+    }
+}
+
+void WorkerLoop() {
+    for (;;) {
+        ReadbackSlot* slot;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                break;
+            }
+            slot = pending.front();
+            pending.pop_front();
+        }
+
+        if (slot) {
+            ProcessSlot(*slot);
+        } else {
+            CloseOutput();
+        }
+    }
+    CloseOutput();
+}
+
+void PushPending(ReadbackSlot* slot) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(slot);
+    }
+    queueCondition.notify_one();
+}
+
+void StopRecording() {
+    recordingActive = false;
+    PushPending(nullptr);
+}
+
+/**
+ * @brief Follow the recording toggle and decide whether this present is recorded
+ */
+bool UpdateRecording(VkExtent2D extent) {
+    const bool wanted = recordingWanted.load(std::memory_order_relaxed);
+    if (recordingActive && !wanted) {
+        StopRecording();
+    } else if (recordingActive && (extent.width != recordingExtent.width || extent.height != recordingExtent.height)) {
+        // Y4M streams have a fixed frame size
+        std::cerr << "[ERROR] Swapchain resized, recording stopped" << std::endl;
+        recordingWanted.store(false, std::memory_order_relaxed);
+        StopRecording();
+        return false;
+    }
+
+    if (!recordingActive && wanted) {
+        recordingActive = true;
+        recordingExtent = extent;
+        recordingFrame = 0;
+        ++recordingSession;
+        stats.framesWritten.store(0, std::memory_order_relaxed);
+        stats.framesDropped.store(0, std::memory_order_relaxed);
+        stats.bytesWritten.store(0, std::memory_order_relaxed);
+        stats.overheadNs.store(0, std::memory_order_relaxed);
+        stats.overheadFrames.store(0, std::memory_order_relaxed);
+    }
+
+    return recordingActive && recordingFrame++ % LayerConfig::Get().recording.frameInterval == 0;
+}
+
+uint64_t ElapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+namespace Capture {
+
+void Request() {
+    requested.store(true, std::memory_order_relaxed);
+}
+
+void ToggleRecording() {
+    recordingWanted.store(!recordingWanted.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+bool IsIdle() {
+    return !requested.load(std::memory_order_relaxed) && !recordingWanted.load(std::memory_order_relaxed) && !recordingActive;
+}
+
+/**
+ * @brief Start the capture worker for a device
+ * @param newDevice The game's device
+ * @param properties Memory properties of its physical device
+ */
+void OnCreateDevice(VkDevice newDevice, const VkPhysicalDeviceMemoryProperties& properties) {
+    if (device != VK_NULL_HANDLE) {
+        return;
+    }
+
+    device = newDevice;
+    memoryProperties = properties;
+    stopping = false;
+    worker = std::thread(WorkerLoop);
+}
+
+/**
+ * @brief Finish outstanding captures and release the ring
+ */
+void OnDestroyDevice(VkDevice oldDevice) {
+    if (device != oldDevice) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    for (ReadbackSlot& slot : slots) {
+        DestroySlot(slot);
+        if (slot.fence) vkDestroyFence(device, slot.fence, nullptr);
+        slot.fence = VK_NULL_HANDLE;
+        slot.state.store(SLOT_FREE, std::memory_order_relaxed);
+    }
+    recordedSlot = nullptr;
+    recordingActive = false;
+    device = VK_NULL_HANDLE;
+}
+
+/**
+ * @brief Remember the format of the new swapchain and whether it can be read back
+ * @param format Swapchain image format
+ * @param readable Whether the images were created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+ */
+void OnCreateSwapchain(VkFormat format, bool readable) {
+    swapchainFormat = format;
+    swapchainReadable = readable;
+    if (!readable) {
+        std::cerr << "[ERROR] Swapchain images cannot be read back, screenshots and recording are disabled" << std::endl;
+    }
+}
+
+bool RecordCopy(VkCommandBuffer cmd, VkImage image, VkExtent2D extent) {
+    const auto start = std::chrono::steady_clock::now();
+
+    // A copy whose command buffer never made it to a queue
+    if (recordedSlot) {
+        recordedSlot->state.store(SLOT_FREE, std::memory_order_relaxed);
+        recordedSlot = nullptr;
+    }
+
+    if (device == VK_NULL_HANDLE || !swapchainReadable || extent.width == 0 || extent.height == 0) {
+        return false;
+    }
+
+    const bool record = UpdateRecording(extent);
+    const bool screenshot = requested.load(std::memory_order_relaxed);
+    if (!record && !screenshot) {
+        return false;
+    }
+
+    FrameEncode::PixelFormat pixelFormat;
+    if (!ToPixelFormat(swapchainFormat, pixelFormat)) {
+        std::cerr << "[ERROR] Capture of swapchain format " << swapchainFormat << " is not supported" << std::endl;
+        requested.store(false, std::memory_order_relaxed);
+        recordingWanted.store(false, std::memory_order_relaxed);
+        StopRecording();
+        return false;
+    }
+
+    // Never wait for the worker; if the ring is full a screenshot waits for the
+    // next frame and a recorded frame is dropped
+    ReadbackSlot* slot = nullptr;
+    for (ReadbackSlot& candidate : slots) {
+        if (candidate.state.load(std::memory_order_acquire) == SLOT_FREE) {
+            slot = &candidate;
+            break;
+        }
+    }
+    if (!slot || !EnsureSlot(*slot, static_cast<VkDeviceSize>(extent.width) * extent.height * 4)) {
+        if (record) {
+            stats.framesDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+    if (screenshot) {
+        requested.store(false, std::memory_order_relaxed);
+    }
+
+    VkImageMemoryBarrier toTransfer = {};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransfer.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = image;
+    toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    // ALL_COMMANDS chains with whatever stage the present semaphores are waited at
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &toTransfer);
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {extent.width, extent.height, 1};
+    vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot->buffer, 1, &region);
+
+    VkImageMemoryBarrier toPresent = toTransfer;
+    toPresent.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toPresent.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toPresent.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkBufferMemoryBarrier toHost = {};
+    toHost.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    toHost.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toHost.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = slot->buffer;
+    toHost.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0,
+        0, nullptr, 1, &toHost, 1, &toPresent);
+
+    slot->extent = extent;
+    slot->format = pixelFormat;
+    slot->screenshot = screenshot;
+    slot->session = record ? recordingSession : 0;
+    slot->state.store(SLOT_RECORDED, std::memory_order_relaxed);
+    recordedSlot = slot;
+    recordedOverheadNs = ElapsedNs(start);
+    return true;
+}
+
+void EndFrame(VkQueue queue) {
+    ReadbackSlot* slot = recordedSlot;
+    if (!slot) {
+        return;
+    }
+    recordedSlot = nullptr;
+    const auto start = std::chrono::steady_clock::now();
+
+    // An empty submit signals the fence once everything before it on the queue is done
+    VkResult result = vkQueueSubmit(queue, 0, nullptr, slot->fence);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to submit capture fence: " << result << std::endl;
+        slot->state.store(SLOT_FREE, std::memory_order_release);
+        return;
+    }
+
+    const bool record = slot->session != 0;
+    slot->state.store(SLOT_IN_FLIGHT, std::memory_order_release);
+    PushPending(slot);
+
+    if (record) {
+        stats.overheadNs.fetch_add(recordedOverheadNs + ElapsedNs(start), std::memory_order_relaxed);
+        stats.overheadFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void RenderOverlay() {
+    if (!LayerConfig::IsEnabled(FEATURE_CAPTURE)) {
+        return;
+    }
+
+    // Bandwidth over roughly the last second
+    static double sampleTime = 0.0;
+    static uint64_t sampleBytes = 0;
+    static float bandwidth = 0.0f;
+    const double now = ImGui::GetTime();
+    const uint64_t bytes = stats.bytesWritten.load(std::memory_order_relaxed);
+    if (bytes < sampleBytes) {
+        sampleBytes = 0;
+    }
+    if (now - sampleTime >= 1.0) {
+        bandwidth = static_cast<float>((bytes - sampleBytes) / (now - sampleTime) / (1024.0 * 1024.0));
+        sampleTime = now;
+        sampleBytes = bytes;
+    }
+
+    ImGui::SetNextWindowSize({ 300, 190 }, ImGuiCond_Once);
+    if (ImGui::Begin("Recording")) {
+        const RecordingSettings& settings = LayerConfig::Get().recording;
+        const bool wanted = recordingWanted.load(std::memory_order_relaxed);
+        if (ImGui::Button(wanted ? "Stop recording" : "Start recording")) {
+            ToggleRecording();
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s, every %u frame(s)", settings.output.c_str(), settings.frameInterval);
+
+        const uint64_t written = stats.framesWritten.load(std::memory_order_relaxed);
+        const uint64_t dropped = stats.framesDropped.load(std::memory_order_relaxed);
+        const uint64_t overheadFrames = stats.overheadFrames.load(std::memory_order_relaxed);
+        const double overheadUs = overheadFrames
+            ? stats.overheadNs.load(std::memory_order_relaxed) / 1000.0 / overheadFrames : 0.0;
+
+        ImGui::Text("Frames written: %llu", static_cast<unsigned long long>(written));
+        ImGui::Text("Frames dropped: %llu", static_cast<unsigned long long>(dropped));
+        ImGui::Text("Bandwidth: %.1f MB/s", wanted ? bandwidth : 0.0f);
+        ImGui::Text("Present overhead: %.1f us/frame", overheadUs);
+        ImGui::Text("Size: %.1f MB", bytes / (1024.0 * 1024.0));
+    }
+    ImGui::End();
+}
+
+} // namespace Capture
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+#include <imgui.h>
+
+#include "include/draw_stats.h"
+#include "include/layer_config.h"
+#include "include/layer_dispatch.h"
+#include "include/thread_counters.h"
+
+namespace {
+
+enum DrawStat : uint32_t {
+    STAT_DRAWS,
+    STAT_INDIRECT_DRAWS,
+    STAT_DISPATCHES,
+    STAT_RENDER_PASSES,
+    STAT_SUBMITS,
+    STAT_COMMAND_BUFFERS,
+    STAT_VERTICES,
+    STAT_PRIMITIVES,
+    STAT_COUNT
+};
+
+constexpr const char* statNames[STAT_COUNT] = {
+    "Draws",
+    "Indirect draws",
+    "Dispatches",
+    "Render passes",
+    "Queue submits",
+    "Command buffers",
+    "Vertices",
+    "Primitives",
+};
+
+constexpr const char* csvFile = "tsml_drawstats.csv";
+
+using StatCounters = ThreadCounters<struct DrawStatsTag, STAT_COUNT>;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kHistoryFrames = 240;
+constexpr uint32_t kFramesPerSample = 30;
+
+/**
+ * @brief Statistics of one presented frame
+ */
+struct FrameStats {
+    float frameMs;
+    uint64_t values[STAT_COUNT];
+};
+
+uint64_t previousTotals[STAT_COUNT] = {};
+FrameStats history[kHistoryFrames] = {};
+size_t historyHead = 0;
+size_t historySize = 0;
+uint64_t frameIndex = 0;
+Clock::time_point lastPresent;
+
+// Averages over the last kFramesPerSample frames, refreshed once per window
+double published[STAT_COUNT] = {};
+double publishedFrameMs = 0.0;
+
+std::ofstream csv;
+
+void CountDraw(uint64_t vertices, uint32_t instances) {
+    StatCounters::Block& block = StatCounters::Local();
+    block.Add(STAT_DRAWS, 1);
+    block.Add(STAT_VERTICES, vertices * instances);
+    block.Add(STAT_PRIMITIVES, vertices / 3 * instances);
+}
+
+void CountSubmit(uint64_t commandBuffers) {
+    StatCounters::Block& block = StatCounters::Local();
+    block.Add(STAT_SUBMITS, 1);
+    block.Add(STAT_COMMAND_BUFFERS, commandBuffers);
+}
+
+void StartExport() {
+    csv.open(csvFile, std::ios::out | std::ios::trunc);
+    if (!csv.is_open()) {
+        std::cerr << "[ERROR] Failed to open " << csvFile << std::endl;
+        return;
+    }
+
+    csv << "frame,frame_ms";
+    for (const char* name : statNames) {
+        csv << ',' << name;
+    }
+    csv << '\n';
+    std::cout << "[+] Exporting draw statistics to " << csvFile << std::endl;
+}
+
+void StopExport() {
+    csv.close();
+    std::cout << "[+] Draw statistics export stopped" << std::endl;
+}
+
+} // namespace
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    CountDraw(vertexCount, instanceCount);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance) {
+    CountDraw(indexCount, instanceCount);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride) {
+    StatCounters::Add(STAT_INDIRECT_DRAWS, drawCount);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndirect(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndexedIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride) {
+    StatCounters::Add(STAT_INDIRECT_DRAWS, drawCount);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+}
+
+// The draw count of the *Count variants lives in GPU memory, so only the command is counted
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndirectCount(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount, uint32_t stride) {
+    StatCounters::Add(STAT_INDIRECT_DRAWS);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndirectCount(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndirectCountKHR(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount, uint32_t stride) {
+    StatCounters::Add(STAT_INDIRECT_DRAWS);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndirectCountKHR(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndexedIndirectCount(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount, uint32_t stride) {
+    StatCounters::Add(STAT_INDIRECT_DRAWS);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndexedIndirectCount(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDrawIndexedIndirectCountKHR(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t maxDrawCount, uint32_t stride) {
+    StatCounters::Add(STAT_INDIRECT_DRAWS);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDrawIndexedIndirectCountKHR(commandBuffer, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDispatch(VkCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    StatCounters::Add(STAT_DISPATCHES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDispatchBase(VkCommandBuffer commandBuffer, uint32_t baseGroupX, uint32_t baseGroupY, uint32_t baseGroupZ, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    StatCounters::Add(STAT_DISPATCHES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDispatchBase(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDispatchBaseKHR(VkCommandBuffer commandBuffer, uint32_t baseGroupX, uint32_t baseGroupY, uint32_t baseGroupZ, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+    StatCounters::Add(STAT_DISPATCHES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDispatchBaseKHR(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdDispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+    StatCounters::Add(STAT_DISPATCHES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdDispatchIndirect(commandBuffer, buffer, offset);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdBeginRenderPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, VkSubpassContents contents) {
+    StatCounters::Add(STAT_RENDER_PASSES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdBeginRenderPass(commandBuffer, pRenderPassBegin, contents);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdBeginRenderPass2(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, const VkSubpassBeginInfo* pSubpassBeginInfo) {
+    StatCounters::Add(STAT_RENDER_PASSES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdBeginRenderPass2(commandBuffer, pRenderPassBegin, pSubpassBeginInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdBeginRenderPass2KHR(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo* pRenderPassBegin, const VkSubpassBeginInfo* pSubpassBeginInfo) {
+    StatCounters::Add(STAT_RENDER_PASSES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdBeginRenderPass2KHR(commandBuffer, pRenderPassBegin, pSubpassBeginInfo);
+}
+
+// Dynamic rendering instances are counted as render passes
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdBeginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo) {
+    StatCounters::Add(STAT_RENDER_PASSES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdBeginRendering(commandBuffer, pRenderingInfo);
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_CmdBeginRenderingKHR(VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo) {
+    StatCounters::Add(STAT_RENDER_PASSES);
+    GetDeviceDispatch(GetKey(commandBuffer)).CmdBeginRenderingKHR(commandBuffer, pRenderingInfo);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence) {
+    uint64_t commandBuffers = 0;
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        commandBuffers += pSubmits[i].commandBufferCount;
+    }
+    CountSubmit(commandBuffers);
+    return GetDeviceDispatch(GetKey(queue)).QueueSubmit(queue, submitCount, pSubmits, fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_QueueSubmit2(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence fence) {
+    uint64_t commandBuffers = 0;
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        commandBuffers += pSubmits[i].commandBufferInfoCount;
+    }
+    CountSubmit(commandBuffers);
+    return GetDeviceDispatch(GetKey(queue)).QueueSubmit2(queue, submitCount, pSubmits, fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_QueueSubmit2KHR(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence fence) {
+    uint64_t commandBuffers = 0;
+    for (uint32_t i = 0; i < submitCount; ++i) {
+        commandBuffers += pSubmits[i].commandBufferInfoCount;
+    }
+    CountSubmit(commandBuffers);
+    return GetDeviceDispatch(GetKey(queue)).QueueSubmit2KHR(queue, submitCount, pSubmits, fence);
+}
+
+namespace DrawStats {
+
+/**
+ * @brief Fold the work recorded and submitted since the previous present into one frame
+ */
+void EndFrame() {
+    const Clock::time_point now = Clock::now();
+    FrameStats& frame = history[historyHead];
+    frame.frameMs = lastPresent == Clock::time_point{} ? 0.0f
+        : std::chrono::duration<float, std::milli>(now - lastPresent).count();
+    lastPresent = now;
+
+    uint64_t totals[STAT_COUNT];
+    StatCounters::Sum(totals);
+    for (size_t i = 0; i < STAT_COUNT; ++i) {
+        frame.values[i] = totals[i] - previousTotals[i];
+        previousTotals[i] = totals[i];
+    }
+
+    historyHead = (historyHead + 1) % kHistoryFrames;
+    historySize = std::min(historySize + 1, kHistoryFrames);
+
+    if (csv.is_open()) {
+        csv << frameIndex << ',' << frame.frameMs;
+        for (uint64_t value : frame.values) {
+            csv << ',' << value;
+        }
+        csv << '\n';
+    }
+    ++frameIndex;
+
+    if (frameIndex % kFramesPerSample != 0) {
+        return;
+    }
+
+    // Publish the averages of the most recent frames
+    const size_t count = std::min<size_t>(historySize, kFramesPerSample);
+    std::fill(std::begin(published), std::end(published), 0.0);
+    publishedFrameMs = 0.0;
+    for (size_t n = 1; n <= count; ++n) {
+        const FrameStats& sample = history[(historyHead + kHistoryFrames - n) % kHistoryFrames];
+        publishedFrameMs += sample.frameMs;
+        for (size_t i = 0; i < STAT_COUNT; ++i) {
+            published[i] += static_cast<double>(sample.values[i]);
+        }
+    }
+    publishedFrameMs /= count;
+    for (double& value : published) {
+        value /= count;
+    }
+}
+
+void LastFrame(uint64_t& draws, uint64_t& dispatches, uint64_t& submits) {
+    const FrameStats& frame = history[(historyHead + kHistoryFrames - 1) % kHistoryFrames];
+    draws = frame.values[STAT_DRAWS] + frame.values[STAT_INDIRECT_DRAWS];
+    dispatches = frame.values[STAT_DISPATCHES];
+    submits = frame.values[STAT_SUBMITS];
+}
+
+/**
+ * @brief Display the per-frame draw statistics and the CSV export toggle
+ */
+void RenderOverlay() {
+    if (!LayerConfig::IsEnabled(FEATURE_DRAWSTATS)) {
+        return;
+    }
+
+    ImGui::SetNextWindowSize({ 360, 330 }, ImGuiCond_Once);
+    if (ImGui::Begin("Draw Statistics")) {
+        ImGui::Text("Frame time: %.2f ms", publishedFrameMs);
+
+        // Oldest sample first
+        float draws[kHistoryFrames];
+        for (size_t n = 0; n < historySize; ++n) {
+            const FrameStats& sample = history[(historyHead + kHistoryFrames - historySize + n) % kHistoryFrames];
+            draws[n] = static_cast<float>(sample.values[STAT_DRAWS] + sample.values[STAT_INDIRECT_DRAWS]);
+        }
+        ImGui::PlotLines("##draws", draws, static_cast<int>(historySize), 0, "Draws/frame", 0.0f, FLT_MAX, { -1, 60 });
+
+        constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+        if (ImGui::BeginTable("##drawstats", 2, flags)) {
+            ImGui::TableSetupColumn("Statistic", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Per frame");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < STAT_COUNT; ++i) {
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(statNames[i]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", published[i]);
+            }
+            ImGui::EndTable();
+        }
+
+        if (csv.is_open()) {
+            ImGui::Text("Exporting frame %llu", static_cast<unsigned long long>(frameIndex));
+            if (ImGui::Button("Stop CSV export")) {
+                StopExport();
+            }
+        } else if (ImGui::Button("Export CSV")) {
+            StartExport();
+        }
+    }
+    ImGui::End();
+}
+
+} // namespace DrawStats
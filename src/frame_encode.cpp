@@ -0,0 +1,566 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define ENCODE_SSSE3
+#else
+#include <cpuid.h>
+#define ENCODE_SSSE3 __attribute__((target("ssse3")))
+#endif
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+#include "include/frame_encode.h"
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Pixel conversion
+// ---------------------------------------------------------------------------
+
+bool HasSSSE3() {
+    static const bool supported = [] {
+#ifdef _MSC_VER
+        int info[4] = {};
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+#else
+        unsigned int eax, ebx, ecx, edx;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) != 0;
+#endif
+    }();
+    return supported;
+}
+
+inline uint32_t ConvertPixel(uint32_t p, FrameEncode::PixelFormat format) {
+    switch (format) {
+    case FrameEncode::PIXEL_BGRA8:
+        return (p & 0x0000FF00u) | ((p >> 16) & 0xFFu) | ((p & 0xFFu) << 16) | 0xFF000000u;
+    case FrameEncode::PIXEL_A2B10G10R10:
+        return ((p >> 2) & 0xFFu) | ((p >> 4) & 0xFF00u) | ((p >> 6) & 0xFF0000u) | 0xFF000000u;
+    case FrameEncode::PIXEL_A2R10G10B10:
+        return ((p >> 22) & 0xFFu) | ((p >> 4) & 0xFF00u) | ((p << 14) & 0xFF0000u) | 0xFF000000u;
+    default:
+        return p | 0xFF000000u;
+    }
+}
+
+/**
+ * @brief Convert four pixels at once, mirroring ConvertPixel
+ */
+inline __m128i ConvertSSE2(__m128i p, FrameEncode::PixelFormat format) {
+    const __m128i byte0 = _mm_set1_epi32(0x000000FF);
+    const __m128i byte1 = _mm_set1_epi32(0x0000FF00);
+    const __m128i byte2 = _mm_set1_epi32(0x00FF0000);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    switch (format) {
+    case FrameEncode::PIXEL_BGRA8:
+        return _mm_or_si128(_mm_or_si128(_mm_and_si128(p, byte1), alpha),
+            _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), byte0), _mm_and_si128(_mm_slli_epi32(p, 16), byte2)));
+    case FrameEncode::PIXEL_A2B10G10R10:
+        return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 2), byte0), alpha),
+            _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 4), byte1), _mm_and_si128(_mm_srli_epi32(p, 6), byte2)));
+    case FrameEncode::PIXEL_A2R10G10B10:
+        return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 22), byte0), alpha),
+            _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 4), byte1), _mm_and_si128(_mm_slli_epi32(p, 14), byte2)));
+    default:
+        return _mm_or_si128(p, alpha);
+    }
+}
+
+/**
+ * @brief BGRA to RGBA with a single byte shuffle per four pixels
+ */
+ENCODE_SSSE3 void SwizzleBGRA_SSSE3(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        p = _mm_or_si128(_mm_shuffle_epi8(p, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), p);
+    }
+    for (; i < pixels; ++i) {
+        uint32_t p;
+        memcpy(&p, src + i * 4, 4);
+        p = ConvertPixel(p, FrameEncode::PIXEL_BGRA8);
+        memcpy(dst + i * 4, &p, 4);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// YUV 4:2:0: BT.601 limited range in 8-bit fixed point
+// ---------------------------------------------------------------------------
+
+inline uint8_t Luma(const uint8_t* p) {
+    return static_cast<uint8_t>(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+}
+
+/**
+ * @brief Average of a 2x2 block, rounded the same way as two rounds of _mm_avg_epu8
+ */
+inline void Average2x2(const uint8_t* a0, const uint8_t* a1, const uint8_t* b0, const uint8_t* b1, int rgb[3]) {
+    for (int c = 0; c < 3; ++c) {
+        const int left = (a0[c] + b0[c] + 1) >> 1;
+        const int right = (a1[c] + b1[c] + 1) >> 1;
+        rgb[c] = (left + right + 1) >> 1;
+    }
+}
+
+inline uint8_t ChromaU(const int rgb[3]) {
+    return static_cast<uint8_t>(((-38 * rgb[0] - 74 * rgb[1] + 112 * rgb[2] + 128) >> 8) + 128);
+}
+
+inline uint8_t ChromaV(const int rgb[3]) {
+    return static_cast<uint8_t>(((112 * rgb[0] - 94 * rgb[1] - 18 * rgb[2] + 128) >> 8) + 128);
+}
+
+/**
+ * @brief Add adjacent 32-bit lanes of a and b: [a0+a1, a2+a3, b0+b1, b2+b3]
+ */
+inline __m128i SumPairs(__m128i a, __m128i b) {
+    a = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 2, 0));
+    b = _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_add_epi32(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+}
+
+/**
+ * @brief Dot product of four RGBA8 pixels with (cR, cG, cB, 0), as 32-bit lanes
+ */
+inline __m128i Weigh4(__m128i pixels, __m128i coeffs) {
+    const __m128i zero = _mm_setzero_si128();
+    return SumPairs(_mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), coeffs),
+        _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), coeffs));
+}
+
+inline __m128i Scale(__m128i sum, int offset) {
+    return _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(128)), 8), _mm_set1_epi32(offset));
+}
+
+void LumaRow(const uint8_t* src, uint32_t width, uint8_t* dst) {
+    const __m128i coeffs = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i* in = reinterpret_cast<const __m128i*>(src + x * 4);
+        const __m128i y0 = Scale(Weigh4(_mm_loadu_si128(in + 0), coeffs), 16);
+        const __m128i y1 = Scale(Weigh4(_mm_loadu_si128(in + 1), coeffs), 16);
+        const __m128i y2 = Scale(Weigh4(_mm_loadu_si128(in + 2), coeffs), 16);
+        const __m128i y3 = Scale(Weigh4(_mm_loadu_si128(in + 3), coeffs), 16);
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(y0, y1), _mm_packs_epi32(y2, y3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), packed);
+    }
+    for (; x < width; ++x) {
+        dst[x] = Luma(src + x * 4);
+    }
+}
+
+void ChromaRow(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint8_t* u, uint8_t* v) {
+    const __m128i coeffsU = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+    const __m128i coeffsV = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m128i* a = reinterpret_cast<const __m128i*>(row0 + x * 4);
+        const __m128i* b = reinterpret_cast<const __m128i*>(row1 + x * 4);
+        __m128i left = _mm_avg_epu8(_mm_loadu_si128(a + 0), _mm_loadu_si128(b + 0));
+        __m128i right = _mm_avg_epu8(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1));
+
+        // Split into even and odd pixels, then average them horizontally
+        left = _mm_shuffle_epi32(left, _MM_SHUFFLE(3, 1, 2, 0));
+        right = _mm_shuffle_epi32(right, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i block = _mm_avg_epu8(_mm_unpacklo_epi64(left, right), _mm_unpackhi_epi64(left, right));
+
+        const __m128i uv = _mm_packs_epi32(Scale(Weigh4(block, coeffsU), 128), Scale(Weigh4(block, coeffsV), 128));
+        const __m128i bytes = _mm_packus_epi16(uv, uv);
+        const int packedU = _mm_cvtsi128_si32(bytes);
+        const int packedV = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 4));
+        memcpy(u + x / 2, &packedU, 4);
+        memcpy(v + x / 2, &packedV, 4);
+    }
+    for (; x < width; x += 2) {
+        const uint32_t next = x + 1 < width ? x + 1 : x;
+        int rgb[3];
+        Average2x2(row0 + x * 4, row0 + next * 4, row1 + x * 4, row1 + next * 4, rgb);
+        u[x / 2] = ChromaU(rgb);
+        v[x / 2] = ChromaV(rgb);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// QOI
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Append a few bytes; vector::insert of a short list trips GCC's overflow warnings at -O2
+ */
+void PutBytes(std::vector<uint8_t>& out, std::initializer_list<uint8_t> bytes) {
+    size_t at = out.size();
+    out.resize(at + bytes.size());
+    for (uint8_t byte : bytes) {
+        out[at++] = byte;
+    }
+}
+
+void PutBE32(std::vector<uint8_t>& out, uint32_t value) {
+    PutBytes(out, {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+                   static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)});
+}
+
+bool EncodeQOI(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    constexpr uint8_t QOI_OP_INDEX = 0x00;
+    constexpr uint8_t QOI_OP_DIFF = 0x40;
+    constexpr uint8_t QOI_OP_LUMA = 0x80;
+    constexpr uint8_t QOI_OP_RUN = 0xC0;
+    constexpr uint8_t QOI_OP_RGB = 0xFE;
+    constexpr uint8_t QOI_OP_RGBA = 0xFF;
+
+    const size_t pixels = static_cast<size_t>(width) * height;
+    out.clear();
+    out.reserve(14 + pixels * 4 / 3 + 8);
+    PutBytes(out, {'q', 'o', 'i', 'f'});
+    PutBE32(out, width);
+    PutBE32(out, height);
+    out.push_back(4); // channels
+    out.push_back(0); // sRGB with linear alpha
+
+    std::array<uint32_t, 64> index{};
+    uint32_t previous = 0xFF000000u;
+    uint8_t run = 0;
+
+    for (size_t i = 0; i < pixels; ++i) {
+        uint32_t pixel;
+        memcpy(&pixel, rgba + i * 4, 4);
+
+        if (pixel == previous) {
+            if (++run == 62 || i + 1 == pixels) {
+                out.push_back(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(QOI_OP_RUN | (run - 1));
+            run = 0;
+        }
+
+        const uint8_t r = pixel & 0xFF, g = (pixel >> 8) & 0xFF, b = (pixel >> 16) & 0xFF, a = pixel >> 24;
+        const uint8_t slot = (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+
+        if (index[slot] == pixel) {
+            out.push_back(QOI_OP_INDEX | slot);
+        } else if (a == (previous >> 24)) {
+            const int8_t dr = static_cast<int8_t>(r - (previous & 0xFF));
+            const int8_t dg = static_cast<int8_t>(g - ((previous >> 8) & 0xFF));
+            const int8_t db = static_cast<int8_t>(b - ((previous >> 16) & 0xFF));
+            const int8_t drdg = static_cast<int8_t>(dr - dg);
+            const int8_t dbdg = static_cast<int8_t>(db - dg);
+
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                out.push_back(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+            } else if (dg >= -32 && dg <= 31 && drdg >= -8 && drdg <= 7 && dbdg >= -8 && dbdg <= 7) {
+                out.push_back(QOI_OP_LUMA | (dg + 32));
+                out.push_back(static_cast<uint8_t>(((drdg + 8) << 4) | (dbdg + 8)));
+            } else {
+                PutBytes(out, {QOI_OP_RGB, r, g, b});
+            }
+        } else {
+            PutBytes(out, {QOI_OP_RGBA, r, g, b, a});
+        }
+
+        index[slot] = pixel;
+        previous = pixel;
+    }
+
+    PutBytes(out, {0, 0, 0, 0, 0, 0, 0, 1});
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// PNG: filtered RGB rows, deflated with fixed Huffman codes and a greedy LZ77
+// ---------------------------------------------------------------------------
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void Put(uint32_t bits, uint32_t count) {
+        buffer_ |= static_cast<uint64_t>(bits) << count_;
+        count_ += count;
+        while (count_ >= 8) {
+            out_.push_back(static_cast<uint8_t>(buffer_));
+            buffer_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    // Huffman codes are defined MSB first
+    void PutReversed(uint32_t code, uint32_t count) {
+        uint32_t reversed = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        Put(reversed, count);
+    }
+
+    void Flush() {
+        if (count_ > 0) {
+            out_.push_back(static_cast<uint8_t>(buffer_));
+        }
+        buffer_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t buffer_ = 0;
+    uint32_t count_ = 0;
+};
+
+constexpr uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+void PutLiteralLength(BitWriter& bits, uint32_t symbol) {
+    if (symbol < 144) {
+        bits.PutReversed(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        bits.PutReversed(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        bits.PutReversed(symbol - 256, 7);
+    } else {
+        bits.PutReversed(0xC0 + symbol - 280, 8);
+    }
+}
+
+void PutMatch(BitWriter& bits, uint32_t length, uint32_t distance) {
+    uint32_t code = 28;
+    while (kLengthBase[code] > length) {
+        --code;
+    }
+    PutLiteralLength(bits, 257 + code);
+    bits.Put(length - kLengthBase[code], kLengthExtra[code]);
+
+    code = 29;
+    while (kDistanceBase[code] > distance) {
+        --code;
+    }
+    bits.PutReversed(code, 5);
+    bits.Put(distance - kDistanceBase[code], kDistanceExtra[code]);
+}
+
+/**
+ * @brief zlib stream with a single fixed-Huffman deflate block
+ */
+void Deflate(const std::vector<uint8_t>& data, std::vector<uint8_t>& out) {
+    constexpr uint32_t kWindow = 32768;
+    constexpr uint32_t kHashBits = 15;
+    constexpr uint32_t kMaxMatch = 258;
+
+    out.push_back(0x78);
+    out.push_back(0x01);
+
+    BitWriter bits(out);
+    bits.Put(1, 1); // final block
+    bits.Put(1, 2); // fixed Huffman codes
+
+    std::vector<int32_t> head(1u << kHashBits, -1);
+    const size_t size = data.size();
+    size_t i = 0;
+    while (i < size) {
+        uint32_t bestLength = 0;
+        uint32_t bestDistance = 0;
+
+        if (i + 3 <= size) {
+            const uint32_t hash = ((data[i] << 16 | data[i + 1] << 8 | data[i + 2]) * 2654435761u) >> (32 - kHashBits);
+            const int32_t candidate = head[hash];
+            head[hash] = static_cast<int32_t>(i);
+
+            if (candidate >= 0 && i - candidate <= kWindow) {
+                const size_t limit = std::min<size_t>(kMaxMatch, size - i);
+                uint32_t length = 0;
+                while (length < limit && data[candidate + length] == data[i + length]) {
+                    ++length;
+                }
+                if (length >= 3) {
+                    bestLength = length;
+                    bestDistance = static_cast<uint32_t>(i - candidate);
+                }
+            }
+        }
+
+        if (bestLength > 0) {
+            PutMatch(bits, bestLength, bestDistance);
+            i += bestLength;
+        } else {
+            PutLiteralLength(bits, data[i]);
+            ++i;
+        }
+    }
+    PutLiteralLength(bits, 256);
+    bits.Flush();
+
+    uint32_t a = 1, b = 0;
+    for (size_t n = 0; n < size;) {
+        // Largest block that cannot overflow before the modulo
+        const size_t end = std::min(size, n + 5552);
+        for (; n < end; ++n) {
+            a += data[n];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    PutBE32(out, (b << 16) | a);
+}
+
+uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void PutChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& payload) {
+    PutBE32(out, static_cast<uint32_t>(payload.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+    PutBE32(out, Crc32(out.data() + start, out.size() - start));
+}
+
+bool EncodePNG(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    // Frames are opaque, so store RGB with the Sub filter on every row
+    const size_t stride = static_cast<size_t>(width) * 3;
+    std::vector<uint8_t> filtered;
+    filtered.reserve((stride + 1) * height);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* row = rgba + static_cast<size_t>(y) * width * 4;
+        filtered.push_back(1);
+        uint8_t previous[3] = {0, 0, 0};
+        for (uint32_t x = 0; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                const uint8_t value = row[x * 4 + c];
+                filtered.push_back(static_cast<uint8_t>(value - previous[c]));
+                previous[c] = value;
+            }
+        }
+    }
+
+    std::vector<uint8_t> header;
+    PutBE32(header, width);
+    PutBE32(header, height);
+    PutBytes(header, {8, 2, 0, 0, 0}); // 8-bit RGB, deflate, adaptive filtering, no interlace
+
+    std::vector<uint8_t> idat;
+    idat.reserve(filtered.size() / 2);
+    Deflate(filtered, idat);
+
+    out.clear();
+    PutBytes(out, {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'});
+    PutChunk(out, "IHDR", header);
+    PutChunk(out, "IDAT", idat);
+    PutChunk(out, "IEND", {});
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Raw: RGBA8 behind a PAM header so common tools can still open it
+// ---------------------------------------------------------------------------
+
+bool EncodeRaw(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    const std::string header = "P7\nWIDTH " + std::to_string(width) + "\nHEIGHT " + std::to_string(height) +
+        "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+    const size_t size = static_cast<size_t>(width) * height * 4;
+
+    out.clear();
+    out.reserve(header.size() + size);
+    out.insert(out.end(), header.begin(), header.end());
+    out.insert(out.end(), rgba, rgba + size);
+    return true;
+}
+
+std::vector<FrameEncode::Encoder>& Encoders() {
+    static std::vector<FrameEncode::Encoder> encoders = {
+        {"raw", "pam", &EncodeRaw},
+        {"qoi", "qoi", &EncodeQOI},
+        {"png", "png", &EncodePNG},
+    };
+    return encoders;
+}
+
+} // namespace
+
+namespace FrameEncode {
+
+void ToRGBA8(const void* src, uint8_t* dst, size_t pixels, PixelFormat format) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+
+    if (format == PIXEL_BGRA8 && HasSSSE3()) {
+        SwizzleBGRA_SSSE3(in, dst, pixels);
+        return;
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), ConvertSSE2(p, format));
+    }
+    for (; i < pixels; ++i) {
+        uint32_t p;
+        memcpy(&p, in + i * 4, 4);
+        p = ConvertPixel(p, format);
+        memcpy(dst + i * 4, &p, 4);
+    }
+}
+
+void RGBA8ToI420Rows(const uint8_t* row0, const uint8_t* row1, uint32_t width,
+    uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v) {
+    LumaRow(row0, width, y0);
+    if (y1) {
+        LumaRow(row1, width, y1);
+    }
+    ChromaRow(row0, row1, width, u, v);
+}
+
+void RegisterEncoder(const Encoder& encoder) {
+    for (Encoder& existing : Encoders()) {
+        if (existing.name == std::string(encoder.name)) {
+            existing = encoder;
+            return;
+        }
+    }
+    Encoders().push_back(encoder);
+}
+
+const Encoder* FindEncoder(const std::string& name) {
+    for (const Encoder& encoder : Encoders()) {
+        if (name == encoder.name) {
+            return &encoder;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace FrameEncode
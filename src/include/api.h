@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include <vulkan/vulkan.h>
+
 #ifdef _MSC_VER
     #define MOD_API __declspec(dllexport)
 #else   
@@ -18,6 +20,75 @@ typedef struct ModInfo {
     std::string version;
 }ModInfo;
 
+struct ModTexture; // Image loaded for the overlay, owned by the mod loader
+struct ModPointerPath; // Pointer chain into Sky.exe, resolved by the mod loader every frame
+struct ModScan;        // Memory scan results, owned by the mod until ReleaseScan
+struct ModVmtHook;     // Virtual function hook, owned by the mod loader
+
+/**
+ * @brief The overlay pass mod command buffers draw into; pipelines must be compatible with it
+ */
+struct ModRenderTarget {
+    VkDevice device;
+    VkRenderPass renderPass; // VK_NULL_HANDLE when the overlay renders dynamically
+    uint32_t subpass;
+    VkFormat colorFormat;    // For VkPipelineRenderingCreateInfo when rendering dynamically
+    VkExtent2D extent;
+    uint64_t generation;     // Changes whenever the target is recreated
+};
+
+enum ModInputType : uint16_t {
+    MOD_INPUT_KEY_DOWN,    // code: virtual-key code
+    MOD_INPUT_KEY_UP,
+    MOD_INPUT_CHAR,        // code: UTF-16 code unit
+    MOD_INPUT_MOUSE_MOVE,  // x, y: client coordinates
+    MOD_INPUT_MOUSE_DOWN,  // code: 0 left, 1 right, 2 middle, 3 and 4 extra buttons
+    MOD_INPUT_MOUSE_UP,
+    MOD_INPUT_MOUSE_WHEEL, // y: vertical delta, x: horizontal delta, in WHEEL_DELTA units
+    MOD_INPUT_FOCUS,       // code: 1 when the game window gains focus, 0 when it loses it
+};
+
+enum ModInputFlags : uint16_t {
+    MOD_INPUT_SHIFT = 1 << 0,
+    MOD_INPUT_CTRL = 1 << 1,
+    MOD_INPUT_ALT = 1 << 2,
+    MOD_INPUT_REPEAT = 1 << 3,   // Key held down, sent again by auto-repeat
+    MOD_INPUT_CAPTURED = 1 << 4, // The overlay UI took the message; the game did not see it
+};
+
+/**
+ * @brief One window input message, as the mod loader saw it
+ */
+struct ModInputEvent {
+    uint64_t time;  // std::chrono::steady_clock time in microseconds
+    uint16_t type;  // ModInputType
+    uint16_t flags; // ModInputFlags
+    uint32_t code;
+    int32_t x;
+    int32_t y;
+};
+
+/**
+ * @brief A reader's position in the input stream; every reader sees every event
+ */
+struct ModInputCursor {
+    uint64_t position;
+};
+
+enum ModScanType : uint32_t {
+    MOD_SCAN_INT32, // 4-byte aligned
+    MOD_SCAN_FLOAT, // 4-byte aligned, equal within the scan's tolerance
+    MOD_SCAN_BYTES, // Byte pattern at any address
+};
+
+enum ModScanCondition : uint32_t {
+    MOD_SCAN_EQUAL,
+    MOD_SCAN_CHANGED,   // Since the previous scan
+    MOD_SCAN_UNCHANGED,
+    MOD_SCAN_INCREASED, // Not for MOD_SCAN_BYTES
+    MOD_SCAN_DECREASED, // Not for MOD_SCAN_BYTES
+};
+
 class MOD_API ModApi {
 protected:
     static ModApi *instance;
@@ -33,4 +104,171 @@ public:
 
     uintptr_t GetSkyBase();
     uintptr_t GetSkySize();
+
+    /**
+     * @brief Start loading an image file (PNG, JPEG, BMP, TGA, ...) for ImGui::Image
+     *
+     * The file is decoded and uploaded in the background. Loading a path again
+     * returns the same texture with one more reference.
+     */
+    ModTexture* LoadTextureAsync(const std::string& path);
+
+    /**
+     * @brief Get the ImTextureID to draw a texture with; ask again every frame it is drawn
+     * @return nullptr while the texture is loading, or if it failed to load
+     */
+    void* GetTextureId(ModTexture* texture, uint32_t* width = nullptr, uint32_t* height = nullptr);
+
+    /**
+     * @brief Drop a reference taken by LoadTextureAsync
+     */
+    void ReleaseTexture(ModTexture* texture);
+
+    /**
+     * @brief Get the overlay pass to build pipelines for
+     * @return false until the overlay has a swapchain to draw on
+     */
+    bool GetRenderTarget(ModRenderTarget& target);
+
+    /**
+     * @brief Begin a secondary command buffer that continues the overlay pass
+     *
+     * Works from any thread; record and submit on the thread that began it.
+     * Buffers submitted while a UI frame is built are drawn under the UI on
+     * every present until the next UI frame, in the order they were submitted.
+     * @return VK_NULL_HANDLE when the overlay has no render target
+     */
+    VkCommandBuffer BeginCommandBuffer();
+
+    /**
+     * @brief End a buffer from BeginCommandBuffer and queue it for the next UI frame
+     *
+     * Buffers begun before the render target changed are dropped.
+     */
+    void SubmitCommandBuffer(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Start reading input events from now on
+     */
+    ModInputCursor OpenInput();
+
+    /**
+     * @brief Copy out the events received since the last read, oldest first; safe from any thread
+     * @param dropped Set to the number of events missed because the reader fell too far behind
+     * @return Number of events written to events
+     */
+    size_t ReadInput(ModInputCursor& cursor, ModInputEvent* events, size_t maxEvents, uint64_t* dropped = nullptr);
+
+    /**
+     * @brief Whether a key is held down, as of the last window message
+     */
+    bool IsKeyDown(uint32_t virtualKey);
+
+    /**
+     * @brief Share a pointer chain from the Sky base with every mod
+     *
+     * The pointer at GetSkyBase() + baseOffset is followed through each offset
+     * but the last, as with LM_DeepPointer, and size bytes are read at the last
+     * pointer plus the last offset. The loader resolves every path on every
+     * present, whether or not the menu is open, before mods render.
+     * Registering a name again with the same chain returns the same path.
+     * @return nullptr if the name is taken by a different chain
+     */
+    ModPointerPath* RegisterPointerPath(const std::string& name, uintptr_t baseOffset, const std::vector<uintptr_t>& offsets, size_t size);
+
+    /**
+     * @brief Get a path another mod registered
+     */
+    ModPointerPath* FindPointerPath(const std::string& name);
+
+    /**
+     * @brief Read-only snapshot of a path for this frame; only valid in Render
+     * @return nullptr while the chain does not resolve, or if size differs from the registered size
+     */
+    const void* GetSnapshot(ModPointerPath* path, size_t size);
+
+    template <typename T>
+    const T* GetSnapshot(ModPointerPath* path) {
+        return static_cast<const T*>(GetSnapshot(path, sizeof(T)));
+    }
+
+    /**
+     * @brief Scan the game's writable memory for a value, using every pool thread
+     *
+     * Blocks until the scan is done; call it from a worker thread of the mod.
+     * @param size 4 for numeric types, the pattern length for MOD_SCAN_BYTES
+     * @return nullptr if the value does not fit the type
+     */
+    ModScan* FirstScan(ModScanType type, const void* value, size_t size, float tolerance = 0.0f);
+
+    /**
+     * @brief Keep the results that meet condition now
+     * @param value Required for MOD_SCAN_EQUAL, the size of the first scan's value
+     * @return false if the condition does not apply to the scan's type
+     */
+    bool NextScan(ModScan* scan, ModScanCondition condition, const void* value = nullptr);
+
+    uint64_t GetScanCount(ModScan* scan);
+
+    /**
+     * @brief Copy out up to maxAddresses results, lowest address first
+     */
+    size_t GetScanResults(ModScan* scan, uintptr_t* addresses, size_t maxAddresses);
+    void ReleaseScan(ModScan* scan);
+
+    /**
+     * @brief Address of a class's vtable in Sky.exe, found through its RTTI
+     *
+     * The index is built in the background at startup and cached per Sky.exe
+     * build. A call from Start, before the background build has begun, builds
+     * it on the calling thread; later calls may wait for it. Hook virtuals by
+     * slot with HookVTable or HookObject.
+     * @param name "class Foo::Bar", or the decorated ".?AVBar@Foo@@"
+     * @param offset Of the subobject whose vtable is wanted, 0 for the primary vtable
+     * @param slots Set to the number of virtual functions in the vtable
+     * @return 0 if the class has no vtable at that offset
+     */
+    uintptr_t FindVTable(const std::string& name, uint32_t offset = 0, size_t* slots = nullptr);
+
+    /**
+     * @brief Hook a virtual function of every object of a class, in the class's vtable
+     *
+     * Hooks from every mod on the same slot are chained: higher priority runs
+     * first, equal priorities in the order they were added. A hook continues
+     * the chain by calling the function from GetVmtNext. Hooks added while
+     * mods start are installed together once all of them have started, and a
+     * mod's hooks are removed when it is disabled or unloaded. Adding them in
+     * Start never waits on the loader's background threads.
+     * @param vtable From FindVTable
+     * @param hook A function with the virtual's signature, hooked at most once per slot
+     * @return nullptr if the vtable is not one of Sky.exe or slot is out of range
+     */
+    ModVmtHook* HookVTable(uintptr_t vtable, size_t slot, void* hook, int priority = 0);
+
+    /**
+     * @brief Hook a virtual function of one object, through a shadow copy of its vtable
+     *
+     * The object's chain runs before its class's. Unhook before the game frees
+     * the object.
+     */
+    ModVmtHook* HookObject(void* object, size_t slot, void* hook, int priority = 0);
+
+    /**
+     * @brief The function a hook calls to continue the chain; the original when it is last
+     */
+    void* GetVmtNext(ModVmtHook* hook);
+
+    template <typename Fn>
+    Fn GetVmtNext(ModVmtHook* hook) {
+        return reinterpret_cast<Fn>(GetVmtNext(hook));
+    }
+
+    /**
+     * @brief Remove a hook; the handle must not be used again
+     *
+     * A call already in the hook can still continue the chain for a few
+     * seconds, after which the loader frees the handle. The same goes for
+     * every hook of a mod once it is disabled.
+     */
+    void UnhookVmt(ModVmtHook* hook);
 };
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vk_layer_dispatch_table.h>
+
+/**
+ * @brief Optional per-function Vulkan API call profiler (FEATURE_PROFILER)
+ *
+ * Wraps every device-level entry point of VkLayerDispatchTable and records call
+ * counts and cumulative CPU time in per-thread counters. When the feature is
+ * disabled none of this is wired up and the wrappers are never returned.
+ */
+namespace ApiProfiler {
+    void OnCreateDevice(VkDevice device, VkLayerDispatchTable& table);
+    void OnDestroyDevice(VkDevice device);
+    PFN_vkVoidFunction GetProcAddr(VkDevice device, const char* pName);
+
+    void EndFrame();
+    void RenderOverlay();
+} // namespace ApiProfiler
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief Asynchronous screenshot capture and video recording (FEATURE_CAPTURE)
+ *
+ * On request, the next presented swapchain image is copied into a host-visible
+ * buffer from a small ring inside the overlay's own command buffer. A fence
+ * submitted right behind it is waited on by a worker thread, which converts
+ * and encodes the frame, so the present path never blocks on the readback.
+ *
+ * While recording, every Nth frame takes the same path and is converted to
+ * I420 on the shared thread pool, then streamed as Y4M, raw I420 or into an
+ * encoder's stdin. A frame that finds the ring full is dropped.
+ */
+namespace Capture {
+    /**
+     * @brief Ask for the next presented frame to be saved; safe from any thread
+     */
+    void Request();
+
+    /**
+     * @brief Start or stop recording from the next presented frame; safe from any thread
+     */
+    void ToggleRecording();
+
+    /**
+     * @brief Whether no screenshot or recording needs RecordCopy on upcoming frames
+     */
+    bool IsIdle();
+
+    void OnCreateDevice(VkDevice device, const VkPhysicalDeviceMemoryProperties& memoryProperties);
+    void OnDestroyDevice(VkDevice device);
+    void OnCreateSwapchain(VkFormat format, bool readable);
+
+    /**
+     * @brief Record the readback of a swapchain image if a capture is pending
+     * @param cmd Overlay command buffer, recording, outside of a render pass
+     * @param image Swapchain image in VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, left in that layout
+     * @param extent Size of the swapchain images
+     * @return Whether a copy was recorded and EndFrame must be called after the submit
+     */
+    bool RecordCopy(VkCommandBuffer cmd, VkImage image, VkExtent2D extent);
+
+    /**
+     * @brief Hand the recorded copy to the worker once the command buffer is submitted
+     * @param queue The queue the command buffer was submitted to
+     */
+    void EndFrame(VkQueue queue);
+
+    /**
+     * @brief Recording controls, bandwidth, dropped frames and present overhead
+     */
+    void RenderOverlay();
+} // namespace Capture
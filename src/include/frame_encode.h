@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Pixel conversion and image encoders for frames read back from the swapchain
+ *
+ * Conversion to RGBA8 uses SSE2, with an SSSE3 shuffle for BGRA when the CPU
+ * supports it. Encoders are looked up by name, so new output formats only need
+ * to be registered once at startup.
+ */
+namespace FrameEncode {
+    /**
+     * @brief Supported source pixel layouts, one 32-bit word per pixel
+     */
+    enum PixelFormat {
+        PIXEL_RGBA8,
+        PIXEL_BGRA8,
+        PIXEL_A2B10G10R10, // R in the low bits, as VK_FORMAT_A2B10G10R10_UNORM_PACK32
+        PIXEL_A2R10G10B10, // B in the low bits, as VK_FORMAT_A2R10G10B10_UNORM_PACK32
+    };
+
+    /**
+     * @brief Convert pixels to opaque RGBA8
+     * @param src Source pixels, 4-byte aligned
+     * @param dst Destination, 4 bytes per pixel, may alias src
+     * @param pixels Number of pixels
+     * @param format Layout of the source pixels
+     */
+    void ToRGBA8(const void* src, uint8_t* dst, size_t pixels, PixelFormat format);
+
+    /**
+     * @brief Convert two RGBA8 rows to planar YUV 4:2:0 (BT.601, limited range)
+     * @param row0 First source row
+     * @param row1 Second source row; pass row0 again for the last row of an odd height
+     * @param width Pixels per row
+     * @param y0 Luma for row0
+     * @param y1 Luma for row1, or nullptr to skip it
+     * @param u Chroma destination, (width + 1) / 2 samples
+     * @param v Chroma destination, (width + 1) / 2 samples
+     */
+    void RGBA8ToI420Rows(const uint8_t* row0, const uint8_t* row1, uint32_t width,
+        uint8_t* y0, uint8_t* y1, uint8_t* u, uint8_t* v);
+
+    using EncodeFn = bool (*)(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out);
+
+    /**
+     * @brief An output format for captured frames
+     */
+    struct Encoder {
+        const char* name;      // Config name, e.g. "png"
+        const char* extension; // File extension without the dot
+        EncodeFn encode;
+    };
+
+    /**
+     * @brief Add or replace an encoder; call before the first capture
+     */
+    void RegisterEncoder(const Encoder& encoder);
+
+    /**
+     * @brief Find an encoder by name
+     * @return The encoder, or nullptr when no encoder has that name
+     */
+    const Encoder* FindEncoder(const std::string& name);
+} // namespace FrameEncode
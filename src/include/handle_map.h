@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compact open-addressing map from non-dispatchable Vulkan handles to small values
+ *
+ * Linear probing over a power-of-two array of {key, value} pairs with
+ * backward-shift deletion, so there are no tombstones and lookups stay short
+ * however many objects come and go. Handle 0 (VK_NULL_HANDLE) marks an empty
+ * slot and cannot be stored. Not thread-safe; callers hold their own lock.
+ *
+ * @tparam Value Trivially copyable payload
+ */
+template <typename Value>
+class HandleMap {
+public:
+    /**
+     * @brief Convert any Vulkan handle (pointer or 64-bit integer) to a key
+     */
+    template <typename Handle>
+    static uint64_t Key(Handle handle) {
+        return (uint64_t)handle;
+    }
+
+    void Insert(uint64_t key, const Value& value) {
+        if ((count_ + 1) * 4 > entries_.size() * 3) {
+            Grow();
+        }
+
+        size_t slot = Find(key);
+        if (entries_[slot].key == 0) {
+            ++count_;
+        }
+        entries_[slot] = {key, value};
+    }
+
+    /**
+     * @brief Remove a key
+     * @param value Receives the stored value when the key was present
+     * @return Whether the key was present
+     */
+    bool Erase(uint64_t key, Value* value = nullptr) {
+        if (entries_.empty()) {
+            return false;
+        }
+
+        size_t slot = Find(key);
+        if (entries_[slot].key == 0) {
+            return false;
+        }
+        if (value) {
+            *value = entries_[slot].value;
+        }
+
+        // Pull back later members of the probe chain into the hole
+        const size_t mask = entries_.size() - 1;
+        size_t hole = slot;
+        for (size_t next = (hole + 1) & mask; entries_[next].key != 0; next = (next + 1) & mask) {
+            const size_t home = Home(entries_[next].key);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                entries_[hole] = entries_[next];
+                hole = next;
+            }
+        }
+        entries_[hole].key = 0;
+        --count_;
+        return true;
+    }
+
+    /**
+     * @brief The value stored for a key, nullptr when absent; valid until the next Insert or Erase
+     */
+    Value* Get(uint64_t key) {
+        if (entries_.empty()) {
+            return nullptr;
+        }
+        Entry& entry = entries_[Find(key)];
+        return entry.key != 0 ? &entry.value : nullptr;
+    }
+
+    const Value* Get(uint64_t key) const {
+        return const_cast<HandleMap*>(this)->Get(key);
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+private:
+    struct Entry {
+        uint64_t key;
+        Value value;
+    };
+
+    size_t Home(uint64_t key) const {
+        // Fibonacci hashing; handles are often aligned pointers or small counters
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (entries_.size() - 1);
+    }
+
+    size_t Find(uint64_t key) const {
+        const size_t mask = entries_.size() - 1;
+        size_t slot = Home(key);
+        while (entries_[slot].key != 0 && entries_[slot].key != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void Grow() {
+        std::vector<Entry> old(entries_.empty() ? 64 : entries_.size() * 2);
+        old.swap(entries_);
+        count_ = 0;
+        for (const Entry& entry : old) {
+            if (entry.key != 0) {
+                entries_[Find(entry.key)] = entry;
+                ++count_;
+            }
+        }
+    }
+
+    std::vector<Entry> entries_;
+    size_t count_ = 0;
+};
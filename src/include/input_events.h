@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <windows.h>
+
+#include "api.h"
+
+/**
+ * @brief Window input as a timestamped event stream for mods
+ *
+ * The game's window procedure translates input messages once and appends
+ * them to a fixed ring it is the only writer of. Any number of readers on any
+ * thread follow the ring with their own cursor and never block the window
+ * thread; a reader that falls a whole ring behind skips ahead and is told how
+ * many events it missed.
+ */
+namespace InputEvents {
+    /**
+     * @brief Append the event for a window message, if it is an input message
+     * @param captured Whether the overlay UI took the message
+     *
+     * Window thread only.
+     */
+    void Publish(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam, bool captured);
+
+    ModInputCursor Open();
+    size_t Read(ModInputCursor& cursor, ModInputEvent* events, size_t maxEvents, uint64_t* dropped);
+    bool IsKeyDown(uint32_t virtualKey);
+} // namespace InputEvents
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Optional layer features, toggled from the "layerFeatures" object in tsml_config.json
+ *
+ * Entry points that belong to a disabled feature are never returned from the
+ * layer's GetProcAddr functions, so the game calls the next layer directly.
+ */
+enum LayerFeature : uint32_t {
+    FEATURE_NONE       = 0,
+    FEATURE_OVERLAY    = 1u << 0,
+    FEATURE_PROFILER   = 1u << 1,
+    FEATURE_DRAWSTATS  = 1u << 2,
+    FEATURE_MEMTRACKER = 1u << 3,
+    FEATURE_CAPTURE    = 1u << 4,
+    FEATURE_OVERLAY_CACHE = 1u << 5,
+    FEATURE_METRICS    = 1u << 6,
+    FEATURE_SAMPLER    = 1u << 7,
+    FEATURE_SCANNER    = 1u << 8,
+    FEATURE_TRACE      = 1u << 9,
+    // Not a "layerFeatures" key: set by Load when the "swapchain" object overrides anything
+    FEATURE_SWAPCHAIN_OVERRIDES = 1u << 31,
+};
+
+/**
+ * @brief Overlay settings from the "overlay" object
+ */
+struct OverlaySettings {
+    uint32_t uiTickRate = 0;        // UI rebuilds per second, 0 rebuilds it on every present
+    uint32_t textureBudgetMb = 256; // Memory for mod textures before the least recently drawn are evicted
+    uint32_t stagingBufferMb = 32;  // Size of the staging ring uploads to the GPU go through
+};
+
+/**
+ * @brief Swapchain overrides from the "swapchain" object, applied in vkCreateSwapchainKHR
+ */
+struct SwapchainOverrides {
+    int32_t presentMode = -1;   // VkPresentModeKHR, -1 keeps the game's choice
+    uint32_t minImageCount = 0; // 0 keeps the game's choice
+};
+
+/**
+ * @brief Screenshot settings from the "capture" object
+ */
+struct CaptureSettings {
+    std::string format = "png";           // Name of a FrameEncode encoder
+    std::string directory = "screenshots";
+    uint32_t hotkey = 0x7B;               // Virtual-key code, F12 by default
+};
+
+/**
+ * @brief Video recording settings from the "recording" object
+ */
+struct RecordingSettings {
+    std::string output = "y4m";  // "y4m", "raw" (headerless I420) or "pipe"
+    std::string pipeCommand = "ffmpeg -y -f yuv4mpegpipe -i - -c:v libx264 -preset veryfast recording.mp4";
+    uint32_t frameInterval = 1;  // Record every Nth presented frame
+    uint32_t frameRate = 60;     // Game frame rate; the Y4M header uses frameRate / frameInterval
+    uint32_t hotkey = 0x7A;      // Virtual-key code, F11 by default
+};
+
+/**
+ * @brief Timeline tracing settings from the "trace" object, used with FEATURE_TRACE
+ */
+struct TraceSettings {
+    std::string output = "tsml_trace.json"; // Chrome trace_event JSON
+    uint32_t hotkey = 0x78;                 // Virtual-key code that starts and stops tracing, F9 by default
+    bool startup = false;                   // Trace from the moment the loader is attached
+};
+
+/**
+ * @brief Sampling profiler settings from the "sampler" object
+ */
+struct SamplerSettings {
+    uint32_t intervalMs = 2;  // Between samples, rounded up to the system timer resolution
+    uint32_t stackDepth = 8;  // Frames unwound per sample, at most 16
+};
+
+/**
+ * @brief Layer settings read once at startup
+ */
+struct LayerSettings {
+    uint32_t features = FEATURE_OVERLAY;
+    OverlaySettings overlay;
+    SwapchainOverrides swapchain;
+    CaptureSettings capture;
+    RecordingSettings recording;
+    TraceSettings trace;
+    SamplerSettings sampler;
+};
+
+namespace LayerConfig {
+    void Load(const std::string& filename);
+    const LayerSettings& Get();
+
+    /**
+     * @brief Check whether all of the given features are enabled
+     * @param features LayerFeature bits
+     */
+    inline bool IsEnabled(uint32_t features) {
+        return (Get().features & features) == features;
+    }
+
+    /**
+     * @brief Check whether at least one of the given features is enabled
+     * @param features LayerFeature bits
+     */
+    inline bool IsAnyEnabled(uint32_t features) {
+        return (Get().features & features) != 0;
+    }
+} // namespace LayerConfig
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vk_layer_dispatch_table.h>
+
+/**
+ * @brief Extract the dispatch table key from a Vulkan dispatchable object
+ * @param inst The Vulkan dispatchable object
+ * @return Pointer to use as key in dispatch tables
+ */
+template<typename DispatchableType>
+void* GetKey(DispatchableType inst) {
+    return *(void**)inst;
+}
+
+/**
+ * @brief Get the next layer's dispatch table of a device without taking the global lock
+ *
+ * Meant for intercepts on hot paths such as command buffer recording, where
+ * every call would otherwise serialise on the dispatch map.
+ *
+ * @param key Dispatch key of any object owned by the device
+ */
+const VkLayerDispatchTable& GetDeviceDispatch(void* key);
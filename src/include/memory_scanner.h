@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "api.h"
+#include "scan_engine.h"
+
+/**
+ * @brief In-process value scanner for mod development (FEATURE_SCANNER)
+ *
+ * Feeds the committed, readable pages of the game from LM_EnumPages to
+ * ScanEngine, with access violations caught per chunk so memory the game
+ * frees mid-scan only drops that chunk. Used by ModApi and by an overlay
+ * window that runs its scans on the thread pool.
+ */
+namespace MemoryScanner {
+    /**
+     * @param writableOnly Skip pages the game cannot write, which hold no game state
+     */
+    std::vector<ScanEngine::Region> CommittedRegions(bool writableOnly);
+
+    ModScan* First(ModScanType type, const void* value, size_t size, float tolerance);
+    bool Next(ModScan* scan, ModScanCondition condition, const void* value);
+    uint64_t Count(const ModScan* scan);
+    size_t Results(const ModScan* scan, uintptr_t* addresses, size_t maxAddresses);
+    void Release(ModScan* scan);
+
+    void RenderOverlay();
+} // namespace MemoryScanner
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vk_layer_dispatch_table.h>
+
+/**
+ * @brief Optional device memory tracker (FEATURE_MEMTRACKER)
+ *
+ * Records every live VkDeviceMemory allocation per memory type and heap, plus
+ * the buffers and images created on top of them and how much of each
+ * memory type they are bound to. When the driver supports
+ * VK_EXT_memory_budget the heap usage and budget are sampled as well, so the
+ * overlay can show VRAM pressure over time.
+ */
+namespace MemoryTracker {
+    void OnCreateDevice(VkPhysicalDevice physicalDevice, const VkLayerInstanceDispatchTable& instanceTable);
+
+    void EndFrame();
+    void RenderOverlay();
+} // namespace MemoryTracker
+
+// Intercepts, resolved through the layer's intercept table
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_AllocateMemory(VkDevice device, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks* pAllocator, VkDeviceMemory* pMemory);
+VKAPI_ATTR void VKAPI_CALL ModLoader_FreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks* pAllocator);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_CreateBuffer(VkDevice device, const VkBufferCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkBuffer* pBuffer);
+VKAPI_ATTR void VKAPI_CALL ModLoader_DestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks* pAllocator);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_CreateImage(VkDevice device, const VkImageCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkImage* pImage);
+VKAPI_ATTR void VKAPI_CALL ModLoader_DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindImageMemory(VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize memoryOffset);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindBufferMemory2(VkDevice device, uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindBufferMemory2KHR(VkDevice device, uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindImageMemory2(VkDevice device, uint32_t bindInfoCount, const VkBindImageMemoryInfo* pBindInfos);
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindImageMemory2KHR(VkDevice device, uint32_t bindInfoCount, const VkBindImageMemoryInfo* pBindInfos);
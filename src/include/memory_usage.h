@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+#include "handle_map.h"
+
+/**
+ * @brief Live device memory, buffers and images of one device, by memory type
+ *
+ * The accounting behind the memory tracker. Buffers and images are counted
+ * from creation; once bound, their size also counts as used in the memory
+ * type of their allocation, which shows how much of the allocated memory
+ * resources actually occupy. Keys are HandleMap keys. Not thread-safe; the
+ * tracker holds its lock around every call.
+ */
+class MemoryUsage {
+public:
+    struct TypeUsage {
+        uint64_t bytes; // Allocated
+        uint64_t count;
+        uint64_t bound; // Of bytes, taken by bound buffers and images
+    };
+
+    void Allocate(uint64_t memory, uint64_t size, uint32_t typeIndex);
+
+    /**
+     * @brief Forget an allocation; resources still bound to it stop counting against it
+     * @return false if memory is not a live allocation, as on a second free
+     */
+    bool Free(uint64_t memory);
+
+    void AddBuffer(uint64_t buffer, uint64_t size);
+    void AddImage(uint64_t image, uint64_t size);
+    void RemoveBuffer(uint64_t buffer);
+    void RemoveImage(uint64_t image);
+
+    /**
+     * @brief Record a resource bound to memory
+     * @return false if either is unknown or the resource is already bound
+     */
+    bool BindBuffer(uint64_t buffer, uint64_t memory);
+    bool BindImage(uint64_t image, uint64_t memory);
+
+    const TypeUsage& Type(uint32_t typeIndex) const;
+
+    /**
+     * @brief Bytes allocated from a heap, over every memory type in it
+     */
+    VkDeviceSize HeapBytes(const VkPhysicalDeviceMemoryProperties& properties, uint32_t heapIndex) const;
+
+    /**
+     * @brief What a heap may use: the driver's budget when VK_EXT_memory_budget reported one, else the heap's size
+     * @param budget nullptr without the extension
+     * @return 0 for a heap index the device does not have
+     */
+    static VkDeviceSize HeapBudget(const VkPhysicalDeviceMemoryProperties& properties,
+                                   const VkPhysicalDeviceMemoryBudgetPropertiesEXT* budget, uint32_t heapIndex);
+
+    size_t Allocations() const { return allocations_.size(); }
+    size_t Buffers() const { return buffers_.size(); }
+    size_t Images() const { return images_.size(); }
+    uint64_t BufferBytes() const { return bufferBytes_; }
+    uint64_t ImageBytes() const { return imageBytes_; }
+
+private:
+    struct Allocation {
+        uint64_t size;
+        uint32_t typeIndex;
+        uint64_t serial; // Tells a reused handle apart from the allocation a resource was bound to
+        uint64_t bound;
+    };
+
+    struct Resource {
+        uint64_t size;
+        uint64_t memory; // 0 until bound
+        uint64_t serial;
+    };
+
+    bool Bind(HandleMap<Resource>& resources, uint64_t resource, uint64_t memory);
+    void Unbind(const Resource& resource);
+
+    HandleMap<Allocation> allocations_;
+    HandleMap<Resource> buffers_;
+    HandleMap<Resource> images_;
+    TypeUsage types_[VK_MAX_MEMORY_TYPES] = {};
+    uint64_t bufferBytes_ = 0;
+    uint64_t imageBytes_ = 0;
+    uint64_t nextSerial_ = 1;
+};
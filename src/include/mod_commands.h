@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+#include "api.h"
+
+/**
+ * @brief Secondary command buffers mods record their own geometry into
+ *
+ * Mods take a secondary that continues the overlay pass with
+ * ModApi::BeginCommandBuffer, on any thread, and hand it back with
+ * ModApi::SubmitCommandBuffer. Every thread records from its own command pool,
+ * so mods can record in parallel. Buffers submitted while a UI frame is built
+ * are published with it and executed, in submission order and under the UI,
+ * on every present until the next UI frame publishes new ones.
+ */
+namespace ModCommands {
+    /**
+     * @brief Describe the overlay pass secondaries continue; drops everything begun for the last one
+     * @param renderPass VK_NULL_HANDLE when the overlay renders dynamically
+     *
+     * Call once the previous target's frames have all finished.
+     */
+    void OnRenderTarget(VkDevice device, uint32_t queueFamily, VkRenderPass renderPass, VkFormat colorFormat, VkExtent2D extent);
+    void OnDestroyDevice(VkDevice device);
+
+    bool GetRenderTarget(ModRenderTarget& target);
+    VkCommandBuffer Begin();
+    void Submit(VkCommandBuffer commandBuffer);
+
+    /**
+     * @brief Begin one of the layer's own secondaries for the overlay pass
+     */
+    VkResult BeginSecondary(VkCommandBuffer commandBuffer, VkCommandBufferUsageFlags flags);
+
+    /**
+     * @brief Make the buffers submitted since the last UI frame the ones drawn from now on
+     */
+    void Publish();
+
+    /**
+     * @brief Whether the overlay pass has mod secondaries to execute
+     */
+    bool HasCommands();
+
+    /**
+     * @brief Execute the published mod secondaries, then the overlay's own, into the pass
+     * @param frame Overlay frame the primary belongs to, for FrameDone
+     */
+    void Execute(VkCommandBuffer primary, uint32_t frame, VkCommandBuffer overlay);
+
+    /**
+     * @brief The frame's last submit has finished; its mod secondaries may be recorded again
+     */
+    void FrameDone(uint32_t frame);
+} // namespace ModCommands
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+struct ImDrawData;
+
+/**
+ * @brief Offscreen cache of the rendered overlay (FEATURE_OVERLAY_CACHE)
+ *
+ * The ImGui draw data is hashed every frame. Only when it changes is it
+ * rasterized into a persistent image; otherwise the previous result is
+ * blended onto the swapchain image with a single full-screen triangle. The
+ * image holds premultiplied color, which is what ImGui's blend state produces
+ * when drawing onto a cleared target.
+ */
+namespace OverlayCache {
+    /**
+     * @brief How this frame's overlay is drawn
+     */
+    enum Decision {
+        CACHE_BYPASS,  // Render the draw data straight into the swapchain image
+        CACHE_REUSE,   // Composite the cached image, nothing changed
+        CACHE_REFRESH, // Re-render the cache with RecordRefresh, then composite it
+    };
+
+    void OnCreateDevice(const VkPhysicalDeviceMemoryProperties& memoryProperties);
+
+    /**
+     * @brief Create the cache image and composite pipeline for a swapchain
+     * @param overlayPass The overlay's render pass on the swapchain images
+     * @param descriptorPool Pool to allocate the composite descriptor set from
+     * @param extent Size of the swapchain images
+     */
+    bool Create(VkDevice device, VkRenderPass overlayPass, VkDescriptorPool descriptorPool, VkExtent2D extent);
+    void Destroy(VkDevice device);
+
+    /**
+     * @brief Compare this frame's draw data with the cached image
+     */
+    Decision Prepare(ImDrawData* drawData);
+
+    /**
+     * @brief Render the draw data into the cache image
+     * @param cmd Overlay command buffer, recording, outside of a render pass
+     */
+    void RecordRefresh(VkCommandBuffer cmd, ImDrawData* drawData);
+
+    /**
+     * @brief Blend the cache image over the swapchain image
+     * @param cmd Overlay command buffer, inside the overlay render pass
+     */
+    void RecordComposite(VkCommandBuffer cmd);
+
+    /**
+     * @brief Whether the cache image holds the last prepared draw data
+     */
+    bool IsValid();
+
+    /**
+     * @brief Refresh the cache on the next Prepare; for texture contents the draw data hash
+     *        cannot see, such as a new texture published under a reused descriptor set
+     */
+    void Invalidate();
+
+    /**
+     * @brief Counter bumped on every refresh; a command buffer that only composited
+     *        the cache can be submitted again while it is unchanged
+     */
+    uint64_t Generation();
+} // namespace OverlayCache
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+struct ImDrawData;
+
+/**
+ * @brief Sizing of the ImGui backend's per-frame vertex and index buffers
+ *
+ * The backend reallocates a frame's buffers whenever the draw data outgrows
+ * them. The largest vertex and index data the overlay has produced is kept in
+ * a file across runs, and the backend's buffers start out large enough for it
+ * plus headroom, so a large mod window does not reallocate mid-session.
+ */
+namespace OverlayGeometry {
+    /**
+     * @brief Minimum size for each vertex and index buffer, from the saved high-water mark
+     */
+    VkDeviceSize MinAllocationSize();
+
+    /**
+     * @brief Raise the high-water mark to this draw data, saving it off the render thread when it grows
+     */
+    void Track(const ImDrawData* drawData);
+} // namespace OverlayGeometry
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+#include <vk_layer_dispatch_table.h>
+
+/**
+ * @brief The batches that draw the overlay onto one presented image
+ *
+ * The overlay is one batch on the graphics queue. A batch on the present
+ * queue goes before it when the image has to be released to the graphics
+ * family, or when the game passed no semaphores and relies on submission
+ * order on a queue other than ours. An image borrowed from the present family
+ * is acquired back by a third batch on the present queue, which then finishes
+ * the frame in place of the overlay batch.
+ */
+namespace OverlaySubmit {
+    struct Frame {
+        VkQueue presentQueue;
+        VkQueue graphicsQueue;
+        uint32_t gameWaitCount;       // Semaphores the game passed to present, waited on by the first batch
+        const VkSemaphore* gameWaits;
+        bool transfer;                // The image is exclusive to the present family and changes owner
+        VkCommandBuffer overlay;
+        VkCommandBuffer release;      // Only submitted when transferring
+        VkCommandBuffer acquire;
+        VkSemaphore released;         // Signalled by the present queue batch ahead of the overlay
+        VkSemaphore drawn;            // Signalled by the overlay batch
+        VkSemaphore ready;            // Signalled by the acquire batch
+        VkFence fence;                // Signalled by the frame's last batch
+        VkSemaphore timeline;         // Signalled to timelineValue by the last batch, VK_NULL_HANDLE if not used
+        uint64_t timelineValue;
+    };
+
+    /**
+     * @brief Submit a frame's batches in order through the next layer
+     * @param presentWait Set to the semaphore present has to wait on for this image
+     * @param overlaySubmitted Set once the overlay batch is queued, even if a later submit fails
+     * @return The result of the first submit that failed
+     */
+    VkResult Submit(const VkLayerDispatchTable& dispatch, const Frame& frame, VkSemaphore& presentWait, bool& overlaySubmitted);
+} // namespace OverlaySubmit
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "api.h"
+
+/**
+ * @brief Named pointer chains into Sky.exe, resolved once per frame for every mod
+ *
+ * Paths are declared like an LM_DeepPointer chain: the pointer at
+ * skyBase + baseOffset is read, then each offset but the last is added and
+ * the pointer there read in turn; the snapshot is read at the last pointer
+ * plus the last offset. Paths with the same prefix share its nodes, and a
+ * node only reads its pointer again when its parent's pointer changed, so a
+ * stable chain costs one read for the root and one for the value per frame.
+ * Memory is read with ReadProcessMemory, so a broken chain fails instead of
+ * faulting.
+ */
+namespace PointerPaths {
+    /**
+     * @brief Register a path, or get the existing one registered under name
+     * @return nullptr if name is already registered with a different chain or size
+     */
+    ModPointerPath* Register(const std::string& name, uintptr_t baseOffset, const std::vector<uintptr_t>& offsets, size_t size);
+    ModPointerPath* Find(const std::string& name);
+
+    /**
+     * @brief Resolve every path and read its snapshot; called on every present, before the UI tick
+     */
+    void Resolve();
+
+    /**
+     * @brief The snapshot of the last Resolve, valid until the next one
+     * @return nullptr if the chain did not resolve or size does not match
+     */
+    const void* Get(ModPointerPath* path, size_t size);
+} // namespace PointerPaths
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Compile-time perfect hashing of Vulkan entry-point names
+ *
+ * Names are hashed once with FNV-1a, spread over buckets, and every bucket gets
+ * a seed that places all of its keys into distinct slots (hash and displace).
+ * A lookup is therefore one hash, one mix and a single string compare, no
+ * matter how many entry points the layer intercepts.
+ */
+namespace proc_table {
+
+/**
+ * @brief Static description of one intercepted entry point
+ */
+struct ProcName {
+    const char* name;
+    uint32_t features; // LayerFeature bits, any of which enables it; FEATURE_NONE always does
+    uint32_t scopes;   // Which GetProcAddr lookups may return it
+};
+
+constexpr uint32_t Hash(const char* str) {
+    uint32_t hash = 2166136261u;
+    for (; *str; ++str) {
+        hash ^= static_cast<uint8_t>(*str);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr uint32_t Mix(uint32_t hash, uint32_t seed) {
+    hash ^= seed;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+constexpr bool StrEqual(const char* a, const char* b) {
+    while (*a && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+template <size_t N>
+class PerfectHash {
+    static_assert(N > 0 && N < 0xFFFF, "Unsupported entry point count");
+
+    static constexpr size_t kBuckets = std::bit_ceil(N);
+    static constexpr size_t kSlots = std::bit_ceil(N * 2);
+    static constexpr uint16_t kEmpty = 0xFFFF;
+    static constexpr uint32_t kMaxSeed = 1u << 16;
+    static constexpr size_t kMaxBucketSize = 16;
+
+    std::array<ProcName, N> names_{};
+    std::array<uint32_t, kBuckets> seeds_{};
+    std::array<uint16_t, kSlots> slots_{};
+
+public:
+    constexpr explicit PerfectHash(const std::array<ProcName, N>& names) : names_(names) {
+        std::array<uint32_t, N> hashes{};
+        std::array<uint16_t, kBuckets + 1> first{};
+        std::array<uint16_t, N> members{};
+
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = Hash(names[i].name);
+            ++first[(hashes[i] & (kBuckets - 1)) + 1];
+        }
+
+        // Group key indices by bucket so every placement attempt only touches its own keys
+        size_t largest = 0;
+        for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            const size_t size = first[bucket + 1];
+            largest = size > largest ? size : largest;
+            first[bucket + 1] = static_cast<uint16_t>(first[bucket] + size);
+        }
+        if (largest > kMaxBucketSize) {
+            throw "Entry point bucket too large";
+        }
+
+        std::array<uint16_t, kBuckets> fill{};
+        for (size_t i = 0; i < N; ++i) {
+            const size_t bucket = hashes[i] & (kBuckets - 1);
+            for (size_t j = first[bucket]; j < first[bucket] + fill[bucket]; ++j) {
+                if (hashes[members[j]] == hashes[i]) {
+                    throw "Duplicate or colliding entry point name";
+                }
+            }
+            members[first[bucket] + fill[bucket]++] = static_cast<uint16_t>(i);
+        }
+
+        slots_.fill(kEmpty);
+
+        // Place the most crowded buckets first while the table is still sparse
+        for (size_t size = largest; size > 0; --size) {
+            for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+                if (static_cast<size_t>(first[bucket + 1] - first[bucket]) != size) {
+                    continue;
+                }
+
+                for (uint32_t seed = 1;; ++seed) {
+                    if (seed == kMaxSeed) {
+                        throw "Failed to find a perfect hash seed";
+                    }
+                    if (TryPlace(hashes, &members[first[bucket]], size, seed)) {
+                        seeds_[bucket] = seed;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Find the table index of an entry point
+     * @param name Entry point name, e.g. "vkQueuePresentKHR"
+     * @return Index into the names array or -1 when the name is not in the table
+     */
+    constexpr int Find(const char* name) const {
+        const uint32_t hash = Hash(name);
+        const uint16_t index = slots_[Mix(hash, seeds_[hash & (kBuckets - 1)]) & (kSlots - 1)];
+        if (index == kEmpty || !StrEqual(names_[index].name, name)) {
+            return -1;
+        }
+        return index;
+    }
+
+    constexpr const ProcName& operator[](size_t index) const {
+        return names_[index];
+    }
+
+    static constexpr size_t size() {
+        return N;
+    }
+
+private:
+    constexpr bool TryPlace(const std::array<uint32_t, N>& hashes, const uint16_t* keys, size_t count, uint32_t seed) {
+        std::array<size_t, kMaxBucketSize> placed{};
+
+        for (size_t i = 0; i < count; ++i) {
+            const size_t slot = Mix(hashes[keys[i]], seed) & (kSlots - 1);
+            if (slots_[slot] != kEmpty) {
+                // Roll back the keys of this bucket placed so far
+                for (size_t j = 0; j < i; ++j) {
+                    slots_[placed[j]] = kEmpty;
+                }
+                return false;
+            }
+            slots_[slot] = keys[i];
+            placed[i] = slot;
+        }
+        return true;
+    }
+};
+
+} // namespace proc_table
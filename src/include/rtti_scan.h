@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Finds the vtables of an x64 MSVC image through its RTTI
+ *
+ * Every polymorphic class compiled with RTTI has a Complete Object Locator in
+ * .rdata, referenced by the slot just before each of its vtables. The locator
+ * leads to the class's Type Descriptor (its decorated name) and Class
+ * Hierarchy Descriptor (its base classes). Platform independent: works on the
+ * mapped image in-process or on a recording of one.
+ */
+namespace RttiScan {
+    struct Section {
+        std::string name;
+        uint32_t rva;
+        uint32_t size;
+        bool executable;
+    };
+
+    /**
+     * @brief An image laid out as mapped: data[rva] is the byte at base + rva
+     */
+    struct Image {
+        uintptr_t base;
+        const uint8_t* data;
+        size_t size;
+        std::vector<Section> sections;
+    };
+
+    struct ClassInfo {
+        std::string name;      // "class Foo::Bar", or the decorated name when it cannot be simplified
+        std::string decorated; // ".?AVBar@Foo@@"
+        uint32_t vtable;       // RVA of the first virtual function slot
+        uint32_t offset;       // Of the subobject the vtable belongs to, 0 for the primary vtable
+        uint32_t slots;        // Consecutive entries that point into executable sections
+        std::vector<std::string> bases; // Base classes by name, as listed in the hierarchy descriptor
+    };
+
+    /**
+     * @brief Read the section table from the PE headers at the start of an image
+     * @return false if the headers are not those of a PE32+ image
+     */
+    bool ReadSections(const uint8_t* data, size_t size, std::vector<Section>& sections);
+
+    /**
+     * @brief Hash of the PE headers, which change with every build of the image
+     */
+    uint64_t HashHeaders(const uint8_t* data, size_t size);
+
+    /**
+     * @brief ".?AVBar@Foo@@" to "class Foo::Bar"; templates and other complex names are returned as is
+     */
+    std::string Demangle(const std::string& decorated);
+
+    std::vector<ClassInfo> Scan(const Image& image);
+} // namespace RttiScan
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Attribution of sampled call stacks to loaded modules
+ *
+ * Platform independent so it can be fed synthetic samples; Sampler supplies
+ * the real stacks and module list on Windows.
+ */
+namespace SampleProfile {
+    struct ModuleRange {
+        uintptr_t base;
+        uintptr_t end; // One past the last byte
+        std::string name;
+    };
+
+    /**
+     * @brief Sorted, non-overlapping module ranges searched by address
+     */
+    class ModuleMap {
+    public:
+        void Assign(std::vector<ModuleRange> ranges);
+
+        /**
+         * @return Index of the module containing address, or -1
+         */
+        int Find(uintptr_t address) const;
+
+        const ModuleRange& At(int index) const { return ranges_[index]; }
+        size_t Size() const { return ranges_.size(); }
+
+        /**
+         * @brief Format an address as "module+0xoffset", or as a bare address outside every module
+         */
+        std::string Symbolize(uintptr_t address) const;
+
+    private:
+        std::vector<ModuleRange> ranges_;
+    };
+
+    /**
+     * @brief One x64 RUNTIME_FUNCTION: the code range of a function and the RVA of its unwind data
+     */
+    struct FunctionEntry {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t unwind;
+    };
+
+    /**
+     * @brief A mapped image's .pdata, searched without the loader's function table locks
+     */
+    class FunctionTable {
+    public:
+        /**
+         * @brief Use the exception directory of a mapped PE32+ image
+         * @return false if the image has none, which leaves the table empty
+         */
+        bool Assign(const uint8_t* image, size_t size);
+
+        /**
+         * @brief The entry whose function contains rva, after following an indirect entry
+         * @return nullptr for a leaf function, which has no unwind data
+         */
+        const FunctionEntry* Find(uint32_t rva) const;
+
+        size_t Size() const { return count_; }
+
+    private:
+        const uint8_t* image_ = nullptr;
+        size_t size_ = 0;
+        const FunctionEntry* entries_ = nullptr;
+        size_t count_ = 0;
+    };
+
+    struct ModuleShare {
+        std::string name;
+        uint64_t self;      // Samples whose instruction pointer was in the module
+        uint64_t inclusive; // Samples with the module anywhere on the stack
+    };
+
+    struct HotAddress {
+        std::string symbol;
+        uint64_t samples;
+    };
+
+    struct Report {
+        uint64_t samples = 0;
+        uint64_t unknown = 0; // Instruction pointer outside every module, e.g. generated code
+        std::vector<ModuleShare> modules; // By self samples, highest first
+        std::vector<HotAddress> hottest;  // Most sampled instruction pointers
+    };
+
+    /**
+     * @brief Per-module sample counts of one thread
+     *
+     * Counts are keyed by module name so they survive a rebuilt ModuleMap.
+     */
+    class Aggregator {
+    public:
+        /**
+         * @param frames Instruction pointer first, then return addresses
+         */
+        void Add(const ModuleMap& modules, const uintptr_t* frames, size_t count);
+
+        /**
+         * @param hottest Number of hot addresses to keep in the report
+         */
+        Report Build(const ModuleMap& modules, size_t hottest) const;
+
+        void Reset();
+        uint64_t Samples() const { return samples_; }
+
+    private:
+        struct Counts {
+            uint64_t self = 0;
+            uint64_t inclusive = 0;
+        };
+
+        std::unordered_map<std::string, Counts> modules_;
+        std::unordered_map<uintptr_t, uint64_t> addresses_;
+        uint64_t samples_ = 0;
+        uint64_t unknown_ = 0;
+    };
+} // namespace SampleProfile
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <windows.h>
+
+/**
+ * @brief Optional sampling profiler for the game's threads (FEATURE_SAMPLER)
+ *
+ * A background thread periodically suspends every watched thread, copies its
+ * registers and the top of its stack, and unwinds a few frames from the copy
+ * once the thread runs again. Samples are attributed to the loaded modules
+ * with SampleProfile. The overlay shows the share of
+ * samples per module, so time spent in Sky.exe, the loader or a mod's detour
+ * can be told apart.
+ */
+namespace Sampler {
+    void Start();
+
+    /**
+     * @brief Sample a thread from now on; only its first role is kept
+     */
+    void WatchThread(DWORD threadId, const char* role);
+
+    /**
+     * @brief WatchThread for the calling thread; after the first call, a thread-local check
+     */
+    void WatchCurrentThread(const char* role);
+
+    /**
+     * @brief Label a mod's module with its name in the report
+     */
+    void NameModule(HMODULE module, const std::string& name);
+    void ForgetModule(HMODULE module);
+
+    void RenderOverlay();
+} // namespace Sampler
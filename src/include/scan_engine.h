@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Value scanner over memory regions, in the style of external memory scanners
+ *
+ * The first scan compares whole regions with AVX2 kernels (scalar when the
+ * CPU lacks AVX2) in parallel on the shared thread pool.
+ * Hits are kept per chunk as a bitmap or as delta-encoded slot indices,
+ * whichever is smaller, so common values do not cost a pointer per hit. Later
+ * scans narrow the hits by comparing against the previous values. Platform
+ * independent: the caller provides the regions and, optionally, a guard that
+ * catches faults when a region goes away mid-scan.
+ */
+namespace ScanEngine {
+    enum ValueType : uint32_t {
+        VALUE_INT32, // 4-byte aligned
+        VALUE_FLOAT, // 4-byte aligned
+        VALUE_BYTES, // Any alignment
+    };
+
+    enum Condition : uint32_t {
+        CONDITION_EQUAL,     // Equal to the query value
+        CONDITION_CHANGED,   // Different from the last scan
+        CONDITION_UNCHANGED,
+        CONDITION_INCREASED, // Numeric types only
+        CONDITION_DECREASED, // Numeric types only
+    };
+
+    struct Query {
+        ValueType type = VALUE_INT32;
+        std::vector<uint8_t> value; // 4 bytes for numeric types, the pattern for VALUE_BYTES
+        float tolerance = 0.0f;     // Floats this close count as equal
+    };
+
+    struct Region {
+        uintptr_t base;
+        size_t size;
+    };
+
+    /**
+     * @brief Run body(context) and return false if it faulted
+     */
+    using Guard = bool (*)(void (*body)(void* context), void* context);
+
+    /**
+     * @brief Hits within one chunk of a scanned region
+     */
+    struct ChunkHits {
+        uintptr_t base;
+        uint32_t slots;  // Candidate positions, one per alignment step
+        uint32_t count;
+        bool bitmap;     // encoded is one bit per slot rather than LEB128 slot deltas
+        std::vector<uint8_t> encoded;
+        std::vector<uint8_t> values; // count values, empty while every hit holds Query::value
+    };
+
+    struct ResultSet {
+        Query query; // Its value is the value of every hit while ChunkHits::values are empty
+        std::vector<ChunkHits> chunks;
+        uint64_t count = 0;
+        uint64_t bytesScanned = 0;
+        uint32_t faults = 0; // Chunks dropped because their memory went away
+    };
+
+    size_t ValueSize(const Query& query);
+
+    /**
+     * @brief Whether first scans run the AVX2 kernels
+     */
+    bool HasAVX2();
+
+    /**
+     * @brief Run the scalar kernels even on a CPU with AVX2, to compare the two
+     */
+    void ForceScalar(bool scalar);
+
+    /**
+     * @brief Scan regions for query's value
+     * @return nullptr if the query is malformed
+     */
+    std::unique_ptr<ResultSet> First(const std::vector<Region>& regions, const Query& query, Guard guard = nullptr);
+
+    /**
+     * @brief Keep the hits that meet condition now
+     * @param value Compared against for CONDITION_EQUAL, same size as the first query's
+     * @return false if the condition does not apply to the value type
+     */
+    bool Next(ResultSet& results, Condition condition, const std::vector<uint8_t>& value = {}, Guard guard = nullptr);
+
+    /**
+     * @brief Visit hits in address order until visit returns false
+     */
+    void ForEach(const ResultSet& results, const std::function<bool(uintptr_t address, const uint8_t* value)>& visit);
+
+    /**
+     * @brief Memory held by the hit encodings and stored values
+     */
+    size_t Footprint(const ResultSet& results);
+} // namespace ScanEngine
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+/**
+ * @brief Loader statistics published in a named shared-memory segment (FEATURE_METRICS)
+ *
+ * The block is rewritten once per present under a sequence lock, so external
+ * tools can map it and read it at any rate without calling into the game. The
+ * layout is shared with tools/tsml_metrics.cpp; any change to it bumps kVersion.
+ */
+namespace SharedMetrics {
+    constexpr const char* kSegmentName = "Local\\TSML_Metrics";
+    constexpr uint32_t kMagic = 0x4D4D5354; // "TSMM"
+    constexpr uint32_t kVersion = 1;
+    constexpr uint32_t kMaxMods = 32;
+
+    struct ModMetrics {
+        char name[48];
+        uint64_t renders;     // Calls to the mod's Render
+        float renderUs;       // Last Render call
+        float renderUsAverage;
+    };
+
+    /**
+     * @brief The shared segment
+     *
+     * sequence is odd while the loader writes. Readers copy the block, then
+     * check that sequence was even and unchanged across the copy.
+     */
+    struct Block {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size; // sizeof(Block)
+        uint32_t processId;
+        std::atomic<uint64_t> sequence;
+
+        uint64_t presents;
+        uint64_t timeUs;          // steady_clock time of the last update
+        float frameMs;
+        float frameMsAverage;     // Over the last second
+        float frameMsMax;         // Over the last second
+        float overlayMs;          // CPU time of the layer's present path, 0 without the overlay
+
+        uint64_t windowMessages;  // Seen by the window hook
+        uint64_t logLines;
+        float logLinesPerSecond;
+
+        // Intercepted Vulkan work of the last frame, only counted with FEATURE_DRAWSTATS
+        uint32_t draws;
+        uint32_t dispatches;
+        uint32_t submits;
+
+        uint32_t modCount;
+        ModMetrics mods[kMaxMods];
+    };
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The sequence must work across processes");
+
+    /**
+     * @brief Mark the block as being written; readers retry until EndWrite
+     * @return The odd sequence to pass to EndWrite
+     *
+     * Also recovers a block left mid-write by a loader that exited, since the
+     * sequence is made odd rather than incremented.
+     */
+    inline uint64_t BeginWrite(Block& block) {
+        const uint64_t writing = block.sequence.load(std::memory_order_relaxed) | 1;
+        block.sequence.store(writing, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return writing;
+    }
+
+    inline void EndWrite(Block& block, uint64_t writing) {
+        block.sequence.store(writing + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy the block once the loader is not writing it
+     * @return false if the loader kept writing for every attempt
+     */
+    inline bool Snapshot(const Block& shared, Block& copy, int attempts = 100) {
+        for (int attempt = 0; attempt < attempts; ++attempt) {
+            const uint64_t before = shared.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            memcpy(static_cast<void*>(&copy), &shared, sizeof(Block));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (shared.sequence.load(std::memory_order_relaxed) == before) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+#ifndef TSML_METRICS_READER
+    void Init();
+
+    /**
+     * @brief Publish the block; called once per present on the render thread
+     * @param overlayMs CPU time the layer spent presenting this frame
+     */
+    void EndFrame(float overlayMs);
+
+    void RecordModRender(int index, const char* name, float renderUs);
+    void CountWindowMessage();
+    void CountLogLine();
+#endif
+} // namespace SharedMetrics
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vulkan/vulkan.h>
+
+/**
+ * @brief Persistently mapped ring buffer for the layer's uploads to the game's device
+ *
+ * Uploads take aligned space from one host-coherent buffer and record their
+ * copies into the frame's batch command buffer. The batch goes out in a
+ * single submit per present, and its fence hands the space back once the
+ * GPU has finished with it, so uploads neither allocate memory nor wait.
+ */
+namespace StagingRing {
+    /**
+     * @param copyAlignment VkPhysicalDeviceLimits::optimalBufferCopyOffsetAlignment
+     */
+    void OnCreateDevice(const VkPhysicalDeviceMemoryProperties& memoryProperties, VkDeviceSize copyAlignment);
+    void OnDestroyDevice(VkDevice device);
+
+    /**
+     * @brief Create the ring on first use and reclaim the space of finished batches
+     * @param queueFamily Family of the queue batches are submitted to
+     * @return false when the ring is not available
+     */
+    bool BeginFrame(VkDevice device, uint32_t queueFamily);
+
+    /**
+     * @brief Reserve space in this frame's batch
+     * @param offset Set to the offset of the space in Buffer()
+     * @return Mapped pointer to the space, or nullptr when the ring has no room this frame
+     */
+    void* Allocate(VkDeviceSize size, VkDeviceSize& offset);
+
+    VkBuffer Buffer();
+    VkDeviceSize Capacity();
+
+    /**
+     * @brief This frame's batch command buffer, begun on first use
+     * @return VK_NULL_HANDLE if it could not be created
+     */
+    VkCommandBuffer Commands();
+
+    /**
+     * @brief Serial the batch being recorded will complete as
+     */
+    uint64_t PendingSerial();
+
+    /**
+     * @brief Submit this frame's batch, if anything was recorded
+     */
+    VkResult Submit(VkQueue queue);
+
+    /**
+     * @brief Whether the batch with this serial has finished on the GPU, as of the last BeginFrame
+     */
+    bool IsComplete(uint64_t serial);
+
+    /**
+     * @brief Whether the batch with this serial failed to submit; its copies never happen
+     *
+     * A failure is forgotten at the BeginFrame after it was first reported,
+     * so every upload of the batch has to be checked in the same frame.
+     */
+    bool IsFailed(uint64_t serial);
+} // namespace StagingRing
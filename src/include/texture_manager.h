@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <vulkan/vulkan.h>
+
+struct ModTexture;
+
+/**
+ * @brief Images mods load for the overlay through ModApi::LoadTextureAsync
+ *
+ * Files are decoded with stb_image on the shared thread pool. Update, called
+ * on the render thread once per present, stages decoded images in the
+ * StagingRing batch and publishes them as ImGui texture IDs when the batch
+ * has finished, so neither the mod nor the present path waits for a load.
+ * Textures are refcounted by path. While the loaded textures exceed the budget from the "overlay" settings,
+ * the least recently drawn ones give their memory back and are loaded again
+ * the next time a mod asks for them.
+ */
+namespace TextureManager {
+    void OnCreateDevice(const VkPhysicalDeviceMemoryProperties& memoryProperties);
+    void OnDestroyDevice(VkDevice device);
+
+    /**
+     * @brief Take a reference to the texture for an image file, starting the load if needed
+     */
+    ModTexture* Load(const std::string& path);
+    void Release(ModTexture* texture);
+
+    /**
+     * @brief ImTextureID of a texture, marking it as drawn this frame
+     * @param width Set to the image width when not nullptr
+     * @param height Set to the image height when not nullptr
+     * @return nullptr until the texture is ready
+     */
+    void* GetId(ModTexture* texture, uint32_t* width, uint32_t* height);
+
+    /**
+     * @brief Upload decoded images, publish finished uploads and enforce the budget
+     * @param device The game's device
+     *
+     * Call between StagingRing::BeginFrame and StagingRing::Submit.
+     */
+    void Update(VkDevice device);
+
+    /**
+     * @brief Note that the UI is rebuilt; textures not asked for again drop out of the draw data
+     */
+    void BeginUiFrame();
+} // namespace TextureManager
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Per-thread counter blocks that are written without locks
+ *
+ * Every thread lazily registers one block of N counters and is its only writer,
+ * so an increment is a relaxed load and store with no lock prefix. Readers sum
+ * all blocks; the registry mutex is only taken when a thread first registers
+ * and while summing, never on the hot path. Blocks outlive their threads so the
+ * totals of exited threads are kept.
+ *
+ * @tparam Tag Distinguishes independent counter sets of the same size
+ * @tparam N Number of counters per thread
+ */
+template <typename Tag, size_t N>
+class ThreadCounters {
+public:
+    struct Block {
+        std::atomic<uint64_t> values[N] = {};
+
+        void Add(size_t index, uint64_t amount) {
+            values[index].store(values[index].load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief Get the calling thread's block, registering it on first use
+     */
+    static Block& Local() {
+        thread_local Block* block = Register();
+        return *block;
+    }
+
+    static void Add(size_t index, uint64_t amount = 1) {
+        Local().Add(index, amount);
+    }
+
+    /**
+     * @brief Sum the counters of every thread that ever registered
+     * @param totals Receives N running totals
+     */
+    static void Sum(uint64_t (&totals)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            totals[i] = 0;
+        }
+
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        for (const std::unique_ptr<Block>& block : Registry()) {
+            for (size_t i = 0; i < N; ++i) {
+                totals[i] += block->values[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    static Block* Register() {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        Registry().push_back(std::make_unique<Block>());
+        return Registry().back().get();
+    }
+
+    static std::vector<std::unique_ptr<Block>>& Registry() {
+        static std::vector<std::unique_ptr<Block>> blocks;
+        return blocks;
+    }
+
+    static std::mutex& RegistryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads for CPU-heavy layer work off the render thread
+ *
+ * Tasks run in submission order on whichever worker is free. ParallelFor lets
+ * the calling thread take part, so it is safe to call from a pool task too.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Number of workers; 0 picks one less than the core count
+     */
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> task);
+
+    /**
+     * @brief Run body(0) .. body(count - 1) across the pool and wait for all of them
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * @brief Process-wide pool, started on first use
+     */
+    static ThreadPool& Shared();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Timeline of loader and frame activity, exported as Chrome trace_event JSON
+ *
+ * TSML_TRACE_SCOPE marks a block as one complete event. Every thread appends
+ * its events to its own fixed buffer without locks; the buffers are written
+ * out when tracing is toggled off with the "trace" hotkey, or when the loader
+ * is unloaded. A trace still running when the process exits is lost. Open the
+ * file in chrome://tracing or ui.perfetto.dev. While tracing is off a scope
+ * costs one relaxed load and a branch.
+ */
+namespace Trace {
+    extern std::atomic<bool> enabled;
+
+    inline bool IsEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Now();
+
+    /**
+     * @brief Record an event that started at start and ends now
+     * @param name String literal, stored by pointer
+     * @param detail Copied; shown as the event's "detail" argument when not nullptr
+     */
+    void Complete(const char* name, uint64_t start, const char* detail = nullptr);
+
+    void Start();
+
+    /**
+     * @brief Stop tracing and write everything recorded since Start
+     */
+    void Stop();
+    void Toggle();
+
+    /**
+     * @brief Write out a trace still running when the loader is unloaded, on the calling thread
+     *
+     * Not called at process exit, when other threads may have died holding the locks it takes.
+     */
+    void Shutdown();
+
+    class Scope {
+    public:
+        explicit Scope(const char* name, const char* detail = nullptr) {
+            if (IsEnabled()) {
+                name_ = name;
+                detail_ = detail;
+                start_ = Now();
+            }
+        }
+
+        ~Scope() {
+            if (name_) Complete(name_, start_, detail_);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name_ = nullptr;
+        const char* detail_ = nullptr;
+        uint64_t start_ = 0;
+    };
+} // namespace Trace
+
+#define TSML_TRACE_CONCAT_INNER(a, b) a##b
+#define TSML_TRACE_CONCAT(a, b) TSML_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Trace the rest of the enclosing block; the optional detail must outlive the block
+ */
+#define TSML_TRACE_SCOPE(...) Trace::Scope TSML_TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,966 @@
+// Generated from include/vk_layer_dispatch_table.h: one entry per VkLayerDispatchTable member.
+// Define VK_DEVICE_ENTRYPOINT(name) before including this file; it is undefined again at the end.
+// No include guard on purpose, the list is expanded several times.
+
+// ---- Core Vulkan 1.0 commands
+VK_DEVICE_ENTRYPOINT(GetDeviceProcAddr)
+VK_DEVICE_ENTRYPOINT(DestroyDevice)
+VK_DEVICE_ENTRYPOINT(GetDeviceQueue)
+VK_DEVICE_ENTRYPOINT(QueueSubmit)
+VK_DEVICE_ENTRYPOINT(QueueWaitIdle)
+VK_DEVICE_ENTRYPOINT(DeviceWaitIdle)
+VK_DEVICE_ENTRYPOINT(AllocateMemory)
+VK_DEVICE_ENTRYPOINT(FreeMemory)
+VK_DEVICE_ENTRYPOINT(MapMemory)
+VK_DEVICE_ENTRYPOINT(UnmapMemory)
+VK_DEVICE_ENTRYPOINT(FlushMappedMemoryRanges)
+VK_DEVICE_ENTRYPOINT(InvalidateMappedMemoryRanges)
+VK_DEVICE_ENTRYPOINT(GetDeviceMemoryCommitment)
+VK_DEVICE_ENTRYPOINT(BindBufferMemory)
+VK_DEVICE_ENTRYPOINT(BindImageMemory)
+VK_DEVICE_ENTRYPOINT(GetBufferMemoryRequirements)
+VK_DEVICE_ENTRYPOINT(GetImageMemoryRequirements)
+VK_DEVICE_ENTRYPOINT(GetImageSparseMemoryRequirements)
+VK_DEVICE_ENTRYPOINT(QueueBindSparse)
+VK_DEVICE_ENTRYPOINT(CreateFence)
+VK_DEVICE_ENTRYPOINT(DestroyFence)
+VK_DEVICE_ENTRYPOINT(ResetFences)
+VK_DEVICE_ENTRYPOINT(GetFenceStatus)
+VK_DEVICE_ENTRYPOINT(WaitForFences)
+VK_DEVICE_ENTRYPOINT(CreateSemaphore)
+VK_DEVICE_ENTRYPOINT(DestroySemaphore)
+VK_DEVICE_ENTRYPOINT(CreateEvent)
+VK_DEVICE_ENTRYPOINT(DestroyEvent)
+VK_DEVICE_ENTRYPOINT(GetEventStatus)
+VK_DEVICE_ENTRYPOINT(SetEvent)
+VK_DEVICE_ENTRYPOINT(ResetEvent)
+VK_DEVICE_ENTRYPOINT(CreateQueryPool)
+VK_DEVICE_ENTRYPOINT(DestroyQueryPool)
+VK_DEVICE_ENTRYPOINT(GetQueryPoolResults)
+VK_DEVICE_ENTRYPOINT(CreateBuffer)
+VK_DEVICE_ENTRYPOINT(DestroyBuffer)
+VK_DEVICE_ENTRYPOINT(CreateBufferView)
+VK_DEVICE_ENTRYPOINT(DestroyBufferView)
+VK_DEVICE_ENTRYPOINT(CreateImage)
+VK_DEVICE_ENTRYPOINT(DestroyImage)
+VK_DEVICE_ENTRYPOINT(GetImageSubresourceLayout)
+VK_DEVICE_ENTRYPOINT(CreateImageView)
+VK_DEVICE_ENTRYPOINT(DestroyImageView)
+VK_DEVICE_ENTRYPOINT(CreateShaderModule)
+VK_DEVICE_ENTRYPOINT(DestroyShaderModule)
+VK_DEVICE_ENTRYPOINT(CreatePipelineCache)
+VK_DEVICE_ENTRYPOINT(DestroyPipelineCache)
+VK_DEVICE_ENTRYPOINT(GetPipelineCacheData)
+VK_DEVICE_ENTRYPOINT(MergePipelineCaches)
+VK_DEVICE_ENTRYPOINT(CreateGraphicsPipelines)
+VK_DEVICE_ENTRYPOINT(CreateComputePipelines)
+VK_DEVICE_ENTRYPOINT(DestroyPipeline)
+VK_DEVICE_ENTRYPOINT(CreatePipelineLayout)
+VK_DEVICE_ENTRYPOINT(DestroyPipelineLayout)
+VK_DEVICE_ENTRYPOINT(CreateSampler)
+VK_DEVICE_ENTRYPOINT(DestroySampler)
+VK_DEVICE_ENTRYPOINT(CreateDescriptorSetLayout)
+VK_DEVICE_ENTRYPOINT(DestroyDescriptorSetLayout)
+VK_DEVICE_ENTRYPOINT(CreateDescriptorPool)
+VK_DEVICE_ENTRYPOINT(DestroyDescriptorPool)
+VK_DEVICE_ENTRYPOINT(ResetDescriptorPool)
+VK_DEVICE_ENTRYPOINT(AllocateDescriptorSets)
+VK_DEVICE_ENTRYPOINT(FreeDescriptorSets)
+VK_DEVICE_ENTRYPOINT(UpdateDescriptorSets)
+VK_DEVICE_ENTRYPOINT(CreateFramebuffer)
+VK_DEVICE_ENTRYPOINT(DestroyFramebuffer)
+VK_DEVICE_ENTRYPOINT(CreateRenderPass)
+VK_DEVICE_ENTRYPOINT(DestroyRenderPass)
+VK_DEVICE_ENTRYPOINT(GetRenderAreaGranularity)
+VK_DEVICE_ENTRYPOINT(CreateCommandPool)
+VK_DEVICE_ENTRYPOINT(DestroyCommandPool)
+VK_DEVICE_ENTRYPOINT(ResetCommandPool)
+VK_DEVICE_ENTRYPOINT(AllocateCommandBuffers)
+VK_DEVICE_ENTRYPOINT(FreeCommandBuffers)
+VK_DEVICE_ENTRYPOINT(BeginCommandBuffer)
+VK_DEVICE_ENTRYPOINT(EndCommandBuffer)
+VK_DEVICE_ENTRYPOINT(ResetCommandBuffer)
+VK_DEVICE_ENTRYPOINT(CmdBindPipeline)
+VK_DEVICE_ENTRYPOINT(CmdSetViewport)
+VK_DEVICE_ENTRYPOINT(CmdSetScissor)
+VK_DEVICE_ENTRYPOINT(CmdSetLineWidth)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBias)
+VK_DEVICE_ENTRYPOINT(CmdSetBlendConstants)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBounds)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilCompareMask)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilWriteMask)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilReference)
+VK_DEVICE_ENTRYPOINT(CmdBindDescriptorSets)
+VK_DEVICE_ENTRYPOINT(CmdBindIndexBuffer)
+VK_DEVICE_ENTRYPOINT(CmdBindVertexBuffers)
+VK_DEVICE_ENTRYPOINT(CmdDraw)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndexed)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndirect)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndexedIndirect)
+VK_DEVICE_ENTRYPOINT(CmdDispatch)
+VK_DEVICE_ENTRYPOINT(CmdDispatchIndirect)
+VK_DEVICE_ENTRYPOINT(CmdCopyBuffer)
+VK_DEVICE_ENTRYPOINT(CmdCopyImage)
+VK_DEVICE_ENTRYPOINT(CmdBlitImage)
+VK_DEVICE_ENTRYPOINT(CmdCopyBufferToImage)
+VK_DEVICE_ENTRYPOINT(CmdCopyImageToBuffer)
+VK_DEVICE_ENTRYPOINT(CmdUpdateBuffer)
+VK_DEVICE_ENTRYPOINT(CmdFillBuffer)
+VK_DEVICE_ENTRYPOINT(CmdClearColorImage)
+VK_DEVICE_ENTRYPOINT(CmdClearDepthStencilImage)
+VK_DEVICE_ENTRYPOINT(CmdClearAttachments)
+VK_DEVICE_ENTRYPOINT(CmdResolveImage)
+VK_DEVICE_ENTRYPOINT(CmdSetEvent)
+VK_DEVICE_ENTRYPOINT(CmdResetEvent)
+VK_DEVICE_ENTRYPOINT(CmdWaitEvents)
+VK_DEVICE_ENTRYPOINT(CmdPipelineBarrier)
+VK_DEVICE_ENTRYPOINT(CmdBeginQuery)
+VK_DEVICE_ENTRYPOINT(CmdEndQuery)
+VK_DEVICE_ENTRYPOINT(CmdResetQueryPool)
+VK_DEVICE_ENTRYPOINT(CmdWriteTimestamp)
+VK_DEVICE_ENTRYPOINT(CmdCopyQueryPoolResults)
+VK_DEVICE_ENTRYPOINT(CmdPushConstants)
+VK_DEVICE_ENTRYPOINT(CmdBeginRenderPass)
+VK_DEVICE_ENTRYPOINT(CmdNextSubpass)
+VK_DEVICE_ENTRYPOINT(CmdEndRenderPass)
+VK_DEVICE_ENTRYPOINT(CmdExecuteCommands)
+
+// ---- Core Vulkan 1.1 commands
+VK_DEVICE_ENTRYPOINT(BindBufferMemory2)
+VK_DEVICE_ENTRYPOINT(BindImageMemory2)
+VK_DEVICE_ENTRYPOINT(GetDeviceGroupPeerMemoryFeatures)
+VK_DEVICE_ENTRYPOINT(CmdSetDeviceMask)
+VK_DEVICE_ENTRYPOINT(CmdDispatchBase)
+VK_DEVICE_ENTRYPOINT(GetImageMemoryRequirements2)
+VK_DEVICE_ENTRYPOINT(GetBufferMemoryRequirements2)
+VK_DEVICE_ENTRYPOINT(GetImageSparseMemoryRequirements2)
+VK_DEVICE_ENTRYPOINT(TrimCommandPool)
+VK_DEVICE_ENTRYPOINT(GetDeviceQueue2)
+VK_DEVICE_ENTRYPOINT(CreateSamplerYcbcrConversion)
+VK_DEVICE_ENTRYPOINT(DestroySamplerYcbcrConversion)
+VK_DEVICE_ENTRYPOINT(CreateDescriptorUpdateTemplate)
+VK_DEVICE_ENTRYPOINT(DestroyDescriptorUpdateTemplate)
+VK_DEVICE_ENTRYPOINT(UpdateDescriptorSetWithTemplate)
+VK_DEVICE_ENTRYPOINT(GetDescriptorSetLayoutSupport)
+
+// ---- Core Vulkan 1.2 commands
+VK_DEVICE_ENTRYPOINT(CmdDrawIndirectCount)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndexedIndirectCount)
+VK_DEVICE_ENTRYPOINT(CreateRenderPass2)
+VK_DEVICE_ENTRYPOINT(CmdBeginRenderPass2)
+VK_DEVICE_ENTRYPOINT(CmdNextSubpass2)
+VK_DEVICE_ENTRYPOINT(CmdEndRenderPass2)
+VK_DEVICE_ENTRYPOINT(ResetQueryPool)
+VK_DEVICE_ENTRYPOINT(GetSemaphoreCounterValue)
+VK_DEVICE_ENTRYPOINT(WaitSemaphores)
+VK_DEVICE_ENTRYPOINT(SignalSemaphore)
+VK_DEVICE_ENTRYPOINT(GetBufferDeviceAddress)
+VK_DEVICE_ENTRYPOINT(GetBufferOpaqueCaptureAddress)
+VK_DEVICE_ENTRYPOINT(GetDeviceMemoryOpaqueCaptureAddress)
+
+// ---- Core Vulkan 1.3 commands
+VK_DEVICE_ENTRYPOINT(CreatePrivateDataSlot)
+VK_DEVICE_ENTRYPOINT(DestroyPrivateDataSlot)
+VK_DEVICE_ENTRYPOINT(SetPrivateData)
+VK_DEVICE_ENTRYPOINT(GetPrivateData)
+VK_DEVICE_ENTRYPOINT(CmdSetEvent2)
+VK_DEVICE_ENTRYPOINT(CmdResetEvent2)
+VK_DEVICE_ENTRYPOINT(CmdWaitEvents2)
+VK_DEVICE_ENTRYPOINT(CmdPipelineBarrier2)
+VK_DEVICE_ENTRYPOINT(CmdWriteTimestamp2)
+VK_DEVICE_ENTRYPOINT(QueueSubmit2)
+VK_DEVICE_ENTRYPOINT(CmdCopyBuffer2)
+VK_DEVICE_ENTRYPOINT(CmdCopyImage2)
+VK_DEVICE_ENTRYPOINT(CmdCopyBufferToImage2)
+VK_DEVICE_ENTRYPOINT(CmdCopyImageToBuffer2)
+VK_DEVICE_ENTRYPOINT(CmdBlitImage2)
+VK_DEVICE_ENTRYPOINT(CmdResolveImage2)
+VK_DEVICE_ENTRYPOINT(CmdBeginRendering)
+VK_DEVICE_ENTRYPOINT(CmdEndRendering)
+VK_DEVICE_ENTRYPOINT(CmdSetCullMode)
+VK_DEVICE_ENTRYPOINT(CmdSetFrontFace)
+VK_DEVICE_ENTRYPOINT(CmdSetPrimitiveTopology)
+VK_DEVICE_ENTRYPOINT(CmdSetViewportWithCount)
+VK_DEVICE_ENTRYPOINT(CmdSetScissorWithCount)
+VK_DEVICE_ENTRYPOINT(CmdBindVertexBuffers2)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthTestEnable)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthWriteEnable)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthCompareOp)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBoundsTestEnable)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilTestEnable)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilOp)
+VK_DEVICE_ENTRYPOINT(CmdSetRasterizerDiscardEnable)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBiasEnable)
+VK_DEVICE_ENTRYPOINT(CmdSetPrimitiveRestartEnable)
+VK_DEVICE_ENTRYPOINT(GetDeviceBufferMemoryRequirements)
+VK_DEVICE_ENTRYPOINT(GetDeviceImageMemoryRequirements)
+VK_DEVICE_ENTRYPOINT(GetDeviceImageSparseMemoryRequirements)
+
+// ---- Core Vulkan 1.4 commands
+VK_DEVICE_ENTRYPOINT(CmdSetLineStipple)
+VK_DEVICE_ENTRYPOINT(MapMemory2)
+VK_DEVICE_ENTRYPOINT(UnmapMemory2)
+VK_DEVICE_ENTRYPOINT(CmdBindIndexBuffer2)
+VK_DEVICE_ENTRYPOINT(GetRenderingAreaGranularity)
+VK_DEVICE_ENTRYPOINT(GetDeviceImageSubresourceLayout)
+VK_DEVICE_ENTRYPOINT(GetImageSubresourceLayout2)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSet)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSetWithTemplate)
+VK_DEVICE_ENTRYPOINT(CmdSetRenderingAttachmentLocations)
+VK_DEVICE_ENTRYPOINT(CmdSetRenderingInputAttachmentIndices)
+VK_DEVICE_ENTRYPOINT(CmdBindDescriptorSets2)
+VK_DEVICE_ENTRYPOINT(CmdPushConstants2)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSet2)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSetWithTemplate2)
+VK_DEVICE_ENTRYPOINT(CopyMemoryToImage)
+VK_DEVICE_ENTRYPOINT(CopyImageToMemory)
+VK_DEVICE_ENTRYPOINT(CopyImageToImage)
+VK_DEVICE_ENTRYPOINT(TransitionImageLayout)
+
+// ---- VK_KHR_swapchain extension commands
+VK_DEVICE_ENTRYPOINT(CreateSwapchainKHR)
+VK_DEVICE_ENTRYPOINT(DestroySwapchainKHR)
+VK_DEVICE_ENTRYPOINT(GetSwapchainImagesKHR)
+VK_DEVICE_ENTRYPOINT(AcquireNextImageKHR)
+VK_DEVICE_ENTRYPOINT(QueuePresentKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceGroupPresentCapabilitiesKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceGroupSurfacePresentModesKHR)
+VK_DEVICE_ENTRYPOINT(AcquireNextImage2KHR)
+
+// ---- VK_KHR_display_swapchain extension commands
+VK_DEVICE_ENTRYPOINT(CreateSharedSwapchainsKHR)
+
+// ---- VK_KHR_video_queue extension commands
+VK_DEVICE_ENTRYPOINT(CreateVideoSessionKHR)
+VK_DEVICE_ENTRYPOINT(DestroyVideoSessionKHR)
+VK_DEVICE_ENTRYPOINT(GetVideoSessionMemoryRequirementsKHR)
+VK_DEVICE_ENTRYPOINT(BindVideoSessionMemoryKHR)
+VK_DEVICE_ENTRYPOINT(CreateVideoSessionParametersKHR)
+VK_DEVICE_ENTRYPOINT(UpdateVideoSessionParametersKHR)
+VK_DEVICE_ENTRYPOINT(DestroyVideoSessionParametersKHR)
+VK_DEVICE_ENTRYPOINT(CmdBeginVideoCodingKHR)
+VK_DEVICE_ENTRYPOINT(CmdEndVideoCodingKHR)
+VK_DEVICE_ENTRYPOINT(CmdControlVideoCodingKHR)
+
+// ---- VK_KHR_video_decode_queue extension commands
+VK_DEVICE_ENTRYPOINT(CmdDecodeVideoKHR)
+
+// ---- VK_KHR_dynamic_rendering extension commands
+VK_DEVICE_ENTRYPOINT(CmdBeginRenderingKHR)
+VK_DEVICE_ENTRYPOINT(CmdEndRenderingKHR)
+
+// ---- VK_KHR_device_group extension commands
+VK_DEVICE_ENTRYPOINT(GetDeviceGroupPeerMemoryFeaturesKHR)
+VK_DEVICE_ENTRYPOINT(CmdSetDeviceMaskKHR)
+VK_DEVICE_ENTRYPOINT(CmdDispatchBaseKHR)
+
+// ---- VK_KHR_maintenance1 extension commands
+VK_DEVICE_ENTRYPOINT(TrimCommandPoolKHR)
+
+// ---- VK_KHR_external_memory_win32 extension commands
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(GetMemoryWin32HandleKHR)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(GetMemoryWin32HandlePropertiesKHR)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+
+// ---- VK_KHR_external_memory_fd extension commands
+VK_DEVICE_ENTRYPOINT(GetMemoryFdKHR)
+VK_DEVICE_ENTRYPOINT(GetMemoryFdPropertiesKHR)
+
+// ---- VK_KHR_external_semaphore_win32 extension commands
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(ImportSemaphoreWin32HandleKHR)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(GetSemaphoreWin32HandleKHR)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+
+// ---- VK_KHR_external_semaphore_fd extension commands
+VK_DEVICE_ENTRYPOINT(ImportSemaphoreFdKHR)
+VK_DEVICE_ENTRYPOINT(GetSemaphoreFdKHR)
+
+// ---- VK_KHR_push_descriptor extension commands
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSetKHR)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSetWithTemplateKHR)
+
+// ---- VK_KHR_descriptor_update_template extension commands
+VK_DEVICE_ENTRYPOINT(CreateDescriptorUpdateTemplateKHR)
+VK_DEVICE_ENTRYPOINT(DestroyDescriptorUpdateTemplateKHR)
+VK_DEVICE_ENTRYPOINT(UpdateDescriptorSetWithTemplateKHR)
+
+// ---- VK_KHR_create_renderpass2 extension commands
+VK_DEVICE_ENTRYPOINT(CreateRenderPass2KHR)
+VK_DEVICE_ENTRYPOINT(CmdBeginRenderPass2KHR)
+VK_DEVICE_ENTRYPOINT(CmdNextSubpass2KHR)
+VK_DEVICE_ENTRYPOINT(CmdEndRenderPass2KHR)
+
+// ---- VK_KHR_shared_presentable_image extension commands
+VK_DEVICE_ENTRYPOINT(GetSwapchainStatusKHR)
+
+// ---- VK_KHR_external_fence_win32 extension commands
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(ImportFenceWin32HandleKHR)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(GetFenceWin32HandleKHR)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+
+// ---- VK_KHR_external_fence_fd extension commands
+VK_DEVICE_ENTRYPOINT(ImportFenceFdKHR)
+VK_DEVICE_ENTRYPOINT(GetFenceFdKHR)
+
+// ---- VK_KHR_performance_query extension commands
+VK_DEVICE_ENTRYPOINT(AcquireProfilingLockKHR)
+VK_DEVICE_ENTRYPOINT(ReleaseProfilingLockKHR)
+
+// ---- VK_KHR_get_memory_requirements2 extension commands
+VK_DEVICE_ENTRYPOINT(GetImageMemoryRequirements2KHR)
+VK_DEVICE_ENTRYPOINT(GetBufferMemoryRequirements2KHR)
+VK_DEVICE_ENTRYPOINT(GetImageSparseMemoryRequirements2KHR)
+
+// ---- VK_KHR_sampler_ycbcr_conversion extension commands
+VK_DEVICE_ENTRYPOINT(CreateSamplerYcbcrConversionKHR)
+VK_DEVICE_ENTRYPOINT(DestroySamplerYcbcrConversionKHR)
+
+// ---- VK_KHR_bind_memory2 extension commands
+VK_DEVICE_ENTRYPOINT(BindBufferMemory2KHR)
+VK_DEVICE_ENTRYPOINT(BindImageMemory2KHR)
+
+// ---- VK_KHR_maintenance3 extension commands
+VK_DEVICE_ENTRYPOINT(GetDescriptorSetLayoutSupportKHR)
+
+// ---- VK_KHR_draw_indirect_count extension commands
+VK_DEVICE_ENTRYPOINT(CmdDrawIndirectCountKHR)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndexedIndirectCountKHR)
+
+// ---- VK_KHR_timeline_semaphore extension commands
+VK_DEVICE_ENTRYPOINT(GetSemaphoreCounterValueKHR)
+VK_DEVICE_ENTRYPOINT(WaitSemaphoresKHR)
+VK_DEVICE_ENTRYPOINT(SignalSemaphoreKHR)
+
+// ---- VK_KHR_fragment_shading_rate extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetFragmentShadingRateKHR)
+
+// ---- VK_KHR_dynamic_rendering_local_read extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetRenderingAttachmentLocationsKHR)
+VK_DEVICE_ENTRYPOINT(CmdSetRenderingInputAttachmentIndicesKHR)
+
+// ---- VK_KHR_present_wait extension commands
+VK_DEVICE_ENTRYPOINT(WaitForPresentKHR)
+
+// ---- VK_KHR_buffer_device_address extension commands
+VK_DEVICE_ENTRYPOINT(GetBufferDeviceAddressKHR)
+VK_DEVICE_ENTRYPOINT(GetBufferOpaqueCaptureAddressKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceMemoryOpaqueCaptureAddressKHR)
+
+// ---- VK_KHR_deferred_host_operations extension commands
+VK_DEVICE_ENTRYPOINT(CreateDeferredOperationKHR)
+VK_DEVICE_ENTRYPOINT(DestroyDeferredOperationKHR)
+VK_DEVICE_ENTRYPOINT(GetDeferredOperationMaxConcurrencyKHR)
+VK_DEVICE_ENTRYPOINT(GetDeferredOperationResultKHR)
+VK_DEVICE_ENTRYPOINT(DeferredOperationJoinKHR)
+
+// ---- VK_KHR_pipeline_executable_properties extension commands
+VK_DEVICE_ENTRYPOINT(GetPipelineExecutablePropertiesKHR)
+VK_DEVICE_ENTRYPOINT(GetPipelineExecutableStatisticsKHR)
+VK_DEVICE_ENTRYPOINT(GetPipelineExecutableInternalRepresentationsKHR)
+
+// ---- VK_KHR_map_memory2 extension commands
+VK_DEVICE_ENTRYPOINT(MapMemory2KHR)
+VK_DEVICE_ENTRYPOINT(UnmapMemory2KHR)
+
+// ---- VK_KHR_video_encode_queue extension commands
+VK_DEVICE_ENTRYPOINT(GetEncodedVideoSessionParametersKHR)
+VK_DEVICE_ENTRYPOINT(CmdEncodeVideoKHR)
+
+// ---- VK_KHR_synchronization2 extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetEvent2KHR)
+VK_DEVICE_ENTRYPOINT(CmdResetEvent2KHR)
+VK_DEVICE_ENTRYPOINT(CmdWaitEvents2KHR)
+VK_DEVICE_ENTRYPOINT(CmdPipelineBarrier2KHR)
+VK_DEVICE_ENTRYPOINT(CmdWriteTimestamp2KHR)
+VK_DEVICE_ENTRYPOINT(QueueSubmit2KHR)
+
+// ---- VK_KHR_copy_commands2 extension commands
+VK_DEVICE_ENTRYPOINT(CmdCopyBuffer2KHR)
+VK_DEVICE_ENTRYPOINT(CmdCopyImage2KHR)
+VK_DEVICE_ENTRYPOINT(CmdCopyBufferToImage2KHR)
+VK_DEVICE_ENTRYPOINT(CmdCopyImageToBuffer2KHR)
+VK_DEVICE_ENTRYPOINT(CmdBlitImage2KHR)
+VK_DEVICE_ENTRYPOINT(CmdResolveImage2KHR)
+
+// ---- VK_KHR_ray_tracing_maintenance1 extension commands
+VK_DEVICE_ENTRYPOINT(CmdTraceRaysIndirect2KHR)
+
+// ---- VK_KHR_maintenance4 extension commands
+VK_DEVICE_ENTRYPOINT(GetDeviceBufferMemoryRequirementsKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceImageMemoryRequirementsKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceImageSparseMemoryRequirementsKHR)
+
+// ---- VK_KHR_maintenance5 extension commands
+VK_DEVICE_ENTRYPOINT(CmdBindIndexBuffer2KHR)
+VK_DEVICE_ENTRYPOINT(GetRenderingAreaGranularityKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceImageSubresourceLayoutKHR)
+VK_DEVICE_ENTRYPOINT(GetImageSubresourceLayout2KHR)
+
+// ---- VK_KHR_pipeline_binary extension commands
+VK_DEVICE_ENTRYPOINT(CreatePipelineBinariesKHR)
+VK_DEVICE_ENTRYPOINT(DestroyPipelineBinaryKHR)
+VK_DEVICE_ENTRYPOINT(GetPipelineKeyKHR)
+VK_DEVICE_ENTRYPOINT(GetPipelineBinaryDataKHR)
+VK_DEVICE_ENTRYPOINT(ReleaseCapturedPipelineDataKHR)
+
+// ---- VK_KHR_line_rasterization extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetLineStippleKHR)
+
+// ---- VK_KHR_calibrated_timestamps extension commands
+VK_DEVICE_ENTRYPOINT(GetCalibratedTimestampsKHR)
+
+// ---- VK_KHR_maintenance6 extension commands
+VK_DEVICE_ENTRYPOINT(CmdBindDescriptorSets2KHR)
+VK_DEVICE_ENTRYPOINT(CmdPushConstants2KHR)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSet2KHR)
+VK_DEVICE_ENTRYPOINT(CmdPushDescriptorSetWithTemplate2KHR)
+VK_DEVICE_ENTRYPOINT(CmdSetDescriptorBufferOffsets2EXT)
+VK_DEVICE_ENTRYPOINT(CmdBindDescriptorBufferEmbeddedSamplers2EXT)
+
+// ---- VK_EXT_debug_marker extension commands
+VK_DEVICE_ENTRYPOINT(DebugMarkerSetObjectTagEXT)
+VK_DEVICE_ENTRYPOINT(DebugMarkerSetObjectNameEXT)
+VK_DEVICE_ENTRYPOINT(CmdDebugMarkerBeginEXT)
+VK_DEVICE_ENTRYPOINT(CmdDebugMarkerEndEXT)
+VK_DEVICE_ENTRYPOINT(CmdDebugMarkerInsertEXT)
+
+// ---- VK_EXT_transform_feedback extension commands
+VK_DEVICE_ENTRYPOINT(CmdBindTransformFeedbackBuffersEXT)
+VK_DEVICE_ENTRYPOINT(CmdBeginTransformFeedbackEXT)
+VK_DEVICE_ENTRYPOINT(CmdEndTransformFeedbackEXT)
+VK_DEVICE_ENTRYPOINT(CmdBeginQueryIndexedEXT)
+VK_DEVICE_ENTRYPOINT(CmdEndQueryIndexedEXT)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndirectByteCountEXT)
+
+// ---- VK_NVX_binary_import extension commands
+VK_DEVICE_ENTRYPOINT(CreateCuModuleNVX)
+VK_DEVICE_ENTRYPOINT(CreateCuFunctionNVX)
+VK_DEVICE_ENTRYPOINT(DestroyCuModuleNVX)
+VK_DEVICE_ENTRYPOINT(DestroyCuFunctionNVX)
+VK_DEVICE_ENTRYPOINT(CmdCuLaunchKernelNVX)
+
+// ---- VK_NVX_image_view_handle extension commands
+VK_DEVICE_ENTRYPOINT(GetImageViewHandleNVX)
+VK_DEVICE_ENTRYPOINT(GetImageViewHandle64NVX)
+VK_DEVICE_ENTRYPOINT(GetImageViewAddressNVX)
+
+// ---- VK_AMD_draw_indirect_count extension commands
+VK_DEVICE_ENTRYPOINT(CmdDrawIndirectCountAMD)
+VK_DEVICE_ENTRYPOINT(CmdDrawIndexedIndirectCountAMD)
+
+// ---- VK_AMD_shader_info extension commands
+VK_DEVICE_ENTRYPOINT(GetShaderInfoAMD)
+
+// ---- VK_NV_external_memory_win32 extension commands
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(GetMemoryWin32HandleNV)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+
+// ---- VK_EXT_conditional_rendering extension commands
+VK_DEVICE_ENTRYPOINT(CmdBeginConditionalRenderingEXT)
+VK_DEVICE_ENTRYPOINT(CmdEndConditionalRenderingEXT)
+
+// ---- VK_NV_clip_space_w_scaling extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetViewportWScalingNV)
+
+// ---- VK_EXT_display_control extension commands
+VK_DEVICE_ENTRYPOINT(DisplayPowerControlEXT)
+VK_DEVICE_ENTRYPOINT(RegisterDeviceEventEXT)
+VK_DEVICE_ENTRYPOINT(RegisterDisplayEventEXT)
+VK_DEVICE_ENTRYPOINT(GetSwapchainCounterEXT)
+
+// ---- VK_GOOGLE_display_timing extension commands
+VK_DEVICE_ENTRYPOINT(GetRefreshCycleDurationGOOGLE)
+VK_DEVICE_ENTRYPOINT(GetPastPresentationTimingGOOGLE)
+
+// ---- VK_EXT_discard_rectangles extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetDiscardRectangleEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDiscardRectangleEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDiscardRectangleModeEXT)
+
+// ---- VK_EXT_hdr_metadata extension commands
+VK_DEVICE_ENTRYPOINT(SetHdrMetadataEXT)
+
+// ---- VK_EXT_debug_utils extension commands
+VK_DEVICE_ENTRYPOINT(SetDebugUtilsObjectNameEXT)
+VK_DEVICE_ENTRYPOINT(SetDebugUtilsObjectTagEXT)
+VK_DEVICE_ENTRYPOINT(QueueBeginDebugUtilsLabelEXT)
+VK_DEVICE_ENTRYPOINT(QueueEndDebugUtilsLabelEXT)
+VK_DEVICE_ENTRYPOINT(QueueInsertDebugUtilsLabelEXT)
+VK_DEVICE_ENTRYPOINT(CmdBeginDebugUtilsLabelEXT)
+VK_DEVICE_ENTRYPOINT(CmdEndDebugUtilsLabelEXT)
+VK_DEVICE_ENTRYPOINT(CmdInsertDebugUtilsLabelEXT)
+
+// ---- VK_ANDROID_external_memory_android_hardware_buffer extension commands
+#if defined(VK_USE_PLATFORM_ANDROID_KHR)
+VK_DEVICE_ENTRYPOINT(GetAndroidHardwareBufferPropertiesANDROID)
+#endif // VK_USE_PLATFORM_ANDROID_KHR
+#if defined(VK_USE_PLATFORM_ANDROID_KHR)
+VK_DEVICE_ENTRYPOINT(GetMemoryAndroidHardwareBufferANDROID)
+#endif // VK_USE_PLATFORM_ANDROID_KHR
+
+// ---- VK_AMDX_shader_enqueue extension commands
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CreateExecutionGraphPipelinesAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(GetExecutionGraphPipelineScratchSizeAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(GetExecutionGraphPipelineNodeIndexAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CmdInitializeGraphScratchMemoryAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CmdDispatchGraphAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CmdDispatchGraphIndirectAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CmdDispatchGraphIndirectCountAMDX)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+
+// ---- VK_EXT_sample_locations extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetSampleLocationsEXT)
+
+// ---- VK_EXT_image_drm_format_modifier extension commands
+VK_DEVICE_ENTRYPOINT(GetImageDrmFormatModifierPropertiesEXT)
+
+// ---- VK_EXT_validation_cache extension commands
+VK_DEVICE_ENTRYPOINT(CreateValidationCacheEXT)
+VK_DEVICE_ENTRYPOINT(DestroyValidationCacheEXT)
+VK_DEVICE_ENTRYPOINT(MergeValidationCachesEXT)
+VK_DEVICE_ENTRYPOINT(GetValidationCacheDataEXT)
+
+// ---- VK_NV_shading_rate_image extension commands
+VK_DEVICE_ENTRYPOINT(CmdBindShadingRateImageNV)
+VK_DEVICE_ENTRYPOINT(CmdSetViewportShadingRatePaletteNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoarseSampleOrderNV)
+
+// ---- VK_NV_ray_tracing extension commands
+VK_DEVICE_ENTRYPOINT(CreateAccelerationStructureNV)
+VK_DEVICE_ENTRYPOINT(DestroyAccelerationStructureNV)
+VK_DEVICE_ENTRYPOINT(GetAccelerationStructureMemoryRequirementsNV)
+VK_DEVICE_ENTRYPOINT(BindAccelerationStructureMemoryNV)
+VK_DEVICE_ENTRYPOINT(CmdBuildAccelerationStructureNV)
+VK_DEVICE_ENTRYPOINT(CmdCopyAccelerationStructureNV)
+VK_DEVICE_ENTRYPOINT(CmdTraceRaysNV)
+VK_DEVICE_ENTRYPOINT(CreateRayTracingPipelinesNV)
+
+// ---- VK_KHR_ray_tracing_pipeline extension commands
+VK_DEVICE_ENTRYPOINT(GetRayTracingShaderGroupHandlesKHR)
+
+// ---- VK_NV_ray_tracing extension commands
+VK_DEVICE_ENTRYPOINT(GetRayTracingShaderGroupHandlesNV)
+VK_DEVICE_ENTRYPOINT(GetAccelerationStructureHandleNV)
+VK_DEVICE_ENTRYPOINT(CmdWriteAccelerationStructuresPropertiesNV)
+VK_DEVICE_ENTRYPOINT(CompileDeferredNV)
+
+// ---- VK_EXT_external_memory_host extension commands
+VK_DEVICE_ENTRYPOINT(GetMemoryHostPointerPropertiesEXT)
+
+// ---- VK_AMD_buffer_marker extension commands
+VK_DEVICE_ENTRYPOINT(CmdWriteBufferMarkerAMD)
+VK_DEVICE_ENTRYPOINT(CmdWriteBufferMarker2AMD)
+
+// ---- VK_EXT_calibrated_timestamps extension commands
+VK_DEVICE_ENTRYPOINT(GetCalibratedTimestampsEXT)
+
+// ---- VK_NV_mesh_shader extension commands
+VK_DEVICE_ENTRYPOINT(CmdDrawMeshTasksNV)
+VK_DEVICE_ENTRYPOINT(CmdDrawMeshTasksIndirectNV)
+VK_DEVICE_ENTRYPOINT(CmdDrawMeshTasksIndirectCountNV)
+
+// ---- VK_NV_scissor_exclusive extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetExclusiveScissorEnableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetExclusiveScissorNV)
+
+// ---- VK_NV_device_diagnostic_checkpoints extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetCheckpointNV)
+VK_DEVICE_ENTRYPOINT(GetQueueCheckpointDataNV)
+VK_DEVICE_ENTRYPOINT(GetQueueCheckpointData2NV)
+
+// ---- VK_INTEL_performance_query extension commands
+VK_DEVICE_ENTRYPOINT(InitializePerformanceApiINTEL)
+VK_DEVICE_ENTRYPOINT(UninitializePerformanceApiINTEL)
+VK_DEVICE_ENTRYPOINT(CmdSetPerformanceMarkerINTEL)
+VK_DEVICE_ENTRYPOINT(CmdSetPerformanceStreamMarkerINTEL)
+VK_DEVICE_ENTRYPOINT(CmdSetPerformanceOverrideINTEL)
+VK_DEVICE_ENTRYPOINT(AcquirePerformanceConfigurationINTEL)
+VK_DEVICE_ENTRYPOINT(ReleasePerformanceConfigurationINTEL)
+VK_DEVICE_ENTRYPOINT(QueueSetPerformanceConfigurationINTEL)
+VK_DEVICE_ENTRYPOINT(GetPerformanceParameterINTEL)
+
+// ---- VK_AMD_display_native_hdr extension commands
+VK_DEVICE_ENTRYPOINT(SetLocalDimmingAMD)
+
+// ---- VK_EXT_buffer_device_address extension commands
+VK_DEVICE_ENTRYPOINT(GetBufferDeviceAddressEXT)
+
+// ---- VK_EXT_full_screen_exclusive extension commands
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(AcquireFullScreenExclusiveModeEXT)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(ReleaseFullScreenExclusiveModeEXT)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceGroupSurfacePresentModes2EXT)
+#endif // VK_USE_PLATFORM_WIN32_KHR
+
+// ---- VK_EXT_line_rasterization extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetLineStippleEXT)
+
+// ---- VK_EXT_host_query_reset extension commands
+VK_DEVICE_ENTRYPOINT(ResetQueryPoolEXT)
+
+// ---- VK_EXT_extended_dynamic_state extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetCullModeEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetFrontFaceEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetPrimitiveTopologyEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetViewportWithCountEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetScissorWithCountEXT)
+VK_DEVICE_ENTRYPOINT(CmdBindVertexBuffers2EXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthTestEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthWriteEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthCompareOpEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBoundsTestEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilTestEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetStencilOpEXT)
+
+// ---- VK_EXT_host_image_copy extension commands
+VK_DEVICE_ENTRYPOINT(CopyMemoryToImageEXT)
+VK_DEVICE_ENTRYPOINT(CopyImageToMemoryEXT)
+VK_DEVICE_ENTRYPOINT(CopyImageToImageEXT)
+VK_DEVICE_ENTRYPOINT(TransitionImageLayoutEXT)
+VK_DEVICE_ENTRYPOINT(GetImageSubresourceLayout2EXT)
+
+// ---- VK_EXT_swapchain_maintenance1 extension commands
+VK_DEVICE_ENTRYPOINT(ReleaseSwapchainImagesEXT)
+
+// ---- VK_NV_device_generated_commands extension commands
+VK_DEVICE_ENTRYPOINT(GetGeneratedCommandsMemoryRequirementsNV)
+VK_DEVICE_ENTRYPOINT(CmdPreprocessGeneratedCommandsNV)
+VK_DEVICE_ENTRYPOINT(CmdExecuteGeneratedCommandsNV)
+VK_DEVICE_ENTRYPOINT(CmdBindPipelineShaderGroupNV)
+VK_DEVICE_ENTRYPOINT(CreateIndirectCommandsLayoutNV)
+VK_DEVICE_ENTRYPOINT(DestroyIndirectCommandsLayoutNV)
+
+// ---- VK_EXT_depth_bias_control extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBias2EXT)
+
+// ---- VK_EXT_private_data extension commands
+VK_DEVICE_ENTRYPOINT(CreatePrivateDataSlotEXT)
+VK_DEVICE_ENTRYPOINT(DestroyPrivateDataSlotEXT)
+VK_DEVICE_ENTRYPOINT(SetPrivateDataEXT)
+VK_DEVICE_ENTRYPOINT(GetPrivateDataEXT)
+
+// ---- VK_NV_cuda_kernel_launch extension commands
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CreateCudaModuleNV)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(GetCudaModuleCacheNV)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CreateCudaFunctionNV)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(DestroyCudaModuleNV)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(DestroyCudaFunctionNV)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+#if defined(VK_ENABLE_BETA_EXTENSIONS)
+VK_DEVICE_ENTRYPOINT(CmdCudaLaunchKernelNV)
+#endif // VK_ENABLE_BETA_EXTENSIONS
+
+// ---- VK_QCOM_tile_shading extension commands
+VK_DEVICE_ENTRYPOINT(CmdDispatchTileQCOM)
+VK_DEVICE_ENTRYPOINT(CmdBeginPerTileExecutionQCOM)
+VK_DEVICE_ENTRYPOINT(CmdEndPerTileExecutionQCOM)
+
+// ---- VK_EXT_metal_objects extension commands
+#if defined(VK_USE_PLATFORM_METAL_EXT)
+VK_DEVICE_ENTRYPOINT(ExportMetalObjectsEXT)
+#endif // VK_USE_PLATFORM_METAL_EXT
+
+// ---- VK_EXT_descriptor_buffer extension commands
+VK_DEVICE_ENTRYPOINT(GetDescriptorSetLayoutSizeEXT)
+VK_DEVICE_ENTRYPOINT(GetDescriptorSetLayoutBindingOffsetEXT)
+VK_DEVICE_ENTRYPOINT(GetDescriptorEXT)
+VK_DEVICE_ENTRYPOINT(CmdBindDescriptorBuffersEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDescriptorBufferOffsetsEXT)
+VK_DEVICE_ENTRYPOINT(CmdBindDescriptorBufferEmbeddedSamplersEXT)
+VK_DEVICE_ENTRYPOINT(GetBufferOpaqueCaptureDescriptorDataEXT)
+VK_DEVICE_ENTRYPOINT(GetImageOpaqueCaptureDescriptorDataEXT)
+VK_DEVICE_ENTRYPOINT(GetImageViewOpaqueCaptureDescriptorDataEXT)
+VK_DEVICE_ENTRYPOINT(GetSamplerOpaqueCaptureDescriptorDataEXT)
+VK_DEVICE_ENTRYPOINT(GetAccelerationStructureOpaqueCaptureDescriptorDataEXT)
+
+// ---- VK_NV_fragment_shading_rate_enums extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetFragmentShadingRateEnumNV)
+
+// ---- VK_EXT_device_fault extension commands
+VK_DEVICE_ENTRYPOINT(GetDeviceFaultInfoEXT)
+
+// ---- VK_EXT_vertex_input_dynamic_state extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetVertexInputEXT)
+
+// ---- VK_FUCHSIA_external_memory extension commands
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(GetMemoryZirconHandleFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(GetMemoryZirconHandlePropertiesFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+
+// ---- VK_FUCHSIA_external_semaphore extension commands
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(ImportSemaphoreZirconHandleFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(GetSemaphoreZirconHandleFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+
+// ---- VK_FUCHSIA_buffer_collection extension commands
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(CreateBufferCollectionFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(SetBufferCollectionImageConstraintsFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(SetBufferCollectionBufferConstraintsFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(DestroyBufferCollectionFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+#if defined(VK_USE_PLATFORM_FUCHSIA)
+VK_DEVICE_ENTRYPOINT(GetBufferCollectionPropertiesFUCHSIA)
+#endif // VK_USE_PLATFORM_FUCHSIA
+
+// ---- VK_HUAWEI_subpass_shading extension commands
+VK_DEVICE_ENTRYPOINT(GetDeviceSubpassShadingMaxWorkgroupSizeHUAWEI)
+VK_DEVICE_ENTRYPOINT(CmdSubpassShadingHUAWEI)
+
+// ---- VK_HUAWEI_invocation_mask extension commands
+VK_DEVICE_ENTRYPOINT(CmdBindInvocationMaskHUAWEI)
+
+// ---- VK_NV_external_memory_rdma extension commands
+VK_DEVICE_ENTRYPOINT(GetMemoryRemoteAddressNV)
+
+// ---- VK_EXT_pipeline_properties extension commands
+VK_DEVICE_ENTRYPOINT(GetPipelinePropertiesEXT)
+
+// ---- VK_EXT_extended_dynamic_state2 extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetPatchControlPointsEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetRasterizerDiscardEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthBiasEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetLogicOpEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetPrimitiveRestartEnableEXT)
+
+// ---- VK_EXT_color_write_enable extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetColorWriteEnableEXT)
+
+// ---- VK_EXT_multi_draw extension commands
+VK_DEVICE_ENTRYPOINT(CmdDrawMultiEXT)
+VK_DEVICE_ENTRYPOINT(CmdDrawMultiIndexedEXT)
+
+// ---- VK_EXT_opacity_micromap extension commands
+VK_DEVICE_ENTRYPOINT(CreateMicromapEXT)
+VK_DEVICE_ENTRYPOINT(DestroyMicromapEXT)
+VK_DEVICE_ENTRYPOINT(CmdBuildMicromapsEXT)
+VK_DEVICE_ENTRYPOINT(BuildMicromapsEXT)
+VK_DEVICE_ENTRYPOINT(CopyMicromapEXT)
+VK_DEVICE_ENTRYPOINT(CopyMicromapToMemoryEXT)
+VK_DEVICE_ENTRYPOINT(CopyMemoryToMicromapEXT)
+VK_DEVICE_ENTRYPOINT(WriteMicromapsPropertiesEXT)
+VK_DEVICE_ENTRYPOINT(CmdCopyMicromapEXT)
+VK_DEVICE_ENTRYPOINT(CmdCopyMicromapToMemoryEXT)
+VK_DEVICE_ENTRYPOINT(CmdCopyMemoryToMicromapEXT)
+VK_DEVICE_ENTRYPOINT(CmdWriteMicromapsPropertiesEXT)
+VK_DEVICE_ENTRYPOINT(GetDeviceMicromapCompatibilityEXT)
+VK_DEVICE_ENTRYPOINT(GetMicromapBuildSizesEXT)
+
+// ---- VK_HUAWEI_cluster_culling_shader extension commands
+VK_DEVICE_ENTRYPOINT(CmdDrawClusterHUAWEI)
+VK_DEVICE_ENTRYPOINT(CmdDrawClusterIndirectHUAWEI)
+
+// ---- VK_EXT_pageable_device_local_memory extension commands
+VK_DEVICE_ENTRYPOINT(SetDeviceMemoryPriorityEXT)
+
+// ---- VK_VALVE_descriptor_set_host_mapping extension commands
+VK_DEVICE_ENTRYPOINT(GetDescriptorSetLayoutHostMappingInfoVALVE)
+VK_DEVICE_ENTRYPOINT(GetDescriptorSetHostMappingVALVE)
+
+// ---- VK_NV_copy_memory_indirect extension commands
+VK_DEVICE_ENTRYPOINT(CmdCopyMemoryIndirectNV)
+VK_DEVICE_ENTRYPOINT(CmdCopyMemoryToImageIndirectNV)
+
+// ---- VK_NV_memory_decompression extension commands
+VK_DEVICE_ENTRYPOINT(CmdDecompressMemoryNV)
+VK_DEVICE_ENTRYPOINT(CmdDecompressMemoryIndirectCountNV)
+
+// ---- VK_NV_device_generated_commands_compute extension commands
+VK_DEVICE_ENTRYPOINT(GetPipelineIndirectMemoryRequirementsNV)
+VK_DEVICE_ENTRYPOINT(CmdUpdatePipelineIndirectBufferNV)
+VK_DEVICE_ENTRYPOINT(GetPipelineIndirectDeviceAddressNV)
+
+// ---- VK_EXT_extended_dynamic_state3 extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetDepthClampEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetPolygonModeEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetRasterizationSamplesEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetSampleMaskEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetAlphaToCoverageEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetAlphaToOneEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetLogicOpEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetColorBlendEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetColorBlendEquationEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetColorWriteMaskEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetTessellationDomainOriginEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetRasterizationStreamEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetConservativeRasterizationModeEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetExtraPrimitiveOverestimationSizeEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthClipEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetSampleLocationsEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetColorBlendAdvancedEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetProvokingVertexModeEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetLineRasterizationModeEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetLineStippleEnableEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthClipNegativeOneToOneEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetViewportWScalingEnableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetViewportSwizzleNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoverageToColorEnableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoverageToColorLocationNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoverageModulationModeNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoverageModulationTableEnableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoverageModulationTableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetShadingRateImageEnableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetRepresentativeFragmentTestEnableNV)
+VK_DEVICE_ENTRYPOINT(CmdSetCoverageReductionModeNV)
+
+// ---- VK_EXT_shader_module_identifier extension commands
+VK_DEVICE_ENTRYPOINT(GetShaderModuleIdentifierEXT)
+VK_DEVICE_ENTRYPOINT(GetShaderModuleCreateInfoIdentifierEXT)
+
+// ---- VK_NV_optical_flow extension commands
+VK_DEVICE_ENTRYPOINT(CreateOpticalFlowSessionNV)
+VK_DEVICE_ENTRYPOINT(DestroyOpticalFlowSessionNV)
+VK_DEVICE_ENTRYPOINT(BindOpticalFlowSessionImageNV)
+VK_DEVICE_ENTRYPOINT(CmdOpticalFlowExecuteNV)
+
+// ---- VK_AMD_anti_lag extension commands
+VK_DEVICE_ENTRYPOINT(AntiLagUpdateAMD)
+
+// ---- VK_EXT_shader_object extension commands
+VK_DEVICE_ENTRYPOINT(CreateShadersEXT)
+VK_DEVICE_ENTRYPOINT(DestroyShaderEXT)
+VK_DEVICE_ENTRYPOINT(GetShaderBinaryDataEXT)
+VK_DEVICE_ENTRYPOINT(CmdBindShadersEXT)
+VK_DEVICE_ENTRYPOINT(CmdSetDepthClampRangeEXT)
+
+// ---- VK_QCOM_tile_properties extension commands
+VK_DEVICE_ENTRYPOINT(GetFramebufferTilePropertiesQCOM)
+VK_DEVICE_ENTRYPOINT(GetDynamicRenderingTilePropertiesQCOM)
+
+// ---- VK_NV_cooperative_vector extension commands
+VK_DEVICE_ENTRYPOINT(ConvertCooperativeVectorMatrixNV)
+VK_DEVICE_ENTRYPOINT(CmdConvertCooperativeVectorMatrixNV)
+
+// ---- VK_NV_low_latency2 extension commands
+VK_DEVICE_ENTRYPOINT(SetLatencySleepModeNV)
+VK_DEVICE_ENTRYPOINT(LatencySleepNV)
+VK_DEVICE_ENTRYPOINT(SetLatencyMarkerNV)
+VK_DEVICE_ENTRYPOINT(GetLatencyTimingsNV)
+VK_DEVICE_ENTRYPOINT(QueueNotifyOutOfBandNV)
+
+// ---- VK_EXT_attachment_feedback_loop_dynamic_state extension commands
+VK_DEVICE_ENTRYPOINT(CmdSetAttachmentFeedbackLoopEnableEXT)
+
+// ---- VK_QNX_external_memory_screen_buffer extension commands
+#if defined(VK_USE_PLATFORM_SCREEN_QNX)
+VK_DEVICE_ENTRYPOINT(GetScreenBufferPropertiesQNX)
+#endif // VK_USE_PLATFORM_SCREEN_QNX
+
+// ---- VK_QCOM_tile_memory_heap extension commands
+VK_DEVICE_ENTRYPOINT(CmdBindTileMemoryQCOM)
+
+// ---- VK_NV_external_compute_queue extension commands
+VK_DEVICE_ENTRYPOINT(CreateExternalComputeQueueNV)
+VK_DEVICE_ENTRYPOINT(DestroyExternalComputeQueueNV)
+VK_DEVICE_ENTRYPOINT(GetExternalComputeQueueDataNV)
+
+// ---- VK_NV_cluster_acceleration_structure extension commands
+VK_DEVICE_ENTRYPOINT(GetClusterAccelerationStructureBuildSizesNV)
+VK_DEVICE_ENTRYPOINT(CmdBuildClusterAccelerationStructureIndirectNV)
+
+// ---- VK_NV_partitioned_acceleration_structure extension commands
+VK_DEVICE_ENTRYPOINT(GetPartitionedAccelerationStructuresBuildSizesNV)
+VK_DEVICE_ENTRYPOINT(CmdBuildPartitionedAccelerationStructuresNV)
+
+// ---- VK_EXT_device_generated_commands extension commands
+VK_DEVICE_ENTRYPOINT(GetGeneratedCommandsMemoryRequirementsEXT)
+VK_DEVICE_ENTRYPOINT(CmdPreprocessGeneratedCommandsEXT)
+VK_DEVICE_ENTRYPOINT(CmdExecuteGeneratedCommandsEXT)
+VK_DEVICE_ENTRYPOINT(CreateIndirectCommandsLayoutEXT)
+VK_DEVICE_ENTRYPOINT(DestroyIndirectCommandsLayoutEXT)
+VK_DEVICE_ENTRYPOINT(CreateIndirectExecutionSetEXT)
+VK_DEVICE_ENTRYPOINT(DestroyIndirectExecutionSetEXT)
+VK_DEVICE_ENTRYPOINT(UpdateIndirectExecutionSetPipelineEXT)
+VK_DEVICE_ENTRYPOINT(UpdateIndirectExecutionSetShaderEXT)
+
+// ---- VK_EXT_external_memory_metal extension commands
+#if defined(VK_USE_PLATFORM_METAL_EXT)
+VK_DEVICE_ENTRYPOINT(GetMemoryMetalHandleEXT)
+#endif // VK_USE_PLATFORM_METAL_EXT
+#if defined(VK_USE_PLATFORM_METAL_EXT)
+VK_DEVICE_ENTRYPOINT(GetMemoryMetalHandlePropertiesEXT)
+#endif // VK_USE_PLATFORM_METAL_EXT
+
+// ---- VK_EXT_fragment_density_map_offset extension commands
+VK_DEVICE_ENTRYPOINT(CmdEndRendering2EXT)
+
+// ---- VK_KHR_acceleration_structure extension commands
+VK_DEVICE_ENTRYPOINT(CreateAccelerationStructureKHR)
+VK_DEVICE_ENTRYPOINT(DestroyAccelerationStructureKHR)
+VK_DEVICE_ENTRYPOINT(CmdBuildAccelerationStructuresKHR)
+VK_DEVICE_ENTRYPOINT(CmdBuildAccelerationStructuresIndirectKHR)
+VK_DEVICE_ENTRYPOINT(BuildAccelerationStructuresKHR)
+VK_DEVICE_ENTRYPOINT(CopyAccelerationStructureKHR)
+VK_DEVICE_ENTRYPOINT(CopyAccelerationStructureToMemoryKHR)
+VK_DEVICE_ENTRYPOINT(CopyMemoryToAccelerationStructureKHR)
+VK_DEVICE_ENTRYPOINT(WriteAccelerationStructuresPropertiesKHR)
+VK_DEVICE_ENTRYPOINT(CmdCopyAccelerationStructureKHR)
+VK_DEVICE_ENTRYPOINT(CmdCopyAccelerationStructureToMemoryKHR)
+VK_DEVICE_ENTRYPOINT(CmdCopyMemoryToAccelerationStructureKHR)
+VK_DEVICE_ENTRYPOINT(GetAccelerationStructureDeviceAddressKHR)
+VK_DEVICE_ENTRYPOINT(CmdWriteAccelerationStructuresPropertiesKHR)
+VK_DEVICE_ENTRYPOINT(GetDeviceAccelerationStructureCompatibilityKHR)
+VK_DEVICE_ENTRYPOINT(GetAccelerationStructureBuildSizesKHR)
+
+// ---- VK_KHR_ray_tracing_pipeline extension commands
+VK_DEVICE_ENTRYPOINT(CmdTraceRaysKHR)
+VK_DEVICE_ENTRYPOINT(CreateRayTracingPipelinesKHR)
+VK_DEVICE_ENTRYPOINT(GetRayTracingCaptureReplayShaderGroupHandlesKHR)
+VK_DEVICE_ENTRYPOINT(CmdTraceRaysIndirectKHR)
+VK_DEVICE_ENTRYPOINT(GetRayTracingShaderGroupStackSizeKHR)
+VK_DEVICE_ENTRYPOINT(CmdSetRayTracingPipelineStackSizeKHR)
+
+// ---- VK_EXT_mesh_shader extension commands
+VK_DEVICE_ENTRYPOINT(CmdDrawMeshTasksEXT)
+VK_DEVICE_ENTRYPOINT(CmdDrawMeshTasksIndirectEXT)
+VK_DEVICE_ENTRYPOINT(CmdDrawMeshTasksIndirectCountEXT)
+
+#undef VK_DEVICE_ENTRYPOINT
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "api.h"
+
+/**
+ * @brief Virtual function hooks shared between mods, on top of libmem's VMT API
+ *
+ * There is one lm_vmt_t per hooked table: a class's vtable in Sky.exe, which
+ * hooks every object of the class, or one shadow copy per hooked object. Hooks
+ * on the same slot form a chain: the table points at the first hook, and each
+ * hook continues through GetNext to the following one, the last reaching the
+ * original function. An object's chain ends in its class's chain. Hooks
+ * belong to the module their function is in and are removed with it.
+ * Removed hooks and shadows are freed after a grace period, so memory stays
+ * bounded by what is hooked plus what was removed in the last few seconds.
+ */
+namespace VmtHooks {
+    /**
+     * @brief Hook every object of a class by patching its vtable
+     * @param priority Higher runs first; hooks of equal priority run in the order they were added
+     * @return nullptr if vtable is not an indexed vtable of Sky.exe, slot is out of range, or hook is already on the slot
+     */
+    ModVmtHook* HookClass(uintptr_t vtable, size_t slot, void* hook, int priority);
+
+    /**
+     * @brief Hook one object by pointing it at a shadow copy of its class's vtable
+     * @param object The object, or the subobject whose vtable pointer should be hooked
+     */
+    ModVmtHook* HookObject(void* object, size_t slot, void* hook, int priority);
+
+    /**
+     * @brief The function to call to continue the chain; stays valid for the grace period after the hook is removed
+     */
+    void* GetNext(const ModVmtHook* hook);
+    void Unhook(ModVmtHook* hook);
+
+    /**
+     * @brief Remove every hook whose function is in module; called before a mod is disabled or freed
+     */
+    void RemoveModule(void* module);
+
+    /**
+     * @brief Collect hooks added until EndBatch and write each changed slot once
+     *
+     * LoadMods opens a batch while mods start under the loader lock. Hooks
+     * look their vtable up before taking the hook lock, and VTableIndex
+     * builds the index in place when the pool has not, so nothing in a batch
+     * waits on pool work.
+     */
+    void BeginBatch();
+    void EndBatch();
+} // namespace VmtHooks
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Index of Sky.exe's vtables by class name, built from its RTTI
+ *
+ * Built once on the thread pool when Sky.exe is loaded and kept in a file
+ * keyed by a hash of its PE headers, so later runs of the same build load the
+ * index instead of scanning .rdata again. A lookup made before the pool gets
+ * to it, as from a mod's Start under the loader lock, builds it in place.
+ */
+namespace VTableIndex {
+    /**
+     * @brief Load or build the index in the background; call once after InitSkyBase
+     */
+    void Start();
+
+    /**
+     * @brief Address of a class's vtable in Sky.exe; waits for the index if the pool is building it
+     * @param name "class Foo::Bar", or the decorated ".?AVBar@Foo@@"
+     * @param offset Of the subobject whose vtable is wanted, 0 for the primary vtable
+     * @param slots Set to the number of virtual functions in the vtable
+     * @return 0 if the class has no vtable at that offset
+     */
+    uintptr_t Find(const std::string& name, uint32_t offset = 0, size_t* slots = nullptr);
+
+    /**
+     * @brief Number of virtual functions in an indexed vtable of Sky.exe
+     * @return 0 if vtable is not the address of one
+     */
+    size_t Slots(uintptr_t vtable);
+} // namespace VTableIndex
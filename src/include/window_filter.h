@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief What the window hook does with a message before ImGui or the game sees it
+ *
+ * Runs for every message the game's window receives, mouse moves and raw
+ * input included, so a message that is not a key press costs one table
+ * lookup. Platform independent so the per-message cost can be measured off
+ * Windows; message and key codes are the Win32 values.
+ */
+namespace WindowFilter {
+    // The Win32 messages the filter looks at; main.cpp checks them against windows.h
+    constexpr uint32_t kSetFocus        = 0x0007;
+    constexpr uint32_t kKillFocus       = 0x0008;
+    constexpr uint32_t kInputLangChange = 0x0051;
+    constexpr uint32_t kKeyDown         = 0x0100;
+    constexpr uint32_t kKeyUp           = 0x0101;
+    constexpr uint32_t kChar            = 0x0102;
+    constexpr uint32_t kSysKeyDown      = 0x0104;
+    constexpr uint32_t kSysKeyUp        = 0x0105;
+    constexpr uint32_t kMouseFirst      = 0x0200;
+    constexpr uint32_t kLButtonUp       = 0x0202;
+    constexpr uint32_t kRButtonUp       = 0x0205;
+    constexpr uint32_t kMButtonUp       = 0x0208;
+    constexpr uint32_t kXButtonUp       = 0x020C;
+    constexpr uint32_t kMouseLast       = 0x020E;
+    constexpr uint32_t kDeviceChange    = 0x0219;
+    constexpr uint32_t kMouseLeave      = 0x02A3;
+    constexpr uint32_t kUser            = 0x0400;
+
+    constexpr uint32_t kMenuKey = 0xDF; // VK_OEM_8
+
+    // Hotkeys other than the menu key go on to the game after their action
+    enum Action {
+        ACTION_TOGGLE_MENU,
+        ACTION_SCREENSHOT,
+        ACTION_RECORDING,
+        ACTION_TRACE,
+        ACTION_GAME,  // Straight to the game: the menu is hidden and ImGui has no use for the message
+        ACTION_PASS,  // As ACTION_GAME, but not an input message, so there is no event to publish
+        ACTION_IMGUI, // To ImGui, then to the game unless ImGui captured it
+    };
+
+    /**
+     * @param wParam Virtual-key code for key messages
+     */
+    Action Classify(uint32_t message, uint64_t wParam, bool menuVisible);
+} // namespace WindowFilter
@@ -0,0 +1,201 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+#include "include/input_events.h"
+
+namespace {
+
+constexpr uint64_t kCapacity = 1024; // Power of two
+constexpr uint64_t kMask = kCapacity - 1;
+constexpr size_t kWords = sizeof(ModInputEvent) / sizeof(uint64_t);
+static_assert(sizeof(ModInputEvent) == kWords * sizeof(uint64_t), "ModInputEvent must pack into whole words");
+
+/**
+ * @brief One event of the ring
+ *
+ * The sequence is the event's position plus one once it is written and 0
+ * while it is being overwritten. Readers check it before and after copying the
+ * words, so a copy torn by the writer lapping them is thrown away.
+ */
+struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> words[kWords];
+};
+
+Slot slots[kCapacity];
+std::atomic<uint64_t> head{0}; // Position of the next event to be written
+std::atomic<uint32_t> keyState[256 / 32];
+
+void Append(const ModInputEvent& event) {
+    uint64_t words[kWords];
+    memcpy(words, &event, sizeof(event));
+
+    const uint64_t position = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[position & kMask];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(position + 1, std::memory_order_release);
+    head.store(position + 1, std::memory_order_release);
+}
+
+void SetKey(uint32_t virtualKey, bool down) {
+    const uint32_t bit = 1u << (virtualKey & 31);
+    if (down) {
+        keyState[(virtualKey & 255) / 32].fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        keyState[(virtualKey & 255) / 32].fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+uint16_t KeyFlags() {
+    uint16_t flags = 0;
+    if (GetKeyState(VK_SHIFT) & 0x8000) flags |= MOD_INPUT_SHIFT;
+    if (GetKeyState(VK_CONTROL) & 0x8000) flags |= MOD_INPUT_CTRL;
+    if (GetKeyState(VK_MENU) & 0x8000) flags |= MOD_INPUT_ALT;
+    return flags;
+}
+
+uint16_t MouseFlags(WPARAM wParam) {
+    uint16_t flags = 0;
+    if (wParam & MK_SHIFT) flags |= MOD_INPUT_SHIFT;
+    if (wParam & MK_CONTROL) flags |= MOD_INPUT_CTRL;
+    if (GetKeyState(VK_MENU) & 0x8000) flags |= MOD_INPUT_ALT;
+    return flags;
+}
+
+} // namespace
+
+namespace InputEvents {
+
+void Publish(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam, bool captured) {
+    ModInputEvent event = {};
+    switch (msg) {
+    case WM_KEYDOWN:
+    case WM_SYSKEYDOWN:
+        event.type = MOD_INPUT_KEY_DOWN;
+        event.code = static_cast<uint32_t>(wParam);
+        event.flags = KeyFlags() | ((lParam & (1 << 30)) ? MOD_INPUT_REPEAT : 0);
+        SetKey(event.code, true);
+        break;
+    case WM_KEYUP:
+    case WM_SYSKEYUP:
+        event.type = MOD_INPUT_KEY_UP;
+        event.code = static_cast<uint32_t>(wParam);
+        event.flags = KeyFlags();
+        SetKey(event.code, false);
+        break;
+    case WM_CHAR:
+        event.type = MOD_INPUT_CHAR;
+        event.code = static_cast<uint32_t>(wParam);
+        break;
+    case WM_MOUSEMOVE:
+        event.type = MOD_INPUT_MOUSE_MOVE;
+        break;
+    case WM_LBUTTONDOWN: case WM_LBUTTONDBLCLK:
+    case WM_RBUTTONDOWN: case WM_RBUTTONDBLCLK:
+    case WM_MBUTTONDOWN: case WM_MBUTTONDBLCLK:
+    case WM_XBUTTONDOWN: case WM_XBUTTONDBLCLK:
+        event.type = MOD_INPUT_MOUSE_DOWN;
+        break;
+    case WM_LBUTTONUP:
+    case WM_RBUTTONUP:
+    case WM_MBUTTONUP:
+    case WM_XBUTTONUP:
+        event.type = MOD_INPUT_MOUSE_UP;
+        break;
+    case WM_MOUSEWHEEL:
+    case WM_MOUSEHWHEEL:
+        event.type = MOD_INPUT_MOUSE_WHEEL;
+        break;
+    case WM_SETFOCUS:
+    case WM_KILLFOCUS:
+        event.type = MOD_INPUT_FOCUS;
+        event.code = msg == WM_SETFOCUS ? 1 : 0;
+        if (msg == WM_KILLFOCUS) {
+            // Key ups go to whichever window has focus then
+            for (std::atomic<uint32_t>& keys : keyState) {
+                keys.store(0, std::memory_order_relaxed);
+            }
+        }
+        break;
+    default:
+        return;
+    }
+
+    if (msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST) {
+        event.flags = MouseFlags(GET_KEYSTATE_WPARAM(wParam));
+        POINT point = {static_cast<int16_t>(LOWORD(lParam)), static_cast<int16_t>(HIWORD(lParam))};
+        if (msg == WM_MOUSEWHEEL || msg == WM_MOUSEHWHEEL) {
+            // Wheel messages carry screen coordinates
+            ScreenToClient(hWnd, &point);
+            event.x = msg == WM_MOUSEHWHEEL ? GET_WHEEL_DELTA_WPARAM(wParam) : 0;
+            event.y = msg == WM_MOUSEWHEEL ? GET_WHEEL_DELTA_WPARAM(wParam) : 0;
+        } else {
+            event.x = point.x;
+            event.y = point.y;
+        }
+
+        if (msg == WM_LBUTTONDOWN || msg == WM_LBUTTONDBLCLK || msg == WM_LBUTTONUP) event.code = 0;
+        if (msg == WM_RBUTTONDOWN || msg == WM_RBUTTONDBLCLK || msg == WM_RBUTTONUP) event.code = 1;
+        if (msg == WM_MBUTTONDOWN || msg == WM_MBUTTONDBLCLK || msg == WM_MBUTTONUP) event.code = 2;
+        if (msg == WM_XBUTTONDOWN || msg == WM_XBUTTONDBLCLK || msg == WM_XBUTTONUP) {
+            event.code = GET_XBUTTON_WPARAM(wParam) == XBUTTON1 ? 3 : 4;
+        }
+    }
+
+    if (captured) {
+        event.flags |= MOD_INPUT_CAPTURED;
+    }
+    event.time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    Append(event);
+}
+
+ModInputCursor Open() {
+    return ModInputCursor{head.load(std::memory_order_acquire)};
+}
+
+size_t Read(ModInputCursor& cursor, ModInputEvent* events, size_t maxEvents, uint64_t* dropped) {
+    uint64_t missed = 0;
+    const uint64_t end = head.load(std::memory_order_acquire);
+    if (end - cursor.position > kCapacity) {
+        missed += end - kCapacity - cursor.position;
+        cursor.position = end - kCapacity;
+    }
+
+    size_t count = 0;
+    while (count < maxEvents && cursor.position < end) {
+        Slot& slot = slots[cursor.position & kMask];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // The writer lapped this reader while it was copying
+        if (sequence != cursor.position + 1 || slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            ++missed;
+            ++cursor.position;
+            continue;
+        }
+        memcpy(&events[count++], words, sizeof(ModInputEvent));
+        ++cursor.position;
+    }
+
+    if (dropped) *dropped = missed;
+    return count;
+}
+
+bool IsKeyDown(uint32_t virtualKey) {
+    if (virtualKey > 255) {
+        return false;
+    }
+    return (keyState[virtualKey / 32].load(std::memory_order_relaxed) >> (virtualKey & 31)) & 1;
+}
+
+} // namespace InputEvents
@@ -6,8 +6,25 @@
 #include "vulkan/vk_platform.h"
 #include "vulkan/vulkan_core.h"
 
+#include "include/api_profiler.h"
+#include "include/capture.h"
+#include "include/draw_stats.h"
 #include "include/layer.h"
+#include "include/layer_config.h"
+#include "include/layer_dispatch.h"
+#include "include/memory_tracker.h"
+#include "include/mod_commands.h"
 #include "include/menu.hpp"
+#include "include/overlay_cache.h"
+#include "include/overlay_geometry.h"
+#include "include/overlay_submit.h"
+#include "include/pointer_paths.h"
+#include "include/proc_table.h"
+#include "include/sampler.h"
+#include "include/shared_metrics.h"
+#include "include/staging_ring.h"
+#include "include/texture_manager.h"
+#include "include/trace.h"
 
 #include <imgui.h>
 #include <imgui_impl_vulkan.h>
@@ -20,6 +37,8 @@
 #include <map>
 #include <algorithm>
 #include <memory>
+#include <atomic>
+#include <chrono>
 
 /**
  * @brief Export macro for Vulkan layer functions
@@ -37,16 +56,6 @@
 std::mutex global_lock;
 using scoped_lock = std::lock_guard<std::mutex>;
 
-/**
- * @brief Extract the dispatch table key from a Vulkan dispatchable object
- * @param inst The Vulkan dispatchable object
- * @return Pointer to use as key in dispatch tables
- */
-template<typename DispatchableType>
-void* GetKey(DispatchableType inst) {
-    return *(void**)inst;
-}
-
 // Forward declarations
 struct QueueData;
 
@@ -63,9 +72,13 @@ struct InstanceData {
  */
 struct DeviceData {
     InstanceData* instance = nullptr;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
     PFN_vkSetDeviceLoaderData set_device_loader_data = nullptr;
     VkLayerDispatchTable vtable = {};
     VkDevice device = VK_NULL_HANDLE;
+    bool dynamic_rendering = false; // dynamicRendering is enabled on the device
+    PFN_vkGetSemaphoreCounterValue get_semaphore_counter_value = nullptr; // Set when timelineSemaphore is enabled
+    PFN_vkWaitSemaphores wait_semaphores = nullptr;                         // Set when timelineSemaphore is enabled
     QueueData* graphic_queue = nullptr;
     std::vector<QueueData*> queues;
 };
@@ -76,6 +89,8 @@ struct DeviceData {
 struct QueueData {
     DeviceData* device;
     VkQueue queue;
+    uint32_t family_index;
+    VkQueueFlags flags; // Capabilities of the queue's family
 };
 
 // Global dispatch tables
@@ -84,6 +99,63 @@ std::map<void*, QueueData> g_queue_data;
 std::map<void*, VkLayerInstanceDispatchTable> instance_dispatch;
 std::map<void*, VkLayerDispatchTable> device_dispatch;
 
+/**
+ * @brief Lock-free copy of a device dispatch table for hot intercepts
+ */
+struct DispatchSlot {
+    std::atomic<void*> key{nullptr};
+    VkLayerDispatchTable table = {};
+};
+
+static DispatchSlot g_dispatch_slots[4];
+
+/**
+ * @brief Publish a device's dispatch table to GetDeviceDispatch
+ * @param key The device key
+ * @param table The next layer's dispatch table
+ */
+static void PublishDispatch(void* key, const VkLayerDispatchTable& table) {
+    for (DispatchSlot& slot : g_dispatch_slots) {
+        // Reserve the slot first so readers never see a half-copied table
+        void* expected = nullptr;
+        if (!slot.key.compare_exchange_strong(expected, &slot, std::memory_order_acquire)) {
+            continue;
+        }
+
+        slot.table = table;
+        slot.key.store(key, std::memory_order_release);
+        return;
+    }
+    // More devices than slots fall back to the locked map
+}
+
+static void RetireDispatch(void* key) {
+    for (DispatchSlot& slot : g_dispatch_slots) {
+        void* expected = key;
+        slot.key.compare_exchange_strong(expected, nullptr, std::memory_order_release);
+    }
+}
+
+const VkLayerDispatchTable& GetDeviceDispatch(void* key) {
+    for (const DispatchSlot& slot : g_dispatch_slots) {
+        if (slot.key.load(std::memory_order_acquire) == key) {
+            return slot.table;
+        }
+    }
+
+    scoped_lock l(global_lock);
+    return device_dispatch[key];
+}
+
+/**
+ * @brief Copy the next layer's instance dispatch table that owns a physical device
+ * @param physicalDevice The physical device
+ */
+static VkLayerInstanceDispatchTable GetInstanceDispatch(VkPhysicalDevice physicalDevice) {
+    scoped_lock l(global_lock);
+    return instance_dispatch[GetKey(physicalDevice)];
+}
+
 /**
  * @brief Get device data for a given Vulkan device
  * @param key The device key
@@ -110,11 +182,15 @@ QueueData* GetQueueData(void* key) {
  * @param device_data The device data
  * @return Pointer to the new queue data
  */
-static QueueData* new_queue_data(VkQueue queue, DeviceData* device_data) {
+static QueueData* new_queue_data(VkQueue queue, DeviceData* device_data, uint32_t family_index, VkQueueFlags flags) {
     QueueData* data = GetQueueData(queue);
     data->device = device_data;
     data->queue = queue;
-    device_data->graphic_queue = data;
+    data->family_index = family_index;
+    data->flags = flags;
+    if (!device_data->graphic_queue && (flags & VK_QUEUE_GRAPHICS_BIT)) {
+        device_data->graphic_queue = data;
+    }
     return data;
 }
 
@@ -124,19 +200,25 @@ static QueueData* new_queue_data(VkQueue queue, DeviceData* device_data) {
  * @param pCreateInfo The device create info
  */
 static void DeviceMapQueues(DeviceData* data, const VkDeviceCreateInfo* pCreateInfo) {
+    const VkLayerInstanceDispatchTable instanceTable = GetInstanceDispatch(data->physical_device);
+    uint32_t familyCount = 0;
+    instanceTable.GetPhysicalDeviceQueueFamilyProperties(data->physical_device, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    instanceTable.GetPhysicalDeviceQueueFamilyProperties(data->physical_device, &familyCount, families.data());
+
     for (uint32_t i = 0; i < pCreateInfo->queueCreateInfoCount; i++) {
+        const uint32_t family = pCreateInfo->pQueueCreateInfos[i].queueFamilyIndex;
+        const VkQueueFlags flags = family < familyCount ? families[family].queueFlags : 0;
         for (uint32_t j = 0; j < pCreateInfo->pQueueCreateInfos[i].queueCount; j++) {
             VkQueue queue;
-            data->vtable.GetDeviceQueue(data->device,
-                pCreateInfo->pQueueCreateInfos[i].queueFamilyIndex,
-                j, &queue);
+            data->vtable.GetDeviceQueue(data->device, family, j, &queue);
 
             VkResult result = data->set_device_loader_data(data->device, queue);
             if (result != VK_SUCCESS) {
                 std::cerr << "[ERROR] Failed to set device loader data: " << result << std::endl;
             }
             
-            data->queues.push_back(new_queue_data(queue, data));
+            data->queues.push_back(new_queue_data(queue, data, family, flags));
         }
     }
 }
@@ -160,6 +242,7 @@ static VkLayerDeviceCreateInfo* get_device_chain_info(const VkDeviceCreateInfo*
 // Vulkan resource handles
 static VkAllocationCallbacks* g_Allocator = nullptr;
 static VkInstance g_Instance = VK_NULL_HANDLE;
+static uint32_t g_InstanceApiVersion = VK_API_VERSION_1_0; // Version the game's instance was created with
 
 // Made external for mod loader access
 VkPhysicalDevice g_PhysicalDevice = VK_NULL_HANDLE;
@@ -170,15 +253,39 @@ VkCommandBuffer g_CommandBuffer = VK_NULL_HANDLE;
 VkDescriptorPool g_DescriptorPool = VK_NULL_HANDLE;
 
 // Queue family information
-static uint32_t g_QueueFamily = static_cast<uint32_t>(-1);
-static std::vector<VkQueueFamilyProperties> g_QueueFamilies;
+static uint32_t g_QueueFamily = static_cast<uint32_t>(-1);      // Graphics family of the mod loader's own device
+static uint32_t g_OverlayQueueFamily = VK_QUEUE_FAMILY_IGNORED; // Family of the game queue overlay work is submitted to
+
+// Exclusive swapchain images presented from a family without graphics are borrowed for the overlay:
+// released to the overlay family before its submit and handed back after it
+struct OwnershipTransfer {
+    VkCommandBuffer Release; // Present family: give the image to the overlay family
+    VkCommandBuffer Acquire; // Present family: take the image back before present
+    VkSemaphore Ready;       // Signalled by the Acquire batch, waited on by present
+};
+static bool g_SwapchainExclusive = true;
+static uint32_t g_PresentQueueFamily = VK_QUEUE_FAMILY_IGNORED; // Family images are handed back to, IGNORED when not transferred
+static VkCommandPool g_TransferPool = VK_NULL_HANDLE;
+static OwnershipTransfer g_Transfers[8] = {};
 
 // Rendering resources
 static VkPipelineCache g_PipelineCache = VK_NULL_HANDLE;
 static uint32_t g_MinImageCount = 1;
 static VkRenderPass g_RenderPass = VK_NULL_HANDLE;
+static bool g_UseDynamicRendering = false; // Chosen once, before the ImGui backend builds its pipeline
+static constexpr VkFormat g_OverlayFormat = VK_FORMAT_B8G8R8A8_UNORM;
 static ImGui_ImplVulkanH_Frame g_Frames[8] = {};
+static VkCommandBuffer g_FrameSecondary[8] = {}; // Overlay draws of a frame whose pass also executes mod secondaries
 static ImGui_ImplVulkanH_FrameSemaphores g_FrameSemaphores[8] = {};
+static uint64_t g_FrameCacheGeneration[8] = {}; // Cache generation a frame's command buffer only composites, 0 if none
+
+// Overlay submit tracking. With timeline semaphores a frame is free once the counter reaches its
+// value; otherwise every frame has its own fence.
+static VkSemaphore g_OverlayTimeline = VK_NULL_HANDLE;
+static uint64_t g_OverlayTimelineValue = 0;    // Last value signalled by an overlay submit
+static uint64_t g_FrameTimelineValue[8] = {};  // Value signalled by each frame's last submit
+static PFN_vkGetSemaphoreCounterValue g_GetSemaphoreCounterValue = nullptr;
+static PFN_vkWaitSemaphores g_WaitSemaphores = nullptr;
 
 // Window information
 static HWND g_Hwnd = nullptr;
@@ -187,7 +294,6 @@ static VkExtent2D g_ImageExtent = {};
 static void CleanupDeviceVulkan( );
 static void CleanupRenderTarget( );
 static VkResult RenderImGui_Vulkan(VkQueue queue, const VkPresentInfoKHR* pPresentInfo);
-static bool DoesQueueSupportGraphic(VkQueue queue, VkQueue* pGraphicQueue);
 
 /**
  * @brief Create a Vulkan device for the mod loader
@@ -312,13 +418,13 @@ static bool CreateDeviceVK() {
             return false;
         }
         
-        g_QueueFamilies.resize(count);
-        vkGetPhysicalDeviceQueueFamilyProperties(g_PhysicalDevice, &count, g_QueueFamilies.data());
+        std::vector<VkQueueFamilyProperties> families(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(g_PhysicalDevice, &count, families.data());
         
         // Find a queue family that supports graphics operations
         g_QueueFamily = static_cast<uint32_t>(-1); // Invalid value
         for (uint32_t i = 0; i < count; ++i) {
-            if (g_QueueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
                 g_QueueFamily = i;
                 break;
             }
@@ -362,12 +468,92 @@ static bool CreateDeviceVK() {
     return true;
 }
 
+/**
+ * @brief Record one half of a queue family ownership transfer of a swapchain image, keeping it in present layout
+ */
+static void RecordOwnershipBarrier(VkCommandBuffer cmd, VkImage image, uint32_t srcFamily, uint32_t dstFamily,
+    VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.srcQueueFamilyIndex = srcFamily;
+    barrier.dstQueueFamilyIndex = dstFamily;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+/**
+ * @brief Create the present family halves of the ownership transfers for every swapchain image
+ * @param device The game's device
+ * @param imageCount Number of frames with a backbuffer
+ */
+static VkResult CreateOwnershipTransfers(VkDevice device, uint32_t imageCount) {
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = g_PresentQueueFamily;
+    VkResult result = vkCreateCommandPool(device, &poolInfo, g_Allocator, &g_TransferPool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    for (uint32_t i = 0; i < imageCount; ++i) {
+        OwnershipTransfer& transfer = g_Transfers[i];
+
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = g_TransferPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 2;
+        VkCommandBuffer buffers[2];
+        result = vkAllocateCommandBuffers(device, &allocInfo, buffers);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        transfer.Release = buffers[0];
+        transfer.Acquire = buffers[1];
+
+        // A frame's Acquire batch may still be pending when the image comes around again
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+
+        vkBeginCommandBuffer(transfer.Release, &beginInfo);
+        RecordOwnershipBarrier(transfer.Release, g_Frames[i].Backbuffer, g_PresentQueueFamily, g_OverlayQueueFamily,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+        result = vkEndCommandBuffer(transfer.Release);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        vkBeginCommandBuffer(transfer.Acquire, &beginInfo);
+        RecordOwnershipBarrier(transfer.Acquire, g_Frames[i].Backbuffer, g_OverlayQueueFamily, g_PresentQueueFamily,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+        result = vkEndCommandBuffer(transfer.Acquire);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        VkSemaphoreCreateInfo semaphoreInfo = {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        result = vkCreateSemaphore(device, &semaphoreInfo, g_Allocator, &transfer.Ready);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+    return VK_SUCCESS;
+}
+
 /**
  * @brief Create render target resources for ImGui rendering
  * @param device The Vulkan device
  * @param swapchain The swapchain to create render targets for
  */
 static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
+    TSML_TRACE_SCOPE("CreateRenderTarget");
     VkResult result = VK_SUCCESS;
     
     // Get swapchain images
@@ -406,7 +592,7 @@ static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
             VkCommandPoolCreateInfo info = {};
             info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
             info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-            info.queueFamilyIndex = g_QueueFamily;
+            info.queueFamilyIndex = g_OverlayQueueFamily;
 
             result = vkCreateCommandPool(device, &info, g_Allocator, &fd->CommandPool);
             if (result != VK_SUCCESS) {
@@ -428,10 +614,17 @@ static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
                 std::cerr << "[ERROR] Failed to allocate command buffer: " << result << std::endl;
                 return;
             }
+
+            info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            result = vkAllocateCommandBuffers(device, &info, &g_FrameSecondary[i]);
+            if (result != VK_SUCCESS) {
+                std::cerr << "[ERROR] Failed to allocate secondary command buffer: " << result << std::endl;
+                return;
+            }
         }
         
-        // Create fence
-        {
+        // Create fence, the timeline semaphore tracks the frame instead when available
+        if (g_WaitSemaphores == nullptr) {
             VkFenceCreateInfo info = {};
             info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
             info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
@@ -462,10 +655,39 @@ static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
         }
     }
 
-    // Create the Render Pass
-    if (g_RenderPass == VK_NULL_HANDLE) {
+    // Pre-record the ownership transfers on the present family, they are the same every frame
+    if (g_PresentQueueFamily != VK_QUEUE_FAMILY_IGNORED) {
+        result = CreateOwnershipTransfers(device, uImageCount);
+        if (result != VK_SUCCESS) {
+            std::cerr << "[ERROR] Failed to create ownership transfers: " << result << std::endl;
+            return;
+        }
+    }
+
+    // Create the timeline semaphore all overlay submits signal
+    if (g_WaitSemaphores != nullptr) {
+        VkSemaphoreTypeCreateInfo type = {};
+        type.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        type.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        type.initialValue = 0;
+
+        VkSemaphoreCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        info.pNext = &type;
+
+        result = vkCreateSemaphore(device, &info, g_Allocator, &g_OverlayTimeline);
+        if (result != VK_SUCCESS) {
+            std::cerr << "[ERROR] Failed to create timeline semaphore: " << result << std::endl;
+            return;
+        }
+        g_OverlayTimelineValue = 0;
+        memset(g_FrameTimelineValue, 0, sizeof(g_FrameTimelineValue));
+    }
+
+    // Create the Render Pass, not needed when rendering dynamically
+    if (g_RenderPass == VK_NULL_HANDLE && !g_UseDynamicRendering) {
         VkAttachmentDescription attachment = {};
-        attachment.format = VK_FORMAT_B8G8R8A8_UNORM;
+        attachment.format = g_OverlayFormat;
         attachment.samples = VK_SAMPLE_COUNT_1_BIT;
         attachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -502,7 +724,7 @@ static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
         VkImageViewCreateInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        info.format = VK_FORMAT_B8G8R8A8_UNORM;
+        info.format = g_OverlayFormat;
         info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         info.subresourceRange.baseMipLevel = 0;
         info.subresourceRange.levelCount = 1;
@@ -522,7 +744,7 @@ static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
     }
 
     // Create Framebuffers
-    {
+    if (!g_UseDynamicRendering) {
         // Default to 4K resolution if we don't have valid dimensions
         const uint32_t width = (g_ImageExtent.width > 0) ? g_ImageExtent.width : 3840;
         const uint32_t height = (g_ImageExtent.height > 0) ? g_ImageExtent.height : 2160;
@@ -578,6 +800,22 @@ static void CreateRenderTarget(VkDevice device, VkSwapchainKHR swapchain) {
             return;
         }
     }
+
+    if (LayerConfig::IsEnabled(FEATURE_OVERLAY_CACHE)) {
+        const VkExtent2D extent = {
+            (g_ImageExtent.width > 0) ? g_ImageExtent.width : 3840,
+            (g_ImageExtent.height > 0) ? g_ImageExtent.height : 2160,
+        };
+        OverlayCache::Create(device, g_RenderPass, g_DescriptorPool, extent);
+    }
+
+    {
+        const VkExtent2D extent = {
+            (g_ImageExtent.width > 0) ? g_ImageExtent.width : 3840,
+            (g_ImageExtent.height > 0) ? g_ImageExtent.height : 2160,
+        };
+        ModCommands::OnRenderTarget(device, g_OverlayQueueFamily, g_RenderPass, g_OverlayFormat, extent);
+    }
 }
 
 VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_CreateInstance(
@@ -608,11 +846,26 @@ VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_CreateInstance(
 
   VkResult ret = createFunc(pCreateInfo, pAllocator, pInstance);
 
+  if (pCreateInfo->pApplicationInfo && pCreateInfo->pApplicationInfo->apiVersion)
+    g_InstanceApiVersion = pCreateInfo->pApplicationInfo->apiVersion;
+
   // fetch our own dispatch table for the functions we need, into the next layer
-  VkLayerInstanceDispatchTable dispatchTable;
+  VkLayerInstanceDispatchTable dispatchTable = {};
   dispatchTable.GetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)gpa(*pInstance, "vkGetInstanceProcAddr");
   dispatchTable.DestroyInstance = (PFN_vkDestroyInstance)gpa(*pInstance, "vkDestroyInstance");
-  //dispatchTable.EnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)gpa(*pInstance, "vkEnumerateDeviceExtensionProperties");
+  dispatchTable.EnumerateDeviceExtensionProperties = (PFN_vkEnumerateDeviceExtensionProperties)gpa(*pInstance, "vkEnumerateDeviceExtensionProperties");
+  dispatchTable.GetPhysicalDeviceMemoryProperties = (PFN_vkGetPhysicalDeviceMemoryProperties)gpa(*pInstance, "vkGetPhysicalDeviceMemoryProperties");
+  dispatchTable.GetPhysicalDeviceMemoryProperties2 = (PFN_vkGetPhysicalDeviceMemoryProperties2)gpa(*pInstance, "vkGetPhysicalDeviceMemoryProperties2");
+  // Vulkan 1.0 instances may still expose it through VK_KHR_get_physical_device_properties2
+  if (!dispatchTable.GetPhysicalDeviceMemoryProperties2)
+    dispatchTable.GetPhysicalDeviceMemoryProperties2 = (PFN_vkGetPhysicalDeviceMemoryProperties2)gpa(*pInstance, "vkGetPhysicalDeviceMemoryProperties2KHR");
+  dispatchTable.GetPhysicalDeviceProperties = (PFN_vkGetPhysicalDeviceProperties)gpa(*pInstance, "vkGetPhysicalDeviceProperties");
+  dispatchTable.GetPhysicalDeviceQueueFamilyProperties = (PFN_vkGetPhysicalDeviceQueueFamilyProperties)gpa(*pInstance, "vkGetPhysicalDeviceQueueFamilyProperties");
+  dispatchTable.GetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)gpa(*pInstance, "vkGetPhysicalDeviceFeatures2");
+  if (!dispatchTable.GetPhysicalDeviceFeatures2)
+    dispatchTable.GetPhysicalDeviceFeatures2 = (PFN_vkGetPhysicalDeviceFeatures2)gpa(*pInstance, "vkGetPhysicalDeviceFeatures2KHR");
+  dispatchTable.GetPhysicalDeviceSurfaceCapabilitiesKHR = (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)gpa(*pInstance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR");
+  dispatchTable.GetPhysicalDeviceSurfacePresentModesKHR = (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)gpa(*pInstance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
 
   // store the table by key
   {
@@ -628,6 +881,88 @@ VK_LAYER_EXPORT void VKAPI_CALL ModLoader_DestroyInstance(VkInstance instance, c
   instance_dispatch.erase(GetKey(instance));
 }
 
+/**
+ * @brief Query a feature struct of a physical device, if the instance and device are at least a core version
+ * @param physicalDevice The physical device
+ * @param apiVersion Core version the feature belongs to
+ * @param feature Feature struct to fill, with sType set
+ * @return false when the version is not available to both and feature was left untouched
+ */
+static bool QueryCoreFeature(VkPhysicalDevice physicalDevice, uint32_t apiVersion, void* feature) {
+  const VkLayerInstanceDispatchTable instanceTable = GetInstanceDispatch(physicalDevice);
+  if (g_InstanceApiVersion < apiVersion || !instanceTable.GetPhysicalDeviceProperties || !instanceTable.GetPhysicalDeviceFeatures2)
+    return false;
+
+  VkPhysicalDeviceProperties properties;
+  instanceTable.GetPhysicalDeviceProperties(physicalDevice, &properties);
+  if (properties.apiVersion < apiVersion)
+    return false;
+
+  VkPhysicalDeviceFeatures2 features = {};
+  features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  features.pNext = feature;
+  instanceTable.GetPhysicalDeviceFeatures2(physicalDevice, &features);
+  return true;
+}
+
+/**
+ * @brief Find out whether the device will have dynamicRendering, requesting it when the game did not
+ * @param physicalDevice The physical device the device is created on
+ * @param info Copy of the game's create info; the feature struct is chained in front when added
+ * @param feature Storage for the added feature struct, must outlive the vkCreateDevice call
+ * @return Whether dynamicRendering will be enabled
+ */
+static bool EnableDynamicRendering(VkPhysicalDevice physicalDevice, VkDeviceCreateInfo& info, VkPhysicalDeviceDynamicRenderingFeatures& feature) {
+  vk_foreach_struct(it, info.pNext) {
+    if (it->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES)
+      return ((VkPhysicalDeviceVulkan13Features*)it)->dynamicRendering;
+    if (it->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES)
+      return ((VkPhysicalDeviceDynamicRenderingFeatures*)it)->dynamicRendering;
+  }
+
+  // Only as a core 1.3 feature can it be added without enabling extensions the game did not ask for
+  VkPhysicalDeviceDynamicRenderingFeatures supported = {};
+  supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+  if (!QueryCoreFeature(physicalDevice, VK_API_VERSION_1_3, &supported) || !supported.dynamicRendering)
+    return false;
+
+  feature = {};
+  feature.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+  feature.dynamicRendering = VK_TRUE;
+  feature.pNext = const_cast<void*>(info.pNext);
+  info.pNext = &feature;
+  return true;
+}
+
+/**
+ * @brief Find out whether the device will have timelineSemaphore, requesting it when the game did not
+ * @param physicalDevice The physical device the device is created on
+ * @param info Copy of the game's create info; the feature struct is chained in front when added
+ * @param feature Storage for the added feature struct, must outlive the vkCreateDevice call
+ * @return Whether timelineSemaphore will be enabled
+ */
+static bool EnableTimelineSemaphore(VkPhysicalDevice physicalDevice, VkDeviceCreateInfo& info, VkPhysicalDeviceTimelineSemaphoreFeatures& feature) {
+  vk_foreach_struct(it, info.pNext) {
+    if (it->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES)
+      return ((VkPhysicalDeviceVulkan12Features*)it)->timelineSemaphore;
+    if (it->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES)
+      return ((VkPhysicalDeviceTimelineSemaphoreFeatures*)it)->timelineSemaphore;
+  }
+
+  // Core since 1.2, so no extension has to be enabled behind the game's back
+  VkPhysicalDeviceTimelineSemaphoreFeatures supported = {};
+  supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+  if (!QueryCoreFeature(physicalDevice, VK_API_VERSION_1_2, &supported) || !supported.timelineSemaphore)
+    return false;
+
+  feature = {};
+  feature.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+  feature.timelineSemaphore = VK_TRUE;
+  feature.pNext = const_cast<void*>(info.pNext);
+  info.pNext = &feature;
+  return true;
+}
+
 VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_CreateDevice(
     VkPhysicalDevice                            physicalDevice,
     const VkDeviceCreateInfo*                   pCreateInfo,
@@ -653,24 +988,57 @@ VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_CreateDevice(
   PFN_vkGetInstanceProcAddr gipa = layerCreateInfo->u.pLayerInfo->pfnNextGetInstanceProcAddr;
   PFN_vkGetDeviceProcAddr gdpa = layerCreateInfo->u.pLayerInfo->pfnNextGetDeviceProcAddr;
   // move chain on for next layer
-  layerCreateInfo->u.pLayerInfo = layerCreateInfo->u.pLayerInfo->pNext;
+  VkLayerDeviceLink* nextLink = layerCreateInfo->u.pLayerInfo->pNext;
+  layerCreateInfo->u.pLayerInfo = nextLink;
 
   PFN_vkCreateDevice createFunc = (PFN_vkCreateDevice)gipa(VK_NULL_HANDLE, "vkCreateDevice");
 
-  VkResult ret = createFunc(physicalDevice, pCreateInfo, pAllocator, pDevice);
+  VkDeviceCreateInfo createInfo = *pCreateInfo;
+  VkPhysicalDeviceDynamicRenderingFeatures dynamicRendering = {};
+  VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphore = {};
+  bool dynamicRenderingEnabled = LayerConfig::IsEnabled(FEATURE_OVERLAY) &&
+    EnableDynamicRendering(physicalDevice, createInfo, dynamicRendering);
+  bool timelineSemaphoreEnabled = LayerConfig::IsEnabled(FEATURE_OVERLAY) &&
+    EnableTimelineSemaphore(physicalDevice, createInfo, timelineSemaphore);
+
+  VkResult ret = createFunc(physicalDevice, &createInfo, pAllocator, pDevice);
+  if (ret != VK_SUCCESS && createInfo.pNext != pCreateInfo->pNext) {
+    // Never let the overlay cost the game its device; the next layers advanced the link, rewind it
+    std::cerr << "[ERROR] Device creation with overlay features failed: " << ret << ", retrying without" << std::endl;
+    layerCreateInfo->u.pLayerInfo = nextLink;
+    ret = createFunc(physicalDevice, pCreateInfo, pAllocator, pDevice);
+    dynamicRenderingEnabled = false;
+    timelineSemaphoreEnabled = false;
+  }
+  if (ret != VK_SUCCESS) {
+    return ret;
+  }
 
   
-  // fetch our own dispatch table for the functions we need, into the next layer
-  VkLayerDispatchTable dispatchTable;
-  dispatchTable.GetDeviceProcAddr = (PFN_vkGetDeviceProcAddr)gdpa(*pDevice, "vkGetDeviceProcAddr");
-  dispatchTable.DestroyDevice = (PFN_vkDestroyDevice)gdpa(*pDevice, "vkDestroyDevice");
-  dispatchTable.QueuePresentKHR = (PFN_vkQueuePresentKHR)gdpa(*pDevice, "vkQueuePresentKHR");
-  dispatchTable.CreateSwapchainKHR = (PFN_vkCreateSwapchainKHR)gdpa(*pDevice, "vkCreateSwapchainKHR");
- 
-  dispatchTable.GetDeviceQueue = (PFN_vkGetDeviceQueue)gdpa(*pDevice, "vkGetDeviceQueue");
+  // fetch the full dispatch table of the next layer
+  VkLayerDispatchTable dispatchTable = {};
+#define VK_DEVICE_ENTRYPOINT(name) dispatchTable.name = (PFN_vk##name)gdpa(*pDevice, "vk" #name);
+#include "include/vk_device_entrypoints.h"
+
+  // route our own calls through the profiler so they are counted as well
+  if (LayerConfig::IsEnabled(FEATURE_PROFILER)) ApiProfiler::OnCreateDevice(*pDevice, dispatchTable);
 
   GetDeviceData(*pDevice)->vtable = dispatchTable;
   GetDeviceData(*pDevice)->device = *pDevice;
+  GetDeviceData(*pDevice)->physical_device = physicalDevice;
+  GetDeviceData(*pDevice)->dynamic_rendering = dynamicRenderingEnabled &&
+    (dispatchTable.CmdBeginRendering || dispatchTable.CmdBeginRenderingKHR);
+  if (timelineSemaphoreEnabled) {
+    // Games on 1.1 enable the feature through VK_KHR_timeline_semaphore and only have the KHR entry points
+    DeviceData* data = GetDeviceData(*pDevice);
+    data->get_semaphore_counter_value = dispatchTable.GetSemaphoreCounterValue ?
+      dispatchTable.GetSemaphoreCounterValue : dispatchTable.GetSemaphoreCounterValueKHR;
+    data->wait_semaphores = dispatchTable.WaitSemaphores ? dispatchTable.WaitSemaphores : dispatchTable.WaitSemaphoresKHR;
+    if (!data->get_semaphore_counter_value || !data->wait_semaphores) {
+      data->get_semaphore_counter_value = nullptr;
+      data->wait_semaphores = nullptr;
+    }
+  }
 
 
   VkLayerDeviceCreateInfo *load_data_info = get_device_chain_info(pCreateInfo, VK_LOADER_DATA_CALLBACK);
@@ -683,28 +1051,160 @@ VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_CreateDevice(
     scoped_lock l(global_lock);
     device_dispatch[GetKey(*pDevice)] = dispatchTable;
   }
+  PublishDispatch(GetKey(*pDevice), dispatchTable);
+
+  if (LayerConfig::IsEnabled(FEATURE_MEMTRACKER)) {
+    MemoryTracker::OnCreateDevice(physicalDevice, GetInstanceDispatch(physicalDevice));
+  }
+
+  if (LayerConfig::IsEnabled(FEATURE_CAPTURE) || LayerConfig::IsEnabled(FEATURE_OVERLAY)) {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    GetInstanceDispatch(physicalDevice).GetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    if (LayerConfig::IsEnabled(FEATURE_CAPTURE)) Capture::OnCreateDevice(*pDevice, memoryProperties);
+    if (LayerConfig::IsEnabled(FEATURE_OVERLAY_CACHE)) OverlayCache::OnCreateDevice(memoryProperties);
+    if (LayerConfig::IsEnabled(FEATURE_OVERLAY)) {
+      VkPhysicalDeviceProperties properties;
+      GetInstanceDispatch(physicalDevice).GetPhysicalDeviceProperties(physicalDevice, &properties);
+      StagingRing::OnCreateDevice(memoryProperties, properties.limits.optimalBufferCopyOffsetAlignment);
+      TextureManager::OnCreateDevice(memoryProperties);
+    }
+  }
 
   return VK_SUCCESS;
 }
 
 VK_LAYER_EXPORT void VKAPI_CALL ModLoader_DestroyDevice(VkDevice device, const VkAllocationCallbacks* pAllocator)
 {
+  if (LayerConfig::IsEnabled(FEATURE_PROFILER)) ApiProfiler::OnDestroyDevice(device);
+  if (LayerConfig::IsEnabled(FEATURE_CAPTURE)) Capture::OnDestroyDevice(device);
+  if (LayerConfig::IsEnabled(FEATURE_OVERLAY)) StagingRing::OnDestroyDevice(device);
+  if (LayerConfig::IsEnabled(FEATURE_OVERLAY)) ModCommands::OnDestroyDevice(device);
+  if (LayerConfig::IsEnabled(FEATURE_OVERLAY)) TextureManager::OnDestroyDevice(device);
+  RetireDispatch(GetKey(device));
+
   scoped_lock l(global_lock);
   device_dispatch.erase(GetKey(device));
 }
 
 VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo){
-  if(!g_Hwnd) return device_dispatch[GetKey(queue)].QueuePresentKHR(queue, pPresentInfo);
-  
-  return RenderImGui_Vulkan(queue, pPresentInfo);
+  Sampler::WatchCurrentThread("Present thread");
+  if (LayerConfig::IsEnabled(FEATURE_PROFILER)) ApiProfiler::EndFrame();
+  if (LayerConfig::IsEnabled(FEATURE_DRAWSTATS)) DrawStats::EndFrame();
+  if (LayerConfig::IsEnabled(FEATURE_MEMTRACKER)) MemoryTracker::EndFrame();
+
+  // Also intercepted for the statistics above and the metrics, which do not need the overlay
+  if(!g_Hwnd || !LayerConfig::IsEnabled(FEATURE_OVERLAY)) {
+    if (LayerConfig::IsEnabled(FEATURE_METRICS)) SharedMetrics::EndFrame(0.0f);
+    return device_dispatch[GetKey(queue)].QueuePresentKHR(queue, pPresentInfo);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const VkResult result = RenderImGui_Vulkan(queue, pPresentInfo);
+  if (LayerConfig::IsEnabled(FEATURE_METRICS)) {
+    SharedMetrics::EndFrame(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+  }
+  return result;
+}
+
+/**
+ * @brief Apply the configured present mode and image count where the surface allows them
+ * @param device The device creating the swapchain
+ * @param info Copy of the game's create info, modified in place
+ * @return Whether info now differs from the game's
+ */
+static bool ApplySwapchainOverrides(VkDevice device, VkSwapchainCreateInfoKHR& info) {
+  const SwapchainOverrides& overrides = LayerConfig::Get().swapchain;
+  if (overrides.presentMode < 0 && overrides.minImageCount == 0) return false;
+  bool modified = false;
+
+  VkPhysicalDevice physicalDevice = GetDeviceData(device)->physical_device;
+  VkLayerInstanceDispatchTable instanceTable = GetInstanceDispatch(physicalDevice);
+
+  if (overrides.presentMode >= 0 && instanceTable.GetPhysicalDeviceSurfacePresentModesKHR) {
+    const VkPresentModeKHR wanted = static_cast<VkPresentModeKHR>(overrides.presentMode);
+    uint32_t count = 0;
+    instanceTable.GetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, info.surface, &count, nullptr);
+    std::vector<VkPresentModeKHR> modes(count);
+    VkResult result = instanceTable.GetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, info.surface, &count, modes.data());
+
+    if (result == VK_SUCCESS && std::find(modes.begin(), modes.begin() + count, wanted) != modes.begin() + count) {
+      std::cout << "[+] Swapchain present mode " << info.presentMode << " -> " << wanted << std::endl;
+      modified |= info.presentMode != wanted;
+      info.presentMode = wanted;
+    } else {
+      std::cerr << "[ERROR] Present mode " << wanted << " not supported by the surface, keeping " << info.presentMode << std::endl;
+    }
+  }
+
+  if (overrides.minImageCount > 0 && instanceTable.GetPhysicalDeviceSurfaceCapabilitiesKHR) {
+    VkSurfaceCapabilitiesKHR caps = {};
+    if (instanceTable.GetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, info.surface, &caps) == VK_SUCCESS) {
+      // The overlay keeps per-image resources for at most 8 images
+      const uint32_t maxCount = caps.maxImageCount ? std::min(caps.maxImageCount, 8u) : 8u;
+      if (caps.minImageCount > maxCount) {
+        std::cerr << "[ERROR] Surface needs at least " << caps.minImageCount << " images, more than "
+                  << maxCount << "; keeping " << info.minImageCount << " images" << std::endl;
+      } else {
+        const uint32_t count = std::clamp(overrides.minImageCount, caps.minImageCount, maxCount);
+        std::cout << "[+] Swapchain image count " << info.minImageCount << " -> " << count << std::endl;
+        modified |= info.minImageCount != count;
+        info.minImageCount = count;
+      }
+    } else {
+      std::cerr << "[ERROR] Failed to query surface capabilities, keeping " << info.minImageCount << " images" << std::endl;
+    }
+  }
+  return modified;
+}
+
+/**
+ * @brief Add transfer-source usage to the swapchain images so screenshots can copy them
+ * @param device The device creating the swapchain
+ * @param info Copy of the game's create info, modified in place
+ * @return Whether the images will be readable
+ */
+static bool EnableSwapchainReadback(VkDevice device, VkSwapchainCreateInfoKHR& info) {
+  if (info.imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) return true;
+
+  VkPhysicalDevice physicalDevice = GetDeviceData(device)->physical_device;
+  VkLayerInstanceDispatchTable instanceTable = GetInstanceDispatch(physicalDevice);
+  if (!instanceTable.GetPhysicalDeviceSurfaceCapabilitiesKHR) return false;
+
+  VkSurfaceCapabilitiesKHR caps = {};
+  if (instanceTable.GetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, info.surface, &caps) != VK_SUCCESS ||
+      !(caps.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)) {
+    return false;
+  }
+
+  info.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+  return true;
 }
 
 VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_CreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain) {
 
-  CleanupRenderTarget( );
-  g_ImageExtent = pCreateInfo->imageExtent;
+  if (LayerConfig::IsEnabled(FEATURE_OVERLAY)) {
+    CleanupRenderTarget( );
+    g_ImageExtent = pCreateInfo->imageExtent;
+    g_SwapchainExclusive = pCreateInfo->imageSharingMode == VK_SHARING_MODE_EXCLUSIVE;
+  }
 
-  return device_dispatch[GetKey(device)].CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
+  VkSwapchainCreateInfoKHR createInfo = *pCreateInfo;
+  bool modified = ApplySwapchainOverrides(device, createInfo);
+  bool readable = LayerConfig::IsEnabled(FEATURE_CAPTURE) && EnableSwapchainReadback(device, createInfo);
+  modified |= createInfo.imageUsage != pCreateInfo->imageUsage;
+
+  VkResult result = device_dispatch[GetKey(device)].CreateSwapchainKHR(device, &createInfo, pAllocator, pSwapchain);
+  if (result != VK_SUCCESS && modified) {
+    // Never let an override cost the game its swapchain
+    std::cerr << "[ERROR] Swapchain creation with overrides failed: " << result << ", retrying without" << std::endl;
+    result = device_dispatch[GetKey(device)].CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
+    readable = (pCreateInfo->imageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+  }
+
+  if (result == VK_SUCCESS && LayerConfig::IsEnabled(FEATURE_CAPTURE)) {
+    Capture::OnCreateSwapchain(pCreateInfo->imageFormat, readable);
+  }
+  return result;
 }
 
 VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_AcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout, VkSemaphore semaphore, VkFence fence, uint32_t* pImageIndex) {
@@ -714,17 +1214,109 @@ VK_LAYER_EXPORT VkResult VKAPI_CALL ModLoader_AcquireNextImageKHR(VkDevice devic
 
   return device_dispatch[GetKey(device)].AcquireNextImageKHR(device, swapchain, timeout, semaphore, fence, pImageIndex);
 }
-#define GETPROCADDR(func) if(!strcmp(pName, "vk" #func)) return (PFN_vkVoidFunction)&ModLoader_##func;
+VK_LAYER_EXPORT PFN_vkVoidFunction VKAPI_CALL ModLoader_GetDeviceProcAddr(VkDevice device, const char *pName);
+VK_LAYER_EXPORT PFN_vkVoidFunction VKAPI_CALL ModLoader_GetInstanceProcAddr(VkInstance instance, const char *pName);
+
+/**
+ * @brief Lookups an intercepted entry point may be returned from
+ */
+enum InterceptScope : uint32_t {
+  SCOPE_INSTANCE = 1u << 0,
+  SCOPE_DEVICE   = 1u << 1,
+};
+
+// Features that do their per-frame work in vkQueuePresentKHR
+static constexpr uint32_t kPresentFeatures =
+    FEATURE_OVERLAY | FEATURE_PROFILER | FEATURE_DRAWSTATS | FEATURE_MEMTRACKER | FEATURE_METRICS;
+
+// Features that change or need to know about the game's swapchains
+static constexpr uint32_t kSwapchainFeatures = FEATURE_OVERLAY | FEATURE_CAPTURE | FEATURE_SWAPCHAIN_OVERRIDES;
+
+// Entry points we intercept: name, features any of which enables it, lookup scopes
+#define MODLOADER_INTERCEPTS(X) \
+  X(GetInstanceProcAddr, FEATURE_NONE,    SCOPE_INSTANCE) \
+  X(CreateInstance,      FEATURE_NONE,    SCOPE_INSTANCE) \
+  X(DestroyInstance,     FEATURE_NONE,    SCOPE_INSTANCE) \
+  X(GetDeviceProcAddr,   FEATURE_NONE,    SCOPE_INSTANCE | SCOPE_DEVICE) \
+  X(CreateDevice,        FEATURE_NONE,    SCOPE_INSTANCE | SCOPE_DEVICE) \
+  X(DestroyDevice,       FEATURE_NONE,    SCOPE_INSTANCE | SCOPE_DEVICE) \
+  X(QueuePresentKHR,     kPresentFeatures, SCOPE_DEVICE) \
+  X(CreateSwapchainKHR,  kSwapchainFeatures, SCOPE_DEVICE) \
+  X(CmdDraw,                        FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndexed,                 FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndirect,                FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndexedIndirect,         FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndirectCount,           FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndirectCountKHR,        FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndexedIndirectCount,    FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDrawIndexedIndirectCountKHR, FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDispatch,                    FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDispatchBase,                FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDispatchBaseKHR,             FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdDispatchIndirect,            FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdBeginRenderPass,             FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdBeginRenderPass2,            FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdBeginRenderPass2KHR,         FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdBeginRendering,              FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(CmdBeginRenderingKHR,           FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(QueueSubmit,                    FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(QueueSubmit2,                   FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(QueueSubmit2KHR,                FEATURE_DRAWSTATS, SCOPE_DEVICE) \
+  X(AllocateMemory,                 FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(FreeMemory,                     FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(CreateBuffer,                   FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(DestroyBuffer,                  FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(CreateImage,                    FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(DestroyImage,                   FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(BindBufferMemory,               FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(BindImageMemory,                FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(BindBufferMemory2,              FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(BindBufferMemory2KHR,           FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(BindImageMemory2,               FEATURE_MEMTRACKER, SCOPE_DEVICE) \
+  X(BindImageMemory2KHR,            FEATURE_MEMTRACKER, SCOPE_DEVICE)
+
+#define INTERCEPT_NAME(func, features, scopes) proc_table::ProcName{"vk" #func, features, scopes},
+#define INTERCEPT_PROC(func, features, scopes) reinterpret_cast<PFN_vkVoidFunction>(&ModLoader_##func),
+
+static constexpr proc_table::PerfectHash kInterceptTable(std::to_array({MODLOADER_INTERCEPTS(INTERCEPT_NAME)}));
+static const PFN_vkVoidFunction kInterceptProcs[] = {MODLOADER_INTERCEPTS(INTERCEPT_PROC)};
+
+static_assert(kInterceptTable.Find("vkQueuePresentKHR") >= 0, "Intercept table is missing vkQueuePresentKHR");
+static_assert(kInterceptTable.Find("vkQueueWaitIdle") < 0, "Intercept table returned an unknown entry point");
+
+#undef INTERCEPT_NAME
+#undef INTERCEPT_PROC
+
+/**
+ * @brief Resolve an entry point against the intercept table
+ * @param pName The entry point name
+ * @param scope The lookup being served
+ * @return Our implementation, or nullptr when it is not intercepted or its feature is disabled
+ */
+static PFN_vkVoidFunction FindIntercept(const char* pName, InterceptScope scope) {
+  const int index = kInterceptTable.Find(pName);
+  if (index < 0) return nullptr;
+
+  const proc_table::ProcName& entry = kInterceptTable[index];
+  if (!(entry.scopes & scope)) return nullptr;
+  if (entry.features != FEATURE_NONE && !LayerConfig::IsAnyEnabled(entry.features)) return nullptr;
+
+  return kInterceptProcs[index];
+}
 
 VK_LAYER_EXPORT PFN_vkVoidFunction VKAPI_CALL ModLoader_GetDeviceProcAddr(VkDevice device, const char *pName)
 {
-  // device chain functions we intercept
-  GETPROCADDR(GetDeviceProcAddr);
-  GETPROCADDR(CreateDevice);
-  GETPROCADDR(DestroyDevice);
-  GETPROCADDR(QueuePresentKHR);
-  GETPROCADDR(CreateSwapchainKHR);
-  
+  // device chain functions we intercept, unless the driver below does not have them
+  if (PFN_vkVoidFunction proc = FindIntercept(pName, SCOPE_DEVICE)) {
+    const VkLayerDispatchTable& next = GetDeviceDispatch(GetKey(device));
+    return !next.GetDeviceProcAddr || next.GetDeviceProcAddr(device, pName) ? proc : nullptr;
+  }
+
+  // everything else is wrapped only while profiling
+  if (LayerConfig::IsEnabled(FEATURE_PROFILER)) {
+    if (PFN_vkVoidFunction proc = ApiProfiler::GetProcAddr(device, pName)) return proc;
+  }
+
   {
     scoped_lock l(global_lock);
     return device_dispatch[GetKey(device)].GetDeviceProcAddr(device, pName);
@@ -733,15 +1325,8 @@ VK_LAYER_EXPORT PFN_vkVoidFunction VKAPI_CALL ModLoader_GetDeviceProcAddr(VkDevi
 
 VK_LAYER_EXPORT PFN_vkVoidFunction VKAPI_CALL ModLoader_GetInstanceProcAddr(VkInstance instance, const char *pName)
 {
-  // instance chain functions we intercept
-  GETPROCADDR(GetInstanceProcAddr);
-  GETPROCADDR(CreateInstance);
-  GETPROCADDR(DestroyInstance);
-  
-  // device chain functions we intercept
-  GETPROCADDR(GetDeviceProcAddr);
-  GETPROCADDR(CreateDevice);
-  GETPROCADDR(DestroyDevice);
+  // instance and device chain functions we intercept
+  if (PFN_vkVoidFunction proc = FindIntercept(pName, SCOPE_INSTANCE)) return proc;
 
   {
     scoped_lock l(global_lock);
@@ -767,6 +1352,18 @@ static void CleanupRenderTarget() {
         return;
     }
     
+    // Wait for the last overlay submit before any frame resource goes away
+    if (g_OverlayTimeline != VK_NULL_HANDLE) {
+        VkSemaphoreWaitInfo waitInfo = {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &g_OverlayTimeline;
+        waitInfo.pValues = &g_OverlayTimelineValue;
+        g_WaitSemaphores(g_Device, &waitInfo, 1000000000); // 1 second timeout
+        vkDestroySemaphore(g_Device, g_OverlayTimeline, g_Allocator);
+        g_OverlayTimeline = VK_NULL_HANDLE;
+    }
+
     // Clean up frame resources
     for (uint32_t i = 0; i < RTL_NUMBER_OF(g_Frames); ++i) {
         // Wait for any pending operations to complete
@@ -781,6 +1378,10 @@ static void CleanupRenderTarget() {
             vkFreeCommandBuffers(g_Device, g_Frames[i].CommandPool, 1, &g_Frames[i].CommandBuffer);
             g_Frames[i].CommandBuffer = VK_NULL_HANDLE;
         }
+        if (g_FrameSecondary[i] != VK_NULL_HANDLE && g_Frames[i].CommandPool != VK_NULL_HANDLE) {
+            vkFreeCommandBuffers(g_Device, g_Frames[i].CommandPool, 1, &g_FrameSecondary[i]);
+            g_FrameSecondary[i] = VK_NULL_HANDLE;
+        }
         
         // Destroy command pools
         if (g_Frames[i].CommandPool != VK_NULL_HANDLE) {
@@ -802,6 +1403,22 @@ static void CleanupRenderTarget() {
         
         // Note: We don't destroy the backbuffer images as they are owned by the swapchain
         g_Frames[i].Backbuffer = VK_NULL_HANDLE;
+        g_FrameCacheGeneration[i] = 0;
+    }
+
+    // Every frame fence has been waited on above
+    OverlayCache::Destroy(g_Device);
+
+    // The last batch of a transferred frame is the Acquire batch, covered by the same wait
+    if (g_TransferPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(g_Device, g_TransferPool, g_Allocator);
+        g_TransferPool = VK_NULL_HANDLE;
+    }
+    for (OwnershipTransfer& transfer : g_Transfers) {
+        if (transfer.Ready != VK_NULL_HANDLE) {
+            vkDestroySemaphore(g_Device, transfer.Ready, g_Allocator);
+        }
+        transfer = {};
     }
 
     // Clean up frame semaphores
@@ -862,7 +1479,148 @@ static void CleanupDeviceVulkan() {
     g_CommandBuffer = VK_NULL_HANDLE;
     g_MinImageCount = 1;
     g_QueueFamily = static_cast<uint32_t>(-1);
-    g_QueueFamilies.clear();
+}
+
+/**
+ * @brief Whether the UI is rebuilt on this present, at most overlay.uiTickRate times per second
+ */
+static bool IsUiTick() {
+    const uint32_t rate = LayerConfig::Get().overlay.uiTickRate;
+    if (rate == 0) {
+        return true;
+    }
+
+    using clock = std::chrono::steady_clock;
+    static clock::time_point nextTick;
+    const clock::time_point now = clock::now();
+    if (now < nextTick) {
+        return false;
+    }
+
+    const auto period = std::chrono::nanoseconds(1000000000ull / rate);
+    nextTick += period;
+    if (nextTick < now) {
+        // Fell behind, e.g. while the game was paused; don't catch up with a burst of ticks
+        nextTick = now + period;
+    }
+    return true;
+}
+
+/**
+ * @brief Start drawing onto a swapchain image, with the overlay render pass or dynamic rendering
+ * @param device Device the overlay renders with
+ * @param fd Frame of the swapchain image, its command buffer recording
+ * @param secondaries Whether the contents come from secondary command buffers
+ */
+static void BeginOverlayRendering(const DeviceData* device, ImGui_ImplVulkanH_Frame* fd, bool secondaries) {
+    VkRect2D renderArea = {};
+
+    // Use default size if image extent is not set
+    if (g_ImageExtent.width == 0 || g_ImageExtent.height == 0) {
+        renderArea.extent.width = 3840;  // 4K default
+        renderArea.extent.height = 2160;
+    } else {
+        renderArea.extent = g_ImageExtent;
+    }
+
+    if (!g_UseDynamicRendering) {
+        VkRenderPassBeginInfo renderPassInfo = {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = g_RenderPass;
+        renderPassInfo.framebuffer = fd->Framebuffer;
+        renderPassInfo.renderArea = renderArea;
+        vkCmdBeginRenderPass(fd->CommandBuffer, &renderPassInfo,
+            secondaries ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+        return;
+    }
+
+    // Without a render pass the layout transitions are ours to record
+    VkImageMemoryBarrier toAttachment = {};
+    toAttachment.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toAttachment.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toAttachment.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    toAttachment.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    toAttachment.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toAttachment.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toAttachment.image = fd->Backbuffer;
+    toAttachment.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    // ALL_COMMANDS chains with whatever stage the present semaphores are waited at
+    vkCmdPipelineBarrier(fd->CommandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &toAttachment);
+
+    VkRenderingAttachmentInfo colorAttachment = {};
+    colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+    colorAttachment.imageView = fd->BackbufferView;
+    colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+
+    VkRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.flags = secondaries ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
+    renderingInfo.renderArea = renderArea;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &colorAttachment;
+
+    PFN_vkCmdBeginRendering beginRendering = device->vtable.CmdBeginRendering ?
+        device->vtable.CmdBeginRendering : device->vtable.CmdBeginRenderingKHR;
+    beginRendering(fd->CommandBuffer, &renderingInfo);
+}
+
+/**
+ * @brief Finish drawing started by BeginOverlayRendering, leaving the image ready to present
+ */
+static void EndOverlayRendering(const DeviceData* device, ImGui_ImplVulkanH_Frame* fd) {
+    if (!g_UseDynamicRendering) {
+        vkCmdEndRenderPass(fd->CommandBuffer);
+        return;
+    }
+
+    PFN_vkCmdEndRendering endRendering = device->vtable.CmdEndRendering ?
+        device->vtable.CmdEndRendering : device->vtable.CmdEndRenderingKHR;
+    endRendering(fd->CommandBuffer);
+
+    VkImageMemoryBarrier toPresent = {};
+    toPresent.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toPresent.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toPresent.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    toPresent.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    toPresent.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toPresent.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toPresent.image = fd->Backbuffer;
+    toPresent.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(fd->CommandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &toPresent);
+}
+
+/**
+ * @brief Wait until the GPU is done with the overlay commands last submitted for a frame
+ * @param index The swapchain image index
+ */
+static VkResult WaitForOverlayFrame(uint32_t index) {
+    ImGui_ImplVulkanH_Frame* fd = &g_Frames[index];
+    if (g_OverlayTimeline == VK_NULL_HANDLE) {
+        VkResult result = vkWaitForFences(g_Device, 1, &fd->Fence, VK_TRUE, UINT64_MAX);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        return vkResetFences(g_Device, 1, &fd->Fence);
+    }
+
+    // The frame is normally long finished, reading the counter is enough to tell
+    uint64_t completed = 0;
+    VkResult result = g_GetSemaphoreCounterValue(g_Device, g_OverlayTimeline, &completed);
+    if (result != VK_SUCCESS || completed >= g_FrameTimelineValue[index]) {
+        return result;
+    }
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &g_OverlayTimeline;
+    waitInfo.pValues = &g_FrameTimelineValue[index];
+    return g_WaitSemaphores(g_Device, &waitInfo, UINT64_MAX);
 }
 
 /**
@@ -872,6 +1630,7 @@ static void CleanupDeviceVulkan() {
  * @return VkResult indicating success or failure
  */
 static VkResult RenderImGui_Vulkan(VkQueue queue, const VkPresentInfoKHR* pPresentInfo) {
+    TSML_TRACE_SCOPE("RenderImGui_Vulkan");
     if (!queue || !pPresentInfo) {
         std::cerr << "[ERROR] Invalid queue or present info" << std::endl;
         return VK_ERROR_INITIALIZATION_FAILED;
@@ -890,19 +1649,45 @@ static VkResult RenderImGui_Vulkan(VkQueue queue, const VkPresentInfoKHR* pPrese
         return VK_ERROR_INITIALIZATION_FAILED;
     }
 
+    // Without a graphics queue there is nothing to draw with
+    const QueueData* graphic_data = queue_data->device->graphic_queue;
+    if (!graphic_data) {
+        return queue_data->device->vtable.QueuePresentKHR(queue, pPresentInfo);
+    }
+
     VkResult result = VK_SUCCESS;
-    VkQueue graphicQueue = queue_data->device->graphic_queue->queue;
-    const bool queueSupportsGraphic = DoesQueueSupportGraphic(queue, &graphicQueue);
+    VkQueue graphicQueue = graphic_data->queue;
+
+    // Exclusive images presented from another family have to change owner around the overlay submit
+    const uint32_t presentFamily = g_SwapchainExclusive && queue_data->family_index != graphic_data->family_index ?
+        queue_data->family_index : VK_QUEUE_FAMILY_IGNORED;
+    if (g_Frames[0].CommandBuffer != VK_NULL_HANDLE && presentFamily != g_PresentQueueFamily) {
+        CleanupRenderTarget();
+    }
+    std::vector<VkSemaphore> presentWaits;
     
     // Initialize ImGui context
     Menu::InitializeContext(g_Hwnd);
 
+    // Snapshots follow the game every present, not only on UI ticks with the menu open
+    PointerPaths::Resolve();
+
     // Process each swapchain
     for (uint32_t i = 0; i < pPresentInfo->swapchainCount; ++i) {
         VkSwapchainKHR swapchain = pPresentInfo->pSwapchains[i];
         
+        // The ImGui pipeline is built for one of the two paths, so pick it before the backend exists.
+        // The overlay cache composites inside the overlay render pass and keeps that path.
+        if (!ImGui::GetIO().BackendRendererUserData) {
+            g_UseDynamicRendering = queue_data->device->dynamic_rendering && !LayerConfig::IsEnabled(FEATURE_OVERLAY_CACHE);
+        }
+
         // Create render target if needed
-        if (g_Frames[0].Framebuffer == VK_NULL_HANDLE) {
+        if (g_Frames[0].CommandBuffer == VK_NULL_HANDLE) {
+            g_GetSemaphoreCounterValue = queue_data->device->get_semaphore_counter_value;
+            g_WaitSemaphores = queue_data->device->wait_semaphores;
+            g_OverlayQueueFamily = graphic_data->family_index;
+            g_PresentQueueFamily = presentFamily;
             CreateRenderTarget(g_Device, swapchain);
         }
         
@@ -915,59 +1700,21 @@ static VkResult RenderImGui_Vulkan(VkQueue queue, const VkPresentInfoKHR* pPrese
         ImGui_ImplVulkanH_Frame* fd = &g_Frames[image_index];
         ImGui_ImplVulkanH_FrameSemaphores* fsd = &g_FrameSemaphores[image_index];
         
-        // Wait for and reset fence
-        result = vkWaitForFences(g_Device, 1, &fd->Fence, VK_TRUE, UINT64_MAX);
-        if (result != VK_SUCCESS) {
-            std::cerr << "[ERROR] Failed to wait for fence: " << result << std::endl;
-            return result;
-        }
-        
-        result = vkResetFences(g_Device, 1, &fd->Fence);
-        if (result != VK_SUCCESS) {
-            std::cerr << "[ERROR] Failed to reset fence: " << result << std::endl;
-            return result;
-        }
-        
-        // Reset and begin command buffer
-        result = vkResetCommandBuffer(fd->CommandBuffer, 0);
-        if (result != VK_SUCCESS) {
-            std::cerr << "[ERROR] Failed to reset command buffer: " << result << std::endl;
-            return result;
-        }
-
-        VkCommandBufferBeginInfo beginInfo = {};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-        result = vkBeginCommandBuffer(fd->CommandBuffer, &beginInfo);
+        // Wait until the frame's previous overlay submit has finished
+        result = WaitForOverlayFrame(image_index);
         if (result != VK_SUCCESS) {
-            std::cerr << "[ERROR] Failed to begin command buffer: " << result << std::endl;
+            std::cerr << "[ERROR] Failed to wait for overlay frame: " << result << std::endl;
             return result;
         }
+        ModCommands::FrameDone(image_index);
         
-        // Begin render pass
-        VkRenderPassBeginInfo renderPassInfo = {};
-        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = g_RenderPass;
-        renderPassInfo.framebuffer = fd->Framebuffer;
-        
-        // Use default size if image extent is not set
-        if (g_ImageExtent.width == 0 || g_ImageExtent.height == 0) {
-            renderPassInfo.renderArea.extent.width = 3840;  // 4K default
-            renderPassInfo.renderArea.extent.height = 2160;
-        } else {
-            renderPassInfo.renderArea.extent = g_ImageExtent;
-        }
-
-        vkCmdBeginRenderPass(fd->CommandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
         // Initialize ImGui Vulkan implementation if needed
         if (!ImGui::GetIO().BackendRendererUserData) {
             ImGui_ImplVulkan_InitInfo init_info = {};
             init_info.Instance = g_Instance;
             init_info.PhysicalDevice = g_PhysicalDevice;
             init_info.Device = g_Device;
-            init_info.QueueFamily = g_QueueFamily;
+            init_info.QueueFamily = g_OverlayQueueFamily;
             init_info.Queue = graphicQueue;
             init_info.PipelineCache = g_PipelineCache;
             init_info.DescriptorPool = g_DescriptorPool;
@@ -977,161 +1724,176 @@ static VkResult RenderImGui_Vulkan(VkQueue queue, const VkPresentInfoKHR* pPrese
             init_info.ImageCount = g_MinImageCount;
             init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
             init_info.Allocator = g_Allocator;
+            init_info.MinAllocationSize = OverlayGeometry::MinAllocationSize();
+            init_info.UseDynamicRendering = g_UseDynamicRendering;
+            init_info.PipelineRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+            init_info.PipelineRenderingCreateInfo.colorAttachmentCount = 1;
+            init_info.PipelineRenderingCreateInfo.pColorAttachmentFormats = &g_OverlayFormat;
             
             ImGui_ImplVulkan_Init(&init_info);
             ImGui_ImplVulkan_CreateFontsTexture();
+            OverlayCache::Invalidate(); // New font atlas under the same texture ID
         }
 
-        // Prepare ImGui frame
-        ImGui_ImplVulkan_NewFrame();
-        ImGui_ImplWin32_NewFrame();
-        ImGui::NewFrame();
-
-        // Render menu
-        Menu::Render();
-
-        // Finalize ImGui rendering
-        ImGui::Render();
-        ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), fd->CommandBuffer);
+        // Publish finished mod textures before the UI asks for them; this present's
+        // uploads go out in one staging submit
+        if (i == 0 && StagingRing::BeginFrame(g_Device, g_OverlayQueueFamily)) {
+            TextureManager::Update(g_Device);
+            StagingRing::Submit(graphicQueue);
+        }
 
-        // End render pass and command buffer
-        vkCmdEndRenderPass(fd->CommandBuffer);
-        
-        result = vkEndCommandBuffer(fd->CommandBuffer);
-        if (result != VK_SUCCESS) {
-            std::cerr << "[ERROR] Failed to end command buffer: " << result << std::endl;
-            return result;
+        // Build the UI first so the overlay cache can tell whether it changed. Between
+        // UI ticks the last draw data is drawn again; input stays in ImGui's event
+        // queue until the next NewFrame.
+        static OverlayCache::Decision lastTickCache = OverlayCache::CACHE_BYPASS;
+        OverlayCache::Decision cache;
+        ImDrawData* drawData = ImGui::GetDrawData();
+        if (!drawData || IsUiTick()) {
+            TextureManager::BeginUiFrame();
+            ImGui_ImplVulkan_NewFrame();
+            ImGui_ImplWin32_NewFrame();
+            ImGui::NewFrame();
+
+            // Render menu
+            Menu::Render();
+
+            ImGui::Render();
+            drawData = ImGui::GetDrawData();
+            OverlayGeometry::Track(drawData);
+            ModCommands::Publish();
+            cache = LayerConfig::IsEnabled(FEATURE_OVERLAY_CACHE) ?
+                OverlayCache::Prepare(drawData) : OverlayCache::CACHE_BYPASS;
+            lastTickCache = cache;
+        } else if (lastTickCache != OverlayCache::CACHE_BYPASS && OverlayCache::IsValid()) {
+            // The cache was brought up to date on the tick that produced this draw data
+            cache = OverlayCache::CACHE_REUSE;
+        } else {
+            cache = LayerConfig::IsEnabled(FEATURE_OVERLAY_CACHE) ?
+                OverlayCache::Prepare(drawData) : OverlayCache::CACHE_BYPASS;
         }
 
-        // Submit command buffer and present
-        uint32_t waitSemaphoresCount = i == 0 ? pPresentInfo->waitSemaphoreCount : 0;
-        
-        if (waitSemaphoresCount == 0 && !queueSupportsGraphic) {
-            // Handle case where queue doesn't support graphics operations
-            constexpr VkPipelineStageFlags stages_wait = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-            
-            // First submission to signal render complete
-            {
-                VkSubmitInfo submitInfo = {};
-                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submitInfo.pWaitDstStageMask = &stages_wait;
-                submitInfo.signalSemaphoreCount = 1;
-                submitInfo.pSignalSemaphores = &fsd->RenderCompleteSemaphore;
-
-                result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
-                if (result != VK_SUCCESS) {
-                    std::cerr << "[ERROR] Failed to submit to queue: " << result << std::endl;
-                    return result;
-                }
-            }
-            
-            // Second submission with command buffer
-            {
-                VkSubmitInfo submitInfo = {};
-                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                submitInfo.commandBufferCount = 1;
-                submitInfo.pCommandBuffers = &fd->CommandBuffer;
-                submitInfo.pWaitDstStageMask = &stages_wait;
-                submitInfo.waitSemaphoreCount = 1;
-                submitInfo.pWaitSemaphores = &fsd->RenderCompleteSemaphore;
-                submitInfo.signalSemaphoreCount = 1;
-                submitInfo.pSignalSemaphores = &fsd->ImageAcquiredSemaphore;
-
-                result = vkQueueSubmit(graphicQueue, 1, &submitInfo, fd->Fence);
-                if (result != VK_SUCCESS) {
-                    std::cerr << "[ERROR] Failed to submit to graphics queue: " << result << std::endl;
-                    return result;
-                }
+        // A command buffer that only composited the unchanged cache is submitted again as is
+        const bool modCommands = ModCommands::HasCommands();
+        const bool reuseCommands = cache == OverlayCache::CACHE_REUSE && !modCommands &&
+            g_FrameCacheGeneration[image_index] == OverlayCache::Generation() &&
+            (!LayerConfig::IsEnabled(FEATURE_CAPTURE) || Capture::IsIdle());
+        const bool transfer = g_PresentQueueFamily != VK_QUEUE_FAMILY_IGNORED;
+        bool captured = false;
+
+        if (!reuseCommands) {
+            // Reset and begin command buffer
+            result = vkResetCommandBuffer(fd->CommandBuffer, 0);
+            if (result != VK_SUCCESS) {
+                std::cerr << "[ERROR] Failed to reset command buffer: " << result << std::endl;
+                return result;
             }
-        } else {
-            // Standard submission path
-            std::vector<VkPipelineStageFlags> stages_wait(waitSemaphoresCount, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
-            VkSubmitInfo submitInfo = {};
-            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submitInfo.commandBufferCount = 1;
-            submitInfo.pCommandBuffers = &fd->CommandBuffer;
-            submitInfo.pWaitDstStageMask = stages_wait.data();
-            submitInfo.waitSemaphoreCount = waitSemaphoresCount;
-            submitInfo.pWaitSemaphores = pPresentInfo->pWaitSemaphores;
-            submitInfo.signalSemaphoreCount = 1;
-            submitInfo.pSignalSemaphores = &fsd->ImageAcquiredSemaphore;
-            
-            result = vkQueueSubmit(graphicQueue, 1, &submitInfo, fd->Fence);
+
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = cache == OverlayCache::CACHE_BYPASS ? VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT : 0;
+
+            result = vkBeginCommandBuffer(fd->CommandBuffer, &beginInfo);
             if (result != VK_SUCCESS) {
-                std::cerr << "[ERROR] Failed to submit to graphics queue: " << result << std::endl;
+                std::cerr << "[ERROR] Failed to begin command buffer: " << result << std::endl;
                 return result;
             }
 
-            // Present the swapchain image
-            VkPresentInfoKHR present_info = *pPresentInfo;
-            present_info.swapchainCount = 1;
-            present_info.pSwapchains = &swapchain;
-            present_info.pImageIndices = &image_index;
-            present_info.pWaitSemaphores = &fsd->ImageAcquiredSemaphore;
-            present_info.waitSemaphoreCount = 1;
+            if (transfer) {
+                RecordOwnershipBarrier(fd->CommandBuffer, fd->Backbuffer, g_PresentQueueFamily, g_OverlayQueueFamily,
+                    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+            }
+
+            // Read back the game's frame before the overlay is drawn on top of it
+            captured = LayerConfig::IsEnabled(FEATURE_CAPTURE) &&
+                Capture::RecordCopy(fd->CommandBuffer, fd->Backbuffer, g_ImageExtent);
 
-            VkResult chain_result = queue_data->device->vtable.QueuePresentKHR(queue, &present_info);
-            
-            // Store result if requested
-            if (pPresentInfo->pResults) {
-                pPresentInfo->pResults[i] = chain_result;
+            if (cache == OverlayCache::CACHE_REFRESH) {
+                OverlayCache::RecordRefresh(fd->CommandBuffer, drawData);
             }
             
-            // Update overall result if needed
-            if (chain_result != VK_SUCCESS && result == VK_SUCCESS) {
-                result = chain_result;
+            BeginOverlayRendering(queue_data->device, fd, modCommands);
+
+            // A pass that executes mod secondaries can hold nothing else, so the overlay gets one too
+            VkCommandBuffer overlayCommands = fd->CommandBuffer;
+            if (modCommands) {
+                overlayCommands = g_FrameSecondary[image_index];
+                result = ModCommands::BeginSecondary(overlayCommands, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+                if (result != VK_SUCCESS) {
+                    std::cerr << "[ERROR] Failed to begin secondary command buffer: " << result << std::endl;
+                    return result;
+                }
             }
-        }
-    }
-    
-    return result;
-}
 
-/**
- * @brief Check if a queue supports graphics operations and optionally find a graphics queue
- * @param queue The queue to check
- * @param pGraphicQueue Optional pointer to store a graphics queue if found
- * @return true if the queue supports graphics operations, false otherwise
- */
-static bool DoesQueueSupportGraphic(VkQueue queue, VkQueue* pGraphicQueue) {
-    if (queue == VK_NULL_HANDLE || g_Device == VK_NULL_HANDLE) {
-        return false;
-    }
-    
-    bool queueSupportsGraphics = false;
-    
-    // Iterate through all queue families
-    for (uint32_t i = 0; i < g_QueueFamilies.size(); ++i) {
-        const VkQueueFamilyProperties& family = g_QueueFamilies[i];
-        
-        // Skip if this family doesn't support graphics operations
-        const bool familySupportsGraphics = (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
-        
-        // Iterate through all queues in this family
-        for (uint32_t j = 0; j < family.queueCount; ++j) {
-            VkQueue currentQueue = VK_NULL_HANDLE;
-            vkGetDeviceQueue(g_Device, i, j, &currentQueue);
-            
-            if (currentQueue == VK_NULL_HANDLE) {
-                continue;
+            if (cache == OverlayCache::CACHE_BYPASS) {
+                ImGui_ImplVulkan_RenderDrawData(drawData, overlayCommands);
+            } else {
+                OverlayCache::RecordComposite(overlayCommands);
             }
 
-            // If we need a graphics queue and this family supports graphics,
-            // store the first graphics queue we find if none has been stored yet
-            if (pGraphicQueue && familySupportsGraphics && *pGraphicQueue == VK_NULL_HANDLE) {
-                *pGraphicQueue = currentQueue;
+            if (modCommands) {
+                vkEndCommandBuffer(overlayCommands);
+                ModCommands::Execute(fd->CommandBuffer, image_index, overlayCommands);
             }
 
-            // Check if this is the queue we're looking for and if it supports graphics
-            if (queue == currentQueue && familySupportsGraphics) {
-                queueSupportsGraphics = true;
-                // We can break here if we've already found a graphics queue or don't need one
-                if (!pGraphicQueue || *pGraphicQueue != VK_NULL_HANDLE) {
-                    return true;
-                }
+            // End rendering and command buffer
+            EndOverlayRendering(queue_data->device, fd);
+
+            if (transfer) {
+                RecordOwnershipBarrier(fd->CommandBuffer, fd->Backbuffer, g_OverlayQueueFamily, g_PresentQueueFamily,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
             }
+            
+            result = vkEndCommandBuffer(fd->CommandBuffer);
+            if (result != VK_SUCCESS) {
+                std::cerr << "[ERROR] Failed to end command buffer: " << result << std::endl;
+                return result;
+            }
+
+            // A recording that refreshed the cache would redraw it on every reuse, so only
+            // composite-only recordings qualify; the frame after a refresh records one
+            g_FrameCacheGeneration[image_index] =
+                (cache == OverlayCache::CACHE_REUSE && !captured && !modCommands) ? OverlayCache::Generation() : 0;
         }
+
+        OverlaySubmit::Frame batches = {};
+        batches.presentQueue = queue;
+        batches.graphicsQueue = graphicQueue;
+        batches.gameWaitCount = i == 0 ? pPresentInfo->waitSemaphoreCount : 0;
+        batches.gameWaits = pPresentInfo->pWaitSemaphores;
+        batches.transfer = transfer;
+        batches.overlay = fd->CommandBuffer;
+        batches.release = g_Transfers[image_index].Release;
+        batches.acquire = g_Transfers[image_index].Acquire;
+        batches.released = fsd->RenderCompleteSemaphore;
+        batches.drawn = fsd->ImageAcquiredSemaphore;
+        batches.ready = g_Transfers[image_index].Ready;
+        batches.fence = fd->Fence;
+        batches.timeline = g_OverlayTimeline;
+        batches.timelineValue = g_OverlayTimelineValue + 1;
+
+        VkSemaphore presentWait = VK_NULL_HANDLE;
+        bool overlaySubmitted = false;
+        result = OverlaySubmit::Submit(queue_data->device->vtable, batches, presentWait, overlaySubmitted);
+        if (captured && overlaySubmitted) {
+            Capture::EndFrame(graphicQueue);
+        }
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        if (g_OverlayTimeline != VK_NULL_HANDLE) {
+            g_OverlayTimelineValue = batches.timelineValue;
+            g_FrameTimelineValue[image_index] = batches.timelineValue;
+        }
+        presentWaits.push_back(presentWait);
     }
-    return queueSupportsGraphics;
+
+    // Present every swapchain in one call, as the game asked
+    VkPresentInfoKHR presentInfo = *pPresentInfo;
+    presentInfo.waitSemaphoreCount = static_cast<uint32_t>(presentWaits.size());
+    presentInfo.pWaitSemaphores = presentWaits.data();
+    TSML_TRACE_SCOPE("vkQueuePresentKHR");
+    return queue_data->device->vtable.QueuePresentKHR(queue, &presentInfo);
 }
\ No newline at end of file
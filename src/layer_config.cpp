@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <vulkan/vulkan.h>
+
+#include "include/layer_config.h"
+#include "include/json.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+LayerSettings settings;
+
+// Config key for every optional feature
+struct FeatureName {
+    const char* key;
+    LayerFeature feature;
+};
+
+constexpr FeatureName featureNames[] = {
+    {"overlay", FEATURE_OVERLAY},
+    {"apiProfiler", FEATURE_PROFILER},
+    {"drawStats", FEATURE_DRAWSTATS},
+    {"memoryTracker", FEATURE_MEMTRACKER},
+    {"capture", FEATURE_CAPTURE},
+    {"overlayCache", FEATURE_OVERLAY_CACHE},
+    {"sharedMetrics", FEATURE_METRICS},
+    {"sampler", FEATURE_SAMPLER},
+    {"memoryScanner", FEATURE_SCANNER},
+    {"trace", FEATURE_TRACE},
+};
+
+// Accepted "presentMode" values
+struct PresentModeName {
+    const char* key;
+    int32_t mode;
+};
+
+constexpr PresentModeName presentModeNames[] = {
+    {"immediate", VK_PRESENT_MODE_IMMEDIATE_KHR},
+    {"mailbox", VK_PRESENT_MODE_MAILBOX_KHR},
+    {"fifo", VK_PRESENT_MODE_FIFO_KHR},
+    {"fifo_relaxed", VK_PRESENT_MODE_FIFO_RELAXED_KHR},
+};
+
+/**
+ * @brief Parse the "swapchain" object
+ */
+void LoadSwapchain(const json& swapchain) {
+    if (swapchain.contains("presentMode")) {
+        const std::string name = swapchain["presentMode"].get<std::string>();
+        settings.swapchain.presentMode = -1;
+        for (const PresentModeName& entry : presentModeNames) {
+            if (name == entry.key) {
+                settings.swapchain.presentMode = entry.mode;
+            }
+        }
+        if (settings.swapchain.presentMode < 0 && name != "default") {
+            std::cerr << "[ERROR] Unknown present mode \"" << name << "\", keeping the game's choice" << std::endl;
+        }
+    }
+
+    if (swapchain.contains("minImageCount")) {
+        settings.swapchain.minImageCount = swapchain["minImageCount"].get<uint32_t>();
+    }
+
+    if (settings.swapchain.presentMode >= 0 || settings.swapchain.minImageCount > 0) {
+        settings.features |= FEATURE_SWAPCHAIN_OVERRIDES;
+    } else {
+        settings.features &= ~FEATURE_SWAPCHAIN_OVERRIDES;
+    }
+}
+
+void LoadOverlay(const json& overlay) {
+    settings.overlay.uiTickRate = overlay.value("uiTickRate", settings.overlay.uiTickRate);
+    settings.overlay.textureBudgetMb = overlay.value("textureBudgetMb", settings.overlay.textureBudgetMb);
+    settings.overlay.stagingBufferMb = overlay.value("stagingBufferMb", settings.overlay.stagingBufferMb);
+}
+
+/**
+ * @brief Parse the "capture" object
+ */
+void LoadCapture(const json& capture) {
+    settings.capture.format = capture.value("format", settings.capture.format);
+    settings.capture.directory = capture.value("directory", settings.capture.directory);
+    settings.capture.hotkey = capture.value("hotkey", settings.capture.hotkey);
+}
+
+void LoadRecording(const json& recording) {
+    RecordingSettings& out = settings.recording;
+    out.output = recording.value("output", out.output);
+    out.pipeCommand = recording.value("pipeCommand", out.pipeCommand);
+    out.frameInterval = std::max(recording.value("frameInterval", out.frameInterval), 1u);
+    out.frameRate = std::max(recording.value("frameRate", out.frameRate), 1u);
+    out.hotkey = recording.value("hotkey", out.hotkey);
+
+    if (out.output != "y4m" && out.output != "raw" && out.output != "pipe") {
+        std::cerr << "[ERROR] Unknown recording output \"" << out.output << "\", using y4m" << std::endl;
+        out.output = "y4m";
+    }
+}
+
+void LoadTrace(const json& trace) {
+    settings.trace.output = trace.value("output", settings.trace.output);
+    settings.trace.hotkey = trace.value("hotkey", settings.trace.hotkey);
+    settings.trace.startup = trace.value("startup", settings.trace.startup);
+}
+
+void LoadSampler(const json& sampler) {
+    settings.sampler.intervalMs = std::max(sampler.value("intervalMs", settings.sampler.intervalMs), 1u);
+    settings.sampler.stackDepth = std::clamp(sampler.value("stackDepth", settings.sampler.stackDepth), 1u, 16u);
+}
+
+} // namespace
+
+namespace LayerConfig {
+
+/**
+ * @brief Load layer settings from the JSON configuration file
+ * @param filename Path to tsml_config.json
+ */
+void Load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cout << "[+] Layer config not found, using defaults" << std::endl;
+        return;
+    }
+
+    try {
+        json jsonData;
+        file >> jsonData;
+
+        if (jsonData.contains("layerFeatures")) {
+            const json& features = jsonData["layerFeatures"];
+            for (const FeatureName& entry : featureNames) {
+                if (!features.contains(entry.key)) {
+                    continue;
+                }
+
+                if (features[entry.key].get<bool>()) {
+                    settings.features |= entry.feature;
+                } else {
+                    settings.features &= ~entry.feature;
+                }
+            }
+        }
+
+        if (jsonData.contains("overlay")) {
+            LoadOverlay(jsonData["overlay"]);
+        }
+
+        if (jsonData.contains("swapchain")) {
+            LoadSwapchain(jsonData["swapchain"]);
+        }
+
+        if (jsonData.contains("capture")) {
+            LoadCapture(jsonData["capture"]);
+        }
+
+        if (jsonData.contains("recording")) {
+            LoadRecording(jsonData["recording"]);
+        }
+
+        if (jsonData.contains("trace")) {
+            LoadTrace(jsonData["trace"]);
+        }
+
+        if (jsonData.contains("sampler")) {
+            LoadSampler(jsonData["sampler"]);
+        }
+    } catch (const json::exception& e) {
+        std::cerr << "Error parsing layer config: " << e.what() << std::endl;
+    }
+
+    std::cout << "[+] Layer features: 0x" << std::hex << settings.features << std::dec << std::endl;
+}
+
+const LayerSettings& Get() {
+    return settings;
+}
+
+} // namespace LayerConfig
@@ -22,9 +22,17 @@
 #include <vector>
 #include <iomanip>
 #include "include/api.h"
+#include "include/capture.h"
+#include "include/input_events.h"
 #include "include/layer.h"
+#include "include/layer_config.h"
 #include "include/menu.hpp"
 #include "include/mod_loader.h"
+#include "include/sampler.h"
+#include "include/shared_metrics.h"
+#include "include/trace.h"
+#include "include/vtable_index.h"
+#include "include/window_filter.h"
 #include "include/json.hpp"
 
 
@@ -66,6 +74,7 @@ protected:
     virtual int overflow(int c) override {
         if (c != EOF) {
             if (c == '\n') {
+                SharedMetrics::CountLogLine();
                 // Write to log file with prefix
                 SML_Log << logPrefix << buffer << std::endl;
                 // Ensure data is written immediately
@@ -191,7 +200,49 @@ void EnsureConfigFileExists() {
     "fontPath": "fonts",
     "fontSize": 18.0,
     "unicodeRangeStart": "0x0001",
-    "unicodeRangeEnd": "0xFFFF"
+    "unicodeRangeEnd": "0xFFFF",
+    "layerFeatures": {
+      "overlay": true,
+      "apiProfiler": false,
+      "drawStats": false,
+      "memoryTracker": false,
+      "capture": false,
+      "overlayCache": false,
+      "sharedMetrics": false,
+      "sampler": false,
+      "memoryScanner": false,
+      "trace": false
+    },
+    "overlay": {
+      "uiTickRate": 0,
+      "textureBudgetMb": 256,
+      "stagingBufferMb": 32
+    },
+    "swapchain": {
+      "presentMode": "default",
+      "minImageCount": 0
+    },
+    "capture": {
+      "format": "png",
+      "directory": "screenshots",
+      "hotkey": 123
+    },
+    "recording": {
+      "output": "y4m",
+      "pipeCommand": "ffmpeg -y -f yuv4mpegpipe -i - -c:v libx264 -preset veryfast recording.mp4",
+      "frameInterval": 1,
+      "frameRate": 60,
+      "hotkey": 122
+    },
+    "trace": {
+      "output": "tsml_trace.json",
+      "hotkey": 120,
+      "startup": false
+    },
+    "sampler": {
+      "intervalMs": 2,
+      "stackDepth": 8
+    }
 })";
             outFile.close();
             print("Created default config file successfully\n");
@@ -206,27 +257,57 @@ void EnsureConfigFileExists() {
 }
 
 static WNDPROC oWndProc;
+
+static_assert(WindowFilter::kSetFocus == WM_SETFOCUS && WindowFilter::kKillFocus == WM_KILLFOCUS &&
+              WindowFilter::kInputLangChange == WM_INPUTLANGCHANGE && WindowFilter::kKeyDown == WM_KEYDOWN &&
+              WindowFilter::kKeyUp == WM_KEYUP && WindowFilter::kChar == WM_CHAR &&
+              WindowFilter::kSysKeyDown == WM_SYSKEYDOWN && WindowFilter::kSysKeyUp == WM_SYSKEYUP &&
+              WindowFilter::kMouseFirst == WM_MOUSEFIRST && WindowFilter::kMouseLast == WM_MOUSELAST &&
+              WindowFilter::kLButtonUp == WM_LBUTTONUP && WindowFilter::kRButtonUp == WM_RBUTTONUP &&
+              WindowFilter::kMButtonUp == WM_MBUTTONUP && WindowFilter::kXButtonUp == WM_XBUTTONUP &&
+              WindowFilter::kDeviceChange == WM_DEVICECHANGE && WindowFilter::kMouseLeave == WM_MOUSELEAVE &&
+              WindowFilter::kUser == WM_USER, "WindowFilter's message codes must match windows.h");
+
 LRESULT WINAPI HookWndProc(const HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-    if (uMsg == WM_KEYDOWN && wParam == 0xDF) {
+    if (LayerConfig::IsEnabled(FEATURE_METRICS)) SharedMetrics::CountWindowMessage();
+
+    switch (WindowFilter::Classify(uMsg, wParam, Menu::bShowMenu)) {
+    case WindowFilter::ACTION_TOGGLE_MENU:
         Menu::bShowMenu = !Menu::bShowMenu;
         std::cout << "ImGui menu toggled: " << (Menu::bShowMenu ? "Visible" : "Hidden") << std::endl;
         return 0;
+    case WindowFilter::ACTION_SCREENSHOT:
+        Capture::Request();
+        InputEvents::Publish(hWnd, uMsg, wParam, lParam, false);
+        return CallWindowProc(oWndProc, hWnd, uMsg, wParam, lParam);
+    case WindowFilter::ACTION_RECORDING:
+        Capture::ToggleRecording();
+        InputEvents::Publish(hWnd, uMsg, wParam, lParam, false);
+        return CallWindowProc(oWndProc, hWnd, uMsg, wParam, lParam);
+    case WindowFilter::ACTION_TRACE:
+        Trace::Toggle();
+        InputEvents::Publish(hWnd, uMsg, wParam, lParam, false);
+        return CallWindowProc(oWndProc, hWnd, uMsg, wParam, lParam);
+    case WindowFilter::ACTION_GAME:
+        InputEvents::Publish(hWnd, uMsg, wParam, lParam, false);
+        return CallWindowProc(oWndProc, hWnd, uMsg, wParam, lParam);
+    case WindowFilter::ACTION_PASS:
+        return CallWindowProc(oWndProc, hWnd, uMsg, wParam, lParam);
+    case WindowFilter::ACTION_IMGUI:
+        break;
     }
 
+    bool captured = false;
     try {
         LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
-        if (ImGui_ImplWin32_WndProcHandler(hWnd, uMsg, wParam, lParam)) {
-            return ERROR_SUCCESS;
-        }
+        captured = ImGui_ImplWin32_WndProcHandler(hWnd, uMsg, wParam, lParam) != 0;
 
         // Handle mouse input when any ImGui window wants it
-        if (ImGui::GetIO().WantCaptureMouse &&
+        captured = captured || (ImGui::GetIO().WantCaptureMouse &&
             (uMsg == WM_LBUTTONDOWN || uMsg == WM_LBUTTONUP ||
                 uMsg == WM_RBUTTONDOWN || uMsg == WM_RBUTTONUP ||
                 uMsg == WM_MBUTTONDOWN || uMsg == WM_MBUTTONUP ||
-                uMsg == WM_MOUSEWHEEL || uMsg == WM_MOUSEMOVE)) {
-            return ERROR_SUCCESS;
-        }
+                uMsg == WM_MOUSEWHEEL || uMsg == WM_MOUSEMOVE));
     }
     catch (const std::exception& e) {
         std::cerr << "Exception in ImGui window procedure handler: " << e.what() << std::endl;
@@ -235,6 +316,12 @@ LRESULT WINAPI HookWndProc(const HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
         std::cerr << "Unknown exception in ImGui window procedure handler" << std::endl;
     }
 
+    // Mods read input from the event stream instead of hooking the window themselves
+    InputEvents::Publish(hWnd, uMsg, wParam, lParam, captured);
+    if (captured) {
+        return ERROR_SUCCESS;
+    }
+
     return CallWindowProc(oWndProc, hWnd, uMsg, wParam, lParam);
 }
 
@@ -350,11 +437,13 @@ DWORD WINAPI hook_thread(PVOID lParam) {
         window = FindWindowA("TgcMainWindow", "Sky");
     }
     layer::setup(window);
+    Sampler::WatchThread(GetWindowThreadProcessId(window, nullptr), "Window thread");
     oWndProc = reinterpret_cast<WNDPROC>(SetWindowLongPtr(window, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(HookWndProc)));
     return EXIT_SUCCESS;
 }
 
 void onAttach() {
+    const uint64_t attachStart = Trace::Now();
     //loadWrapper(); - Integrated into onAttach()
     dllHandle = LoadLibrary("C:\\Windows\\System32\\powrprof.dll");
 
@@ -380,6 +469,16 @@ void onAttach() {
     std::wstring ws(path);
     std::string _path(ws.begin(), ws.end());
     g_basePath = _path.substr(0, _path.find_last_of("\\/"));
+    LayerConfig::Load(g_basePath + "\\tsml_config.json");
+    if (LayerConfig::IsEnabled(FEATURE_METRICS)) {
+        SharedMetrics::Init();
+    }
+    if (LayerConfig::IsEnabled(FEATURE_SAMPLER)) {
+        Sampler::Start();
+    }
+    if (LayerConfig::IsEnabled(FEATURE_TRACE) && LayerConfig::Get().trace.startup) {
+        Trace::Start();
+    }
 
     HMODULE handle = LoadLibrary("advapi32.dll");
     if (handle != NULL) {
@@ -389,6 +488,7 @@ void onAttach() {
         if (LM_HookCode(fnRegEnumValue, (lm_address_t)&hkRegEnumValueA, (lm_address_t*)&oRegEnumValueA)) {
             terminateCrashpadHandler();
             ModApi::Instance().InitSkyBase();
+            VTableIndex::Start();
             ModLoader::LoadMods();
         }
         else print("Failed to hook fnRegEnumValue");
@@ -396,6 +496,10 @@ void onAttach() {
         CreateThread(NULL, 0, hook_thread, nullptr, 0, NULL);
     }
     else print("Failed to load advapi32.dll");   
+
+    if (Trace::IsEnabled()) {
+        Trace::Complete("onAttach", attachStart);
+    }
 }
 
 
@@ -407,6 +511,11 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved) {
         onAttach();
         break;
     case DLL_PROCESS_DETACH:
+        // On process exit the other threads are already gone, possibly holding locks the
+        // trace writer needs; a trace still running then is lost
+        if (lpvReserved == nullptr) {
+            Trace::Shutdown();
+        }
         break;
     }
 
@@ -0,0 +1,343 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <windows.h>
+#include <libmem.h>
+
+#include <imgui.h>
+
+#include "include/layer_config.h"
+#include "include/memory_scanner.h"
+#include "include/thread_pool.h"
+
+struct ModScan {
+    std::unique_ptr<ScanEngine::ResultSet> results;
+};
+
+namespace {
+
+static_assert(static_cast<uint32_t>(MOD_SCAN_BYTES) == ScanEngine::VALUE_BYTES, "ModScanType must mirror ScanEngine::ValueType");
+static_assert(static_cast<uint32_t>(MOD_SCAN_DECREASED) == ScanEngine::CONDITION_DECREASED, "ModScanCondition must mirror ScanEngine::Condition");
+
+constexpr DWORD kReadable = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY
+    | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+constexpr DWORD kWritable = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+constexpr size_t kShownResults = 64;
+
+constexpr const char* typeNames[] = { "Int32", "Float", "Bytes" };
+constexpr const char* conditionNames[] = { "Equal to", "Changed", "Unchanged", "Increased", "Decreased" };
+
+struct PageFilter {
+    bool writableOnly;
+    std::vector<ScanEngine::Region>* regions;
+};
+
+lm_bool_t LM_CALL CollectPage(lm_page_t* page, lm_void_t* arg) {
+    const PageFilter& filter = *static_cast<const PageFilter*>(arg);
+    const DWORD protection = static_cast<DWORD>(page->prot);
+    if ((protection & PAGE_GUARD) || !(protection & (filter.writableOnly ? kWritable : kReadable))) {
+        return LM_TRUE;
+    }
+
+    // Adjacent pages are merged so byte patterns can cross the boundary
+    std::vector<ScanEngine::Region>& regions = *filter.regions;
+    if (!regions.empty() && regions.back().base + regions.back().size == page->base) {
+        regions.back().size += page->size;
+    } else {
+        regions.push_back({ static_cast<uintptr_t>(page->base), static_cast<size_t>(page->size) });
+    }
+    return LM_TRUE;
+}
+
+/**
+ * @brief Run a scan body, turning an access violation into a failed chunk
+ *
+ * The game may free or protect memory while it is being scanned. Scan bodies
+ * only read memory into buffers allocated beforehand, so nothing is left half
+ * done when one is abandoned.
+ */
+bool Guarded(void (*body)(void*), void* context) {
+#ifdef _MSC_VER
+    __try {
+        body(context);
+        return true;
+    } __except (GetExceptionCode() == EXCEPTION_ACCESS_VIOLATION ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH) {
+        return false;
+    }
+#else
+    body(context);
+    return true;
+#endif
+}
+
+ScanEngine::Query MakeQuery(ModScanType type, const void* value, size_t size, float tolerance) {
+    ScanEngine::Query query;
+    query.type = static_cast<ScanEngine::ValueType>(type);
+    query.value.assign(static_cast<const uint8_t*>(value), static_cast<const uint8_t*>(value) + size);
+    query.tolerance = tolerance;
+    return query;
+}
+
+// ---------------------------------------------------------------------------
+// Overlay
+// ---------------------------------------------------------------------------
+
+struct OverlayState {
+    int type = MOD_SCAN_INT32;
+    int condition = MOD_SCAN_EQUAL;
+    char value[128] = "";
+    float tolerance = 0.001f;
+    bool writableOnly = true;
+    std::string error;
+};
+
+OverlayState overlay; // Render thread only
+
+// The overlay's results; a running scan takes them out and puts them back when done
+std::mutex resultsLock;
+std::unique_ptr<ScanEngine::ResultSet> overlayResults;
+float lastScanMs = 0.0f;
+std::atomic<bool> scanning{false};
+
+/**
+ * @brief Parse the value field: a decimal or 0x integer, a float, or hex bytes such as "DE AD BE EF"
+ */
+bool ParseValue(int type, const char* text, std::vector<uint8_t>& out) {
+    out.clear();
+    char* end = nullptr;
+    if (type == MOD_SCAN_INT32) {
+        const int32_t value = static_cast<int32_t>(strtoll(text, &end, 0));
+        out.resize(4);
+        memcpy(out.data(), &value, 4);
+        return end != text && *end == '\0';
+    }
+    if (type == MOD_SCAN_FLOAT) {
+        const float value = strtof(text, &end);
+        out.resize(4);
+        memcpy(out.data(), &value, 4);
+        return end != text && *end == '\0';
+    }
+
+    for (const char* p = text; *p;) {
+        if (*p == ' ') {
+            ++p;
+            continue;
+        }
+        const unsigned long byte = strtoul(p, &end, 16);
+        if (end == p || end - p > 2) {
+            return false;
+        }
+        out.push_back(static_cast<uint8_t>(byte));
+        p = end;
+    }
+    return !out.empty();
+}
+
+std::string FormatValue(int type, const uint8_t* value, size_t size) {
+    char text[64];
+    if (type == MOD_SCAN_INT32) {
+        int32_t v;
+        memcpy(&v, value, 4);
+        snprintf(text, sizeof(text), "%d", v);
+        return text;
+    }
+    if (type == MOD_SCAN_FLOAT) {
+        float v;
+        memcpy(&v, value, 4);
+        snprintf(text, sizeof(text), "%g", v);
+        return text;
+    }
+
+    std::string bytes;
+    for (size_t i = 0; i < size && i < 16; ++i) {
+        snprintf(text, sizeof(text), i ? " %02X" : "%02X", value[i]);
+        bytes += text;
+    }
+    return bytes;
+}
+
+void StartOverlayScan(bool first, std::vector<uint8_t> value) {
+    scanning = true;
+    const int type = overlay.type;
+    const int condition = overlay.condition;
+    const float tolerance = overlay.tolerance;
+    const bool writableOnly = overlay.writableOnly;
+
+    ThreadPool::Shared().Submit([=, value = std::move(value)] {
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<ScanEngine::ResultSet> results;
+        if (first) {
+            results = ScanEngine::First(MemoryScanner::CommittedRegions(writableOnly),
+                MakeQuery(static_cast<ModScanType>(type), value.data(), value.size(), tolerance), Guarded);
+        } else {
+            {
+                std::lock_guard<std::mutex> guard(resultsLock);
+                results = std::move(overlayResults);
+            }
+            if (results) {
+                ScanEngine::Next(*results, static_cast<ScanEngine::Condition>(condition), value, Guarded);
+            }
+        }
+
+        std::lock_guard<std::mutex> guard(resultsLock);
+        overlayResults = std::move(results);
+        lastScanMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        scanning = false;
+    });
+}
+
+} // namespace
+
+namespace MemoryScanner {
+
+std::vector<ScanEngine::Region> CommittedRegions(bool writableOnly) {
+    std::vector<ScanEngine::Region> regions;
+    PageFilter filter = { writableOnly, &regions };
+    LM_EnumPages(CollectPage, &filter);
+    return regions;
+}
+
+ModScan* First(ModScanType type, const void* value, size_t size, float tolerance) {
+    if (!value || size == 0) {
+        return nullptr;
+    }
+
+    auto results = ScanEngine::First(CommittedRegions(true), MakeQuery(type, value, size, tolerance), Guarded);
+    if (!results) {
+        std::cerr << "[ERROR] Invalid memory scan: type " << type << ", " << size << " byte value" << std::endl;
+        return nullptr;
+    }
+    return new ModScan{ std::move(results) };
+}
+
+bool Next(ModScan* scan, ModScanCondition condition, const void* value) {
+    if (!scan) {
+        return false;
+    }
+
+    std::vector<uint8_t> bytes;
+    if (value) {
+        const size_t size = ScanEngine::ValueSize(scan->results->query);
+        bytes.assign(static_cast<const uint8_t*>(value), static_cast<const uint8_t*>(value) + size);
+    }
+    return ScanEngine::Next(*scan->results, static_cast<ScanEngine::Condition>(condition), bytes, Guarded);
+}
+
+uint64_t Count(const ModScan* scan) {
+    return scan ? scan->results->count : 0;
+}
+
+size_t Results(const ModScan* scan, uintptr_t* addresses, size_t maxAddresses) {
+    size_t written = 0;
+    if (!scan || maxAddresses == 0) {
+        return 0;
+    }
+    ScanEngine::ForEach(*scan->results, [&](uintptr_t address, const uint8_t*) {
+        addresses[written++] = address;
+        return written < maxAddresses;
+    });
+    return written;
+}
+
+void Release(ModScan* scan) {
+    delete scan;
+}
+
+void RenderOverlay() {
+    if (!LayerConfig::IsEnabled(FEATURE_SCANNER)) {
+        return;
+    }
+
+    ImGui::SetNextWindowSize({ 420, 420 }, ImGuiCond_Once);
+    if (ImGui::Begin("Memory Scanner")) {
+        const bool busy = scanning.load();
+        std::lock_guard<std::mutex> guard(resultsLock);
+        const bool haveResults = overlayResults != nullptr;
+
+        ImGui::BeginDisabled(busy || haveResults);
+        ImGui::Combo("Type", &overlay.type, typeNames, IM_ARRAYSIZE(typeNames));
+        ImGui::Checkbox("Writable memory only", &overlay.writableOnly);
+        ImGui::EndDisabled();
+        if (haveResults) {
+            ImGui::Combo("Condition", &overlay.condition, conditionNames, IM_ARRAYSIZE(conditionNames));
+        }
+        ImGui::InputText("Value", overlay.value, sizeof(overlay.value));
+        if (overlay.type == MOD_SCAN_FLOAT) {
+            ImGui::InputFloat("Tolerance", &overlay.tolerance, 0.0f, 0.0f, "%g");
+        }
+
+        ImGui::BeginDisabled(busy);
+        const bool needsValue = !haveResults || overlay.condition == MOD_SCAN_EQUAL;
+        if (ImGui::Button(haveResults ? "Next scan" : "First scan")) {
+            std::vector<uint8_t> value;
+            const bool ordered = overlay.condition == MOD_SCAN_INCREASED || overlay.condition == MOD_SCAN_DECREASED;
+            if (needsValue && !ParseValue(overlay.type, overlay.value, value)) {
+                overlay.error = "Value is not a valid " + std::string(typeNames[overlay.type]);
+            } else if (haveResults && overlay.type == MOD_SCAN_BYTES && ordered) {
+                overlay.error = "Byte patterns cannot increase or decrease";
+            } else {
+                overlay.error.clear();
+                StartOverlayScan(!haveResults, needsValue ? std::move(value) : std::vector<uint8_t>());
+            }
+        }
+        if (haveResults) {
+            ImGui::SameLine();
+            if (ImGui::Button("New scan")) {
+                overlayResults.reset();
+            }
+        }
+        ImGui::EndDisabled();
+
+        if (!overlay.error.empty()) {
+            ImGui::TextColored({ 1.0f, 0.4f, 0.4f, 1.0f }, "%s", overlay.error.c_str());
+        }
+        if (busy) {
+            ImGui::TextUnformatted("Scanning...");
+        }
+
+        if (overlayResults) {
+            const ScanEngine::ResultSet& results = *overlayResults;
+            ImGui::Text("%llu results | %.1f ms | %.0f MB scanned | %s",
+                static_cast<unsigned long long>(results.count), lastScanMs, results.bytesScanned / (1024.0 * 1024.0),
+                ScanEngine::HasAVX2() ? "AVX2" : "scalar");
+            ImGui::Text("Result memory: %.1f KB | Chunks lost: %u", ScanEngine::Footprint(results) / 1024.0, results.faults);
+
+            constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
+            if (ImGui::BeginTable("##results", 3, flags)) {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Address", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Value");
+                ImGui::TableSetupColumn("Previous");
+                ImGui::TableHeadersRow();
+
+                const size_t size = ScanEngine::ValueSize(results.query);
+                size_t shown = 0;
+                std::vector<uint8_t> current(size);
+                ScanEngine::ForEach(results, [&](uintptr_t address, const uint8_t* previous) {
+                    SIZE_T read = 0;
+                    const bool readable = ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<LPCVOID>(address),
+                        current.data(), size, &read) && read == size;
+
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%016llX", static_cast<unsigned long long>(address));
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(readable ? FormatValue(results.query.type, current.data(), size).c_str() : "??");
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(FormatValue(results.query.type, previous, size).c_str());
+                    return ++shown < kShownResults;
+                });
+                ImGui::EndTable();
+            }
+        }
+    }
+    ImGui::End();
+}
+
+} // namespace MemoryScanner
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <imgui.h>
+
+#include "include/layer_config.h"
+#include "include/layer_dispatch.h"
+#include "include/memory_tracker.h"
+#include "include/memory_usage.h"
+
+namespace {
+
+constexpr uint32_t kFramesPerSample = 30;
+constexpr size_t kHistorySamples = 120;
+constexpr double kMiB = 1024.0 * 1024.0;
+
+std::mutex trackerMutex;
+MemoryUsage usage;
+
+// Physical device of the tracked device, captured at vkCreateDevice
+VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+VkPhysicalDeviceMemoryProperties memoryProperties = {};
+PFN_vkGetPhysicalDeviceMemoryProperties2 getMemoryProperties2 = nullptr;
+bool hasBudget = false;
+
+// Sampled from the present thread only
+VkDeviceSize heapUsage[VK_MAX_MEMORY_HEAPS] = {};
+VkDeviceSize heapBudget[VK_MAX_MEMORY_HEAPS] = {};
+float usageHistory[kHistorySamples] = {};
+size_t historySize = 0;
+float budgetMiB = 0.0f;
+uint32_t frameCount = 0;
+
+bool SupportsExtension(VkPhysicalDevice device, const VkLayerInstanceDispatchTable& table, const char* name) {
+    if (!table.EnumerateDeviceExtensionProperties) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    table.EnumerateDeviceExtensionProperties(device, nullptr, &count, nullptr);
+    std::vector<VkExtensionProperties> extensions(count);
+    table.EnumerateDeviceExtensionProperties(device, nullptr, &count, extensions.data());
+
+    for (const VkExtensionProperties& extension : extensions) {
+        if (strcmp(extension.extensionName, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Refresh heap usage and budget, from the driver when possible
+ */
+void SampleHeaps() {
+    if (hasBudget) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget = {};
+        budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 properties = {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        properties.pNext = &budget;
+        getMemoryProperties2(physicalDevice, &properties);
+
+        std::copy(std::begin(budget.heapUsage), std::end(budget.heapUsage), heapUsage);
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+            heapBudget[i] = MemoryUsage::HeapBudget(memoryProperties, &budget, i);
+        }
+        return;
+    }
+
+    // Without the extension only our own view is available
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+        heapUsage[i] = usage.HeapBytes(memoryProperties, i);
+        heapBudget[i] = MemoryUsage::HeapBudget(memoryProperties, nullptr, i);
+    }
+}
+
+std::string TypeFlags(VkMemoryPropertyFlags flags) {
+    std::string text;
+    if (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) text += "DL ";
+    if (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) text += "HV ";
+    if (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) text += "HC ";
+    if (flags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) text += "C ";
+    if (flags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) text += "L ";
+    return text;
+}
+
+/**
+ * @brief Count a successful vkBind*Memory2 call; on failure which binds took effect is undefined
+ */
+void RecordBinds(uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos) {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        usage.BindBuffer(HandleMap<uint64_t>::Key(pBindInfos[i].buffer), HandleMap<uint64_t>::Key(pBindInfos[i].memory));
+    }
+}
+
+void RecordBinds(uint32_t bindInfoCount, const VkBindImageMemoryInfo* pBindInfos) {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    for (uint32_t i = 0; i < bindInfoCount; ++i) {
+        // Swapchain images bind through a pNext with no memory of their own
+        if (pBindInfos[i].memory != VK_NULL_HANDLE) {
+            usage.BindImage(HandleMap<uint64_t>::Key(pBindInfos[i].image), HandleMap<uint64_t>::Key(pBindInfos[i].memory));
+        }
+    }
+}
+
+} // namespace
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_AllocateMemory(VkDevice device, const VkMemoryAllocateInfo* pAllocateInfo, const VkAllocationCallbacks* pAllocator, VkDeviceMemory* pMemory) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).AllocateMemory(device, pAllocateInfo, pAllocator, pMemory);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    usage.Allocate(HandleMap<uint64_t>::Key(*pMemory), pAllocateInfo->allocationSize, pAllocateInfo->memoryTypeIndex);
+    return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_FreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks* pAllocator) {
+    // Forget the handle before the driver can hand it out again
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        usage.Free(HandleMap<uint64_t>::Key(memory));
+    }
+    GetDeviceDispatch(GetKey(device)).FreeMemory(device, memory, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_CreateBuffer(VkDevice device, const VkBufferCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkBuffer* pBuffer) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).CreateBuffer(device, pCreateInfo, pAllocator, pBuffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    usage.AddBuffer(HandleMap<uint64_t>::Key(*pBuffer), pCreateInfo->size);
+    return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_DestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks* pAllocator) {
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        usage.RemoveBuffer(HandleMap<uint64_t>::Key(buffer));
+    }
+    GetDeviceDispatch(GetKey(device)).DestroyBuffer(device, buffer, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_CreateImage(VkDevice device, const VkImageCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkImage* pImage) {
+    const VkLayerDispatchTable& next = GetDeviceDispatch(GetKey(device));
+    VkResult result = next.CreateImage(device, pCreateInfo, pAllocator, pImage);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    // The footprint of an image depends on its tiling, so ask the driver
+    VkMemoryRequirements requirements = {};
+    next.GetImageMemoryRequirements(device, *pImage, &requirements);
+
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    usage.AddImage(HandleMap<uint64_t>::Key(*pImage), requirements.size);
+    return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL ModLoader_DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator) {
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        usage.RemoveImage(HandleMap<uint64_t>::Key(image));
+    }
+    GetDeviceDispatch(GetKey(device)).DestroyImage(device, image, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).BindBufferMemory(device, buffer, memory, memoryOffset);
+    if (result == VK_SUCCESS) {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        usage.BindBuffer(HandleMap<uint64_t>::Key(buffer), HandleMap<uint64_t>::Key(memory));
+    }
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindImageMemory(VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize memoryOffset) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).BindImageMemory(device, image, memory, memoryOffset);
+    if (result == VK_SUCCESS) {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        usage.BindImage(HandleMap<uint64_t>::Key(image), HandleMap<uint64_t>::Key(memory));
+    }
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindBufferMemory2(VkDevice device, uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).BindBufferMemory2(device, bindInfoCount, pBindInfos);
+    if (result == VK_SUCCESS) RecordBinds(bindInfoCount, pBindInfos);
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindBufferMemory2KHR(VkDevice device, uint32_t bindInfoCount, const VkBindBufferMemoryInfo* pBindInfos) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).BindBufferMemory2KHR(device, bindInfoCount, pBindInfos);
+    if (result == VK_SUCCESS) RecordBinds(bindInfoCount, pBindInfos);
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindImageMemory2(VkDevice device, uint32_t bindInfoCount, const VkBindImageMemoryInfo* pBindInfos) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).BindImageMemory2(device, bindInfoCount, pBindInfos);
+    if (result == VK_SUCCESS) RecordBinds(bindInfoCount, pBindInfos);
+    return result;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL ModLoader_BindImageMemory2KHR(VkDevice device, uint32_t bindInfoCount, const VkBindImageMemoryInfo* pBindInfos) {
+    VkResult result = GetDeviceDispatch(GetKey(device)).BindImageMemory2KHR(device, bindInfoCount, pBindInfos);
+    if (result == VK_SUCCESS) RecordBinds(bindInfoCount, pBindInfos);
+    return result;
+}
+
+namespace MemoryTracker {
+
+/**
+ * @brief Capture the memory layout of the device being created
+ * @param device The physical device vkCreateDevice was called with
+ * @param instanceTable The next layer's instance dispatch table
+ */
+void OnCreateDevice(VkPhysicalDevice device, const VkLayerInstanceDispatchTable& instanceTable) {
+    physicalDevice = device;
+    instanceTable.GetPhysicalDeviceMemoryProperties(device, &memoryProperties);
+
+    getMemoryProperties2 = instanceTable.GetPhysicalDeviceMemoryProperties2;
+    hasBudget = getMemoryProperties2 && SupportsExtension(device, instanceTable, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    std::cout << "[+] Memory tracker: " << memoryProperties.memoryHeapCount << " heaps, "
+        << memoryProperties.memoryTypeCount << " types, VK_EXT_memory_budget "
+        << (hasBudget ? "available" : "unavailable") << std::endl;
+}
+
+/**
+ * @brief Sample heap usage and budget every few frames
+ */
+void EndFrame() {
+    if (physicalDevice == VK_NULL_HANDLE || ++frameCount % kFramesPerSample != 0) {
+        return;
+    }
+
+    SampleHeaps();
+
+    // Track all device-local heaps together, that is where VRAM runs out
+    VkDeviceSize used = 0;
+    VkDeviceSize budget = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+        if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            used += heapUsage[i];
+            budget += heapBudget[i];
+        }
+    }
+
+    if (historySize == kHistorySamples) {
+        std::copy(usageHistory + 1, usageHistory + kHistorySamples, usageHistory);
+        --historySize;
+    }
+    usageHistory[historySize++] = static_cast<float>(used / kMiB);
+    budgetMiB = static_cast<float>(budget / kMiB);
+}
+
+/**
+ * @brief Display heap usage against budget and the live allocations per memory type
+ */
+void RenderOverlay() {
+    if (!LayerConfig::IsEnabled(FEATURE_MEMTRACKER)) {
+        return;
+    }
+
+    ImGui::SetNextWindowSize({ 420, 400 }, ImGuiCond_Once);
+    if (ImGui::Begin("Device Memory")) {
+        if (!hasBudget) {
+            ImGui::TextDisabled("VK_EXT_memory_budget unavailable, showing tracked allocations only");
+        }
+
+        const float current = historySize ? usageHistory[historySize - 1] : 0.0f;
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "VRAM %.0f / %.0f MiB", current, budgetMiB);
+        ImGui::PlotLines("##vram", usageHistory, static_cast<int>(historySize), 0, overlay, 0.0f, budgetMiB, { -1, 70 });
+
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+            const bool deviceLocal = memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+            snprintf(overlay, sizeof(overlay), "Heap %u%s: %.0f / %.0f MiB", i, deviceLocal ? " (device)" : "",
+                heapUsage[i] / kMiB, heapBudget[i] / kMiB);
+            ImGui::ProgressBar(heapBudget[i] ? static_cast<float>(heapUsage[i]) / heapBudget[i] : 0.0f, { -1, 0 }, overlay);
+        }
+        ImGui::Separator();
+
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        ImGui::Text("Allocations: %zu | Buffers: %zu (%.1f MiB) | Images: %zu (%.1f MiB)",
+            usage.Allocations(), usage.Buffers(), usage.BufferBytes() / kMiB, usage.Images(), usage.ImageBytes() / kMiB);
+
+        constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+        if (ImGui::BeginTable("##memorytypes", 6, flags)) {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Heap");
+            ImGui::TableSetupColumn("Flags", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Allocs");
+            ImGui::TableSetupColumn("MiB");
+            ImGui::TableSetupColumn("Bound");
+            ImGui::TableHeadersRow();
+
+            for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+                const MemoryUsage::TypeUsage& type = usage.Type(i);
+                if (type.count == 0) {
+                    continue;
+                }
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", i);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", memoryProperties.memoryTypes[i].heapIndex);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(TypeFlags(memoryProperties.memoryTypes[i].propertyFlags).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(type.count));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", type.bytes / kMiB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f%%", type.bytes ? 100.0 * type.bound / type.bytes : 0.0);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+} // namespace MemoryTracker
@@ -0,0 +1,108 @@
+#include "include/memory_usage.h"
+
+void MemoryUsage::Allocate(uint64_t memory, uint64_t size, uint32_t typeIndex) {
+    if (typeIndex >= VK_MAX_MEMORY_TYPES) {
+        return;
+    }
+
+    allocations_.Insert(memory, {size, typeIndex, nextSerial_++, 0});
+    types_[typeIndex].bytes += size;
+    ++types_[typeIndex].count;
+}
+
+bool MemoryUsage::Free(uint64_t memory) {
+    Allocation allocation;
+    if (memory == 0 || !allocations_.Erase(memory, &allocation)) {
+        return false;
+    }
+
+    TypeUsage& type = types_[allocation.typeIndex];
+    type.bytes -= allocation.size;
+    --type.count;
+    // What is still bound goes with the memory; the resources find their allocation gone when destroyed
+    type.bound -= allocation.bound;
+    return true;
+}
+
+void MemoryUsage::AddBuffer(uint64_t buffer, uint64_t size) {
+    buffers_.Insert(buffer, {size, 0, 0});
+    bufferBytes_ += size;
+}
+
+void MemoryUsage::AddImage(uint64_t image, uint64_t size) {
+    images_.Insert(image, {size, 0, 0});
+    imageBytes_ += size;
+}
+
+void MemoryUsage::RemoveBuffer(uint64_t buffer) {
+    Resource resource;
+    if (buffer != 0 && buffers_.Erase(buffer, &resource)) {
+        bufferBytes_ -= resource.size;
+        Unbind(resource);
+    }
+}
+
+void MemoryUsage::RemoveImage(uint64_t image) {
+    Resource resource;
+    if (image != 0 && images_.Erase(image, &resource)) {
+        imageBytes_ -= resource.size;
+        Unbind(resource);
+    }
+}
+
+bool MemoryUsage::BindBuffer(uint64_t buffer, uint64_t memory) {
+    return Bind(buffers_, buffer, memory);
+}
+
+bool MemoryUsage::BindImage(uint64_t image, uint64_t memory) {
+    return Bind(images_, image, memory);
+}
+
+const MemoryUsage::TypeUsage& MemoryUsage::Type(uint32_t typeIndex) const {
+    static const TypeUsage none = {};
+    return typeIndex < VK_MAX_MEMORY_TYPES ? types_[typeIndex] : none;
+}
+
+VkDeviceSize MemoryUsage::HeapBytes(const VkPhysicalDeviceMemoryProperties& properties, uint32_t heapIndex) const {
+    VkDeviceSize bytes = 0;
+    for (uint32_t i = 0; i < properties.memoryTypeCount && i < VK_MAX_MEMORY_TYPES; ++i) {
+        if (properties.memoryTypes[i].heapIndex == heapIndex) {
+            bytes += types_[i].bytes;
+        }
+    }
+    return bytes;
+}
+
+VkDeviceSize MemoryUsage::HeapBudget(const VkPhysicalDeviceMemoryProperties& properties,
+                                     const VkPhysicalDeviceMemoryBudgetPropertiesEXT* budget, uint32_t heapIndex) {
+    if (heapIndex >= properties.memoryHeapCount || heapIndex >= VK_MAX_MEMORY_HEAPS) {
+        return 0;
+    }
+    // Drivers leave the budget of heaps they do not report on at 0
+    if (budget && budget->heapBudget[heapIndex] != 0) {
+        return budget->heapBudget[heapIndex];
+    }
+    return properties.memoryHeaps[heapIndex].size;
+}
+
+bool MemoryUsage::Bind(HandleMap<Resource>& resources, uint64_t resource, uint64_t memory) {
+    Resource* bound = resources.Get(resource);
+    Allocation* allocation = allocations_.Get(memory);
+    if (!bound || !allocation || bound->memory != 0) {
+        return false;
+    }
+
+    bound->memory = memory;
+    bound->serial = allocation->serial;
+    allocation->bound += bound->size;
+    types_[allocation->typeIndex].bound += bound->size;
+    return true;
+}
+
+void MemoryUsage::Unbind(const Resource& resource) {
+    Allocation* allocation = resource.memory ? allocations_.Get(resource.memory) : nullptr;
+    if (allocation && allocation->serial == resource.serial) {
+        allocation->bound -= resource.size;
+        types_[allocation->typeIndex].bound -= resource.size;
+    }
+}
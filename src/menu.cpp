@@ -8,8 +8,14 @@
 #include <filesystem>
 #include <imgui.h>
 #include <imgui_impl_win32.h>
+#include "include/api_profiler.h"
+#include "include/capture.h"
+#include "include/draw_stats.h"
+#include "include/memory_scanner.h"
+#include "include/memory_tracker.h"
 #include "include/menu.hpp"
 #include "include/mod_loader.h"
+#include "include/sampler.h"
 #include "include/json.hpp"
 
 using json = nlohmann::json;
@@ -447,6 +453,12 @@ void Render() {
         return;
 
     SMLMainMenu();
+    ApiProfiler::RenderOverlay();
+    DrawStats::RenderOverlay();
+    MemoryTracker::RenderOverlay();
+    MemoryScanner::RenderOverlay();
+    Capture::RenderOverlay();
+    Sampler::RenderOverlay();
     ModLoader::RenderAll();
 }
 }
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "include/mod_commands.h"
+
+namespace {
+
+/**
+ * @brief Command pool of one recording thread and the secondaries it can hand out again
+ */
+struct ThreadCommands {
+    VkCommandPool pool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> free;
+};
+
+struct CommandRecord {
+    ThreadCommands* owner = nullptr;
+    uint64_t generation = 0; // Render target the buffer was begun for
+    uint32_t frames = 0;     // Overlay frames in flight that execute it
+    bool published = false;
+};
+
+constexpr uint32_t kMaxFrames = 8;
+
+std::mutex lock;
+VkDevice device = VK_NULL_HANDLE;
+uint32_t queueFamily = VK_QUEUE_FAMILY_IGNORED;
+VkRenderPass renderPass = VK_NULL_HANDLE;
+VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+VkExtent2D extent = {};
+uint64_t generation = 0;
+
+std::unordered_map<std::thread::id, ThreadCommands> threads;
+std::unordered_map<VkCommandBuffer, CommandRecord> records;
+std::vector<VkCommandBuffer> pending;   // Submitted during the UI frame being built
+std::vector<VkCommandBuffer> published; // Executed on every present
+std::vector<VkCommandBuffer> frameCommands[kMaxFrames];
+
+/**
+ * @brief Give a buffer back to its thread once nothing executes it any more
+ */
+void Recycle(VkCommandBuffer commandBuffer) {
+    CommandRecord& record = records[commandBuffer];
+    if (record.frames == 0 && !record.published) {
+        record.owner->free.push_back(commandBuffer);
+    }
+}
+
+} // namespace
+
+namespace ModCommands {
+
+void OnRenderTarget(VkDevice newDevice, uint32_t newQueueFamily, VkRenderPass newRenderPass, VkFormat newColorFormat, VkExtent2D newExtent) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (device != VK_NULL_HANDLE && (device != newDevice || queueFamily != newQueueFamily)) {
+        // Pools belong to the old device or family; they go with OnDestroyDevice
+        return;
+    }
+
+    // Every frame of the old target has finished, so nothing is executing any more
+    for (std::vector<VkCommandBuffer>& commands : frameCommands) {
+        commands.clear();
+    }
+    for (auto& entry : records) {
+        if (entry.second.frames != 0 || entry.second.published) {
+            entry.second.frames = 0;
+            entry.second.published = false;
+            entry.second.owner->free.push_back(entry.first);
+        }
+    }
+    for (VkCommandBuffer commandBuffer : pending) {
+        Recycle(commandBuffer);
+    }
+    pending.clear();
+    published.clear();
+
+    device = newDevice;
+    queueFamily = newQueueFamily;
+    renderPass = newRenderPass;
+    colorFormat = newColorFormat;
+    extent = newExtent;
+    ++generation;
+}
+
+void OnDestroyDevice(VkDevice oldDevice) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (device == VK_NULL_HANDLE || device != oldDevice) {
+        return;
+    }
+
+    // Destroying a pool frees its command buffers
+    for (auto& entry : threads) {
+        if (entry.second.pool) vkDestroyCommandPool(device, entry.second.pool, nullptr);
+    }
+    threads.clear();
+    records.clear();
+    pending.clear();
+    published.clear();
+    for (std::vector<VkCommandBuffer>& commands : frameCommands) {
+        commands.clear();
+    }
+    device = VK_NULL_HANDLE;
+    queueFamily = VK_QUEUE_FAMILY_IGNORED;
+    ++generation;
+}
+
+bool GetRenderTarget(ModRenderTarget& target) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (device == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    target.device = device;
+    target.renderPass = renderPass;
+    target.subpass = 0;
+    target.colorFormat = colorFormat;
+    target.extent = extent;
+    target.generation = generation;
+    return true;
+}
+
+VkCommandBuffer Begin() {
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (device == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+
+        // Only this thread touches its pool, so recording needs no lock
+        ThreadCommands& thread = threads[std::this_thread::get_id()];
+        if (thread.pool == VK_NULL_HANDLE) {
+            VkCommandPoolCreateInfo poolInfo = {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            poolInfo.queueFamilyIndex = queueFamily;
+            VkResult result = vkCreateCommandPool(device, &poolInfo, nullptr, &thread.pool);
+            if (result != VK_SUCCESS) {
+                std::cerr << "[ERROR] Failed to create mod command pool: " << result << std::endl;
+                thread.pool = VK_NULL_HANDLE;
+                return VK_NULL_HANDLE;
+            }
+        }
+
+        if (!thread.free.empty()) {
+            commandBuffer = thread.free.back();
+            thread.free.pop_back();
+        } else {
+            VkCommandBufferAllocateInfo allocInfo = {};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = thread.pool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
+            VkResult result = vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
+            if (result != VK_SUCCESS) {
+                std::cerr << "[ERROR] Failed to allocate mod command buffer: " << result << std::endl;
+                return VK_NULL_HANDLE;
+            }
+        }
+
+        CommandRecord& record = records[commandBuffer];
+        record.owner = &thread;
+        record.generation = generation;
+    }
+
+    // Published buffers are executed again on later presents while earlier ones are in flight
+    if (BeginSecondary(commandBuffer, VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT) != VK_SUCCESS) {
+        std::lock_guard<std::mutex> guard(lock);
+        Recycle(commandBuffer);
+        return VK_NULL_HANDLE;
+    }
+    return commandBuffer;
+}
+
+void Submit(VkCommandBuffer commandBuffer) {
+    if (commandBuffer == VK_NULL_HANDLE) {
+        return;
+    }
+
+    const VkResult result = vkEndCommandBuffer(commandBuffer);
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = records.find(commandBuffer);
+    if (it == records.end()) {
+        std::cerr << "[ERROR] Submitted command buffer was not begun by the mod loader" << std::endl;
+        return;
+    }
+
+    if (result != VK_SUCCESS || it->second.generation != generation) {
+        if (result != VK_SUCCESS) {
+            std::cerr << "[ERROR] Failed to end mod command buffer: " << result << std::endl;
+        }
+        // Recorded for a render target that no longer exists
+        Recycle(commandBuffer);
+        return;
+    }
+    pending.push_back(commandBuffer);
+}
+
+VkResult BeginSecondary(VkCommandBuffer commandBuffer, VkCommandBufferUsageFlags flags) {
+    VkCommandBufferInheritanceRenderingInfo renderingInfo = {};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritance = {};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        renderingInfo.pColorAttachmentFormats = &colorFormat;
+        inheritance.renderPass = renderPass;
+        inheritance.subpass = 0;
+        if (renderPass == VK_NULL_HANDLE) {
+            inheritance.pNext = &renderingInfo;
+        }
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = flags | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritance;
+    return vkBeginCommandBuffer(commandBuffer, &beginInfo);
+}
+
+void Publish() {
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<VkCommandBuffer> retired;
+    retired.swap(published);
+    published.swap(pending);
+    for (VkCommandBuffer commandBuffer : published) {
+        records[commandBuffer].published = true;
+    }
+    for (VkCommandBuffer commandBuffer : retired) {
+        records[commandBuffer].published = false;
+        Recycle(commandBuffer);
+    }
+}
+
+bool HasCommands() {
+    std::lock_guard<std::mutex> guard(lock);
+    return !published.empty();
+}
+
+void Execute(VkCommandBuffer primary, uint32_t frame, VkCommandBuffer overlay) {
+    std::vector<VkCommandBuffer> commands;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        commands.reserve(published.size() + 1);
+        for (VkCommandBuffer commandBuffer : published) {
+            ++records[commandBuffer].frames;
+            frameCommands[frame].push_back(commandBuffer);
+            commands.push_back(commandBuffer);
+        }
+    }
+    commands.push_back(overlay);
+    vkCmdExecuteCommands(primary, static_cast<uint32_t>(commands.size()), commands.data());
+}
+
+void FrameDone(uint32_t frame) {
+    std::lock_guard<std::mutex> guard(lock);
+    for (VkCommandBuffer commandBuffer : frameCommands[frame]) {
+        CommandRecord& record = records[commandBuffer];
+        if (record.frames > 0) {
+            --record.frames;
+        }
+        Recycle(commandBuffer);
+    }
+    frameCommands[frame].clear();
+}
+
+} // namespace ModCommands
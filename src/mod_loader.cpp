@@ -13,6 +13,10 @@
 #include <iomanip>      // For std::setw and std::setfill
 
 #include "include/mod_loader.h"
+#include "include/sampler.h"
+#include "include/shared_metrics.h"
+#include "include/trace.h"
+#include "include/vmt_hooks.h"
 
 // Static member initialization
 std::vector<ModItem> ModLoader::mods;
@@ -210,6 +214,7 @@ bool ModLoader::EnsureModsDirectoryExists(const std::string& directory) {
 }
 
 bool ModLoader::LoadModFromFile(const std::string& filePath) {
+    TSML_TRACE_SCOPE("LoadModFromFile", filePath.c_str());
     try {
         // Check if file exists before attempting to load
         DWORD fileAttributes = GetFileAttributesA(filePath.c_str());
@@ -293,10 +298,12 @@ bool ModLoader::LoadModFromFile(const std::string& filePath) {
         } else {
             std::cerr << "Warning: Mod does not provide GetModInfo function" << std::endl;
         }
+        Sampler::NameModule(hModule, item.info.name.empty() ? std::filesystem::path(filePath).filename().string() : item.info.name);
         
         // Start the mod if the start function is available
         if (item.start) {
             try {
+                TSML_TRACE_SCOPE("Start", item.info.name.c_str());
                 item.start();
                 std::cout << "Started mod: " << (item.info.name.empty() ? filePath : item.info.name) << std::endl;
             } catch (const std::exception& e) {
@@ -321,6 +328,7 @@ bool ModLoader::LoadModFromFile(const std::string& filePath) {
 }
 
 void ModLoader::LoadMods() {
+    TSML_TRACE_SCOPE("LoadMods");
     try {
         std::cout << "Starting mod loading process" << std::endl;
         
@@ -368,6 +376,8 @@ void ModLoader::LoadMods() {
         size_t loadedCount = 0;
         size_t failedCount = 0;
         
+        // Vtable hooks the mods add in Start are installed together once all have started
+        VmtHooks::BeginBatch();
         for (const auto& entry : std::filesystem::directory_iterator(modsDirectory)) {
             if (entry.is_regular_file() && entry.path().extension() == ".dll") {
                 std::string filePath = entry.path().string();
@@ -378,9 +388,11 @@ void ModLoader::LoadMods() {
                 }
             }
         }
+        VmtHooks::EndBatch();
         
         std::cout << "Mod loading complete. Loaded: " << loadedCount << ", Failed: " << failedCount << std::endl;
     } catch (const std::exception& e) {
+        VmtHooks::EndBatch();
         std::cout << "Critical error during mod loading: " << e.what() << std::endl;
     }
 }
@@ -406,7 +418,11 @@ void ModLoader::Render(int index) {
     
     try {
         if (mods[index].enabled && mods[index].render) {
+            TSML_TRACE_SCOPE("Render", mods[index].info.name.c_str());
+            const auto start = std::chrono::steady_clock::now();
             mods[index].render();
+            SharedMetrics::RecordModRender(index, mods[index].info.name.c_str(),
+                std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count());
         }
     } catch (const std::exception& e) {
         std::cout << "Error rendering mod " << mods[index].info.name << ": " << e.what() << std::endl;
@@ -422,6 +438,7 @@ void ModLoader::EnableMod(int index) {
     try {
         // Always call onEnable when requested, regardless of current state
         if (mods[index].onEnable) {
+            TSML_TRACE_SCOPE("onEnable", mods[index].info.name.c_str());
             mods[index].onEnable();
             mods[index].enabled = true;
         } else {
@@ -443,6 +460,7 @@ void ModLoader::DisableMod(int index) {
     try {
         // Always call onDisable when requested, regardless of current state
         if (mods[index].onDisable) {
+            TSML_TRACE_SCOPE("onDisable", mods[index].info.name.c_str());
             mods[index].onDisable();
             mods[index].enabled = false;
         } else {
@@ -450,6 +468,7 @@ void ModLoader::DisableMod(int index) {
             // Still mark as disabled even if there's no onDisable function
             mods[index].enabled = false;
         }
+        VmtHooks::RemoveModule(mods[index].hModule);
     } catch (const std::exception& e) {
         std::cout << "Error disabling mod " << mods[index].info.name << ": " << e.what() << std::endl;
     }
@@ -515,6 +534,8 @@ void ModLoader::UnloadAllMods() {
                 
                 // Free the library
                 if (mods[i].hModule) {
+                    VmtHooks::RemoveModule(mods[i].hModule);
+                    Sampler::ForgetModule(mods[i].hModule);
                     FreeLibrary(mods[i].hModule);
                     std::cout << "Unloaded mod: " << mods[i].info.name << std::endl;
                 }
@@ -551,6 +572,8 @@ bool ModLoader::ReloadMod(int index) {
             mods[index].onDisable();
         }
         
+        VmtHooks::RemoveModule(mods[index].hModule);
+        Sampler::ForgetModule(mods[index].hModule);
         FreeLibrary(mods[index].hModule);
         
         // Remove the mod from the vector
@@ -0,0 +1,574 @@
+#include <cstring>
+#include <iostream>
+
+#include <imgui.h>
+#include <imgui_impl_vulkan.h>
+
+#include "include/overlay_cache.h"
+
+namespace {
+
+constexpr VkFormat kCacheFormat = VK_FORMAT_B8G8R8A8_UNORM; // Same as the overlay render pass
+
+// Full-screen triangle from gl_VertexIndex:
+//   gl_Position = vec4(vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2) * 2.0 - 1.0, 0.0, 1.0);
+const uint32_t kCompositeVertSpv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x0000001d, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0007000f, 0x00000000, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00040047, 0x00000002, 0x0000000b, 0x0000002a, 0x00040047, 0x00000003, 0x0000000b,
+    0x00000000, 0x00020013, 0x00000004, 0x00030021, 0x00000005, 0x00000004, 0x00040015, 0x00000006,
+    0x00000020, 0x00000001, 0x00030016, 0x00000007, 0x00000020, 0x00040017, 0x00000008, 0x00000007,
+    0x00000004, 0x00040020, 0x00000009, 0x00000001, 0x00000006, 0x00040020, 0x0000000a, 0x00000003,
+    0x00000008, 0x0004003b, 0x00000009, 0x00000002, 0x00000001, 0x0004003b, 0x0000000a, 0x00000003,
+    0x00000003, 0x0004002b, 0x00000006, 0x0000000b, 0x00000001, 0x0004002b, 0x00000006, 0x0000000c,
+    0x00000002, 0x0004002b, 0x00000007, 0x0000000d, 0x40000000, 0x0004002b, 0x00000007, 0x0000000e,
+    0xbf800000, 0x0004002b, 0x00000007, 0x0000000f, 0x00000000, 0x0004002b, 0x00000007, 0x00000010,
+    0x3f800000, 0x00050036, 0x00000004, 0x00000001, 0x00000000, 0x00000005, 0x000200f8, 0x00000011,
+    0x0004003d, 0x00000006, 0x00000012, 0x00000002, 0x000500c4, 0x00000006, 0x00000013, 0x00000012,
+    0x0000000b, 0x000500c7, 0x00000006, 0x00000014, 0x00000013, 0x0000000c, 0x000500c7, 0x00000006,
+    0x00000015, 0x00000012, 0x0000000c, 0x0004006f, 0x00000007, 0x00000016, 0x00000014, 0x0004006f,
+    0x00000007, 0x00000017, 0x00000015, 0x00050085, 0x00000007, 0x00000018, 0x00000016, 0x0000000d,
+    0x00050081, 0x00000007, 0x00000019, 0x00000018, 0x0000000e, 0x00050085, 0x00000007, 0x0000001a,
+    0x00000017, 0x0000000d, 0x00050081, 0x00000007, 0x0000001b, 0x0000001a, 0x0000000e, 0x00070050,
+    0x00000008, 0x0000001c, 0x00000019, 0x0000001b, 0x0000000f, 0x00000010, 0x0003003e, 0x00000003,
+    0x0000001c, 0x000100fd, 0x00010038,
+};
+
+// layout(set = 0, binding = 0) uniform sampler2D cache;
+//   color = texelFetch(cache, ivec2(gl_FragCoord.xy), 0);
+const uint32_t kCompositeFragSpv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000019, 0x00000000, 0x00020011, 0x00000001, 0x0003000e,
+    0x00000000, 0x00000001, 0x0007000f, 0x00000004, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+    0x00000003, 0x00030010, 0x00000001, 0x00000007, 0x00040047, 0x00000002, 0x0000000b, 0x0000000f,
+    0x00040047, 0x00000003, 0x0000001e, 0x00000000, 0x00040047, 0x00000004, 0x00000022, 0x00000000,
+    0x00040047, 0x00000004, 0x00000021, 0x00000000, 0x00020013, 0x00000005, 0x00030021, 0x00000006,
+    0x00000005, 0x00030016, 0x00000007, 0x00000020, 0x00040017, 0x00000008, 0x00000007, 0x00000004,
+    0x00040017, 0x00000009, 0x00000007, 0x00000002, 0x00040015, 0x0000000a, 0x00000020, 0x00000001,
+    0x00040017, 0x0000000b, 0x0000000a, 0x00000002, 0x00090019, 0x0000000c, 0x00000007, 0x00000001,
+    0x00000000, 0x00000000, 0x00000000, 0x00000001, 0x00000000, 0x0003001b, 0x0000000d, 0x0000000c,
+    0x00040020, 0x0000000e, 0x00000000, 0x0000000d, 0x00040020, 0x0000000f, 0x00000001, 0x00000008,
+    0x00040020, 0x00000010, 0x00000003, 0x00000008, 0x0004003b, 0x0000000e, 0x00000004, 0x00000000,
+    0x0004003b, 0x0000000f, 0x00000002, 0x00000001, 0x0004003b, 0x00000010, 0x00000003, 0x00000003,
+    0x0004002b, 0x0000000a, 0x00000011, 0x00000000, 0x00050036, 0x00000005, 0x00000001, 0x00000000,
+    0x00000006, 0x000200f8, 0x00000012, 0x0004003d, 0x00000008, 0x00000013, 0x00000002, 0x0007004f,
+    0x00000009, 0x00000014, 0x00000013, 0x00000013, 0x00000000, 0x00000001, 0x0004006e, 0x0000000b,
+    0x00000015, 0x00000014, 0x0004003d, 0x0000000d, 0x00000016, 0x00000004, 0x00040064, 0x0000000c,
+    0x00000017, 0x00000016, 0x0007005f, 0x00000008, 0x00000018, 0x00000017, 0x00000015, 0x00000002,
+    0x00000011, 0x0003003e, 0x00000003, 0x00000018, 0x000100fd, 0x00010038,
+};
+
+VkPhysicalDeviceMemoryProperties memoryProperties = {};
+
+VkImage image = VK_NULL_HANDLE;
+VkDeviceMemory memory = VK_NULL_HANDLE;
+VkImageView view = VK_NULL_HANDLE;
+VkRenderPass renderPass = VK_NULL_HANDLE;
+VkFramebuffer framebuffer = VK_NULL_HANDLE;
+VkSampler sampler = VK_NULL_HANDLE;
+VkDescriptorPool pool = VK_NULL_HANDLE;
+VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+VkPipeline pipeline = VK_NULL_HANDLE;
+VkExtent2D cacheExtent = {};
+bool ready = false;
+
+// Cache contents
+bool valid = false;
+bool empty = true;
+uint64_t cachedHash = 0;
+uint64_t pendingHash = 0;
+bool pendingEmpty = true;
+uint64_t generation = 0;
+
+/**
+ * @brief Hash a byte range, four independent multiply-xor lanes over 8-byte words
+ */
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+
+    uint64_t lanes[4] = {hash, hash ^ 0x243F6A8885A308D3ull, hash ^ 0x13198A2E03707344ull, hash ^ size};
+    for (; size >= 32; p += 32, size -= 32) {
+        for (int i = 0; i < 4; ++i) {
+            uint64_t word;
+            memcpy(&word, p + i * 8, 8);
+            lanes[i] = (lanes[i] ^ word) * kMul;
+            lanes[i] ^= lanes[i] >> 29;
+        }
+    }
+    for (; size >= 8; p += 8, size -= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        lanes[0] = ((lanes[0] ^ word) * kMul) ^ (lanes[0] >> 29);
+    }
+    uint64_t tail = 0;
+    if (size) {
+        memcpy(&tail, p, size);
+    }
+
+    uint64_t result = lanes[0] ^ tail;
+    for (int i = 1; i < 4; ++i) {
+        result = (result ^ lanes[i]) * kMul;
+        result ^= result >> 32;
+    }
+    return result;
+}
+
+template <typename T>
+uint64_t HashValue(uint64_t hash, const T& value) {
+    return HashBytes(hash, &value, sizeof(value));
+}
+
+/**
+ * @brief Hash everything that affects the rendered overlay
+ * @param cachable Cleared when a draw command has a user callback the cache cannot replay
+ */
+uint64_t HashDrawData(const ImDrawData* drawData, bool& cachable) {
+    uint64_t hash = HashValue(0, drawData->DisplayPos);
+    hash = HashValue(hash, drawData->DisplaySize);
+    hash = HashValue(hash, drawData->FramebufferScale);
+    hash = HashValue(hash, drawData->CmdListsCount);
+
+    cachable = true;
+    for (int n = 0; n < drawData->CmdListsCount; ++n) {
+        const ImDrawList* list = drawData->CmdLists[n];
+        hash = HashBytes(hash, list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert));
+        hash = HashBytes(hash, list->IdxBuffer.Data, list->IdxBuffer.Size * sizeof(ImDrawIdx));
+
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            if (cmd.UserCallback && cmd.UserCallback != ImDrawCallback_ResetRenderState) {
+                cachable = false;
+            }
+            hash = HashValue(hash, cmd.ClipRect);
+            hash = HashValue(hash, cmd.TextureId);
+            hash = HashValue(hash, cmd.VtxOffset);
+            hash = HashValue(hash, cmd.IdxOffset);
+            hash = HashValue(hash, cmd.ElemCount);
+        }
+    }
+    return hash;
+}
+
+uint32_t FindDeviceLocalMemoryType(uint32_t typeBits) {
+    constexpr VkMemoryPropertyFlags preferred[] = {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0};
+    for (VkMemoryPropertyFlags flags : preferred) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+            if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+                return i;
+            }
+        }
+    }
+    return UINT32_MAX;
+}
+
+bool CreateImage(VkDevice device) {
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = kCacheFormat;
+    imageInfo.extent = {cacheExtent.width, cacheExtent.height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkResult result = vkCreateImage(device, &imageInfo, nullptr, &image);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache image: " << result << std::endl;
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, image, &requirements);
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindDeviceLocalMemoryType(requirements.memoryTypeBits);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX) {
+        std::cerr << "[ERROR] No memory type for the overlay cache" << std::endl;
+        return false;
+    }
+
+    result = vkAllocateMemory(device, &allocInfo, nullptr, &memory);
+    if (result == VK_SUCCESS) result = vkBindImageMemory(device, image, memory, 0);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to allocate overlay cache memory: " << result << std::endl;
+        return false;
+    }
+
+    VkImageViewCreateInfo viewInfo = {};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = kCacheFormat;
+    viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    result = vkCreateImageView(device, &viewInfo, nullptr, &view);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache view: " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Render pass compatible with the overlay's, so ImGui's pipeline can draw into the cache
+ */
+bool CreateRenderPass(VkDevice device) {
+    VkAttachmentDescription attachment = {};
+    attachment.format = kCacheFormat;
+    attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkAttachmentReference colorAttachment = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachment;
+
+    // Earlier frames may still be sampling the cache, and later ones sample the new contents
+    VkSubpassDependency dependencies[2] = {};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    VkRenderPassCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.attachmentCount = 1;
+    info.pAttachments = &attachment;
+    info.subpassCount = 1;
+    info.pSubpasses = &subpass;
+    info.dependencyCount = 2;
+    info.pDependencies = dependencies;
+    VkResult result = vkCreateRenderPass(device, &info, nullptr, &renderPass);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache render pass: " << result << std::endl;
+        return false;
+    }
+
+    VkFramebufferCreateInfo framebufferInfo = {};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = renderPass;
+    framebufferInfo.attachmentCount = 1;
+    framebufferInfo.pAttachments = &view;
+    framebufferInfo.width = cacheExtent.width;
+    framebufferInfo.height = cacheExtent.height;
+    framebufferInfo.layers = 1;
+    result = vkCreateFramebuffer(device, &framebufferInfo, nullptr, &framebuffer);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache framebuffer: " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CreateDescriptors(VkDevice device) {
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    VkResult result = vkCreateSampler(device, &samplerInfo, nullptr, &sampler);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache sampler: " << result << std::endl;
+        return false;
+    }
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    binding.pImmutableSamplers = &sampler;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+    result = vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &setLayout);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache descriptor layout: " << result << std::endl;
+        return false;
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &setLayout;
+    result = vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to allocate overlay cache descriptor set: " << result << std::endl;
+        return false;
+    }
+
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler = sampler;
+    imageInfo.imageView = view;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = descriptorSet;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    return true;
+}
+
+VkShaderModule CreateShaderModule(VkDevice device, const uint32_t* code, size_t size) {
+    VkShaderModuleCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    info.codeSize = size;
+    info.pCode = code;
+
+    VkShaderModule module = VK_NULL_HANDLE;
+    VkResult result = vkCreateShaderModule(device, &info, nullptr, &module);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache shader: " << result << std::endl;
+    }
+    return module;
+}
+
+bool CreatePipeline(VkDevice device, VkRenderPass overlayPass) {
+    VkPipelineLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &setLayout;
+    VkResult result = vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache pipeline layout: " << result << std::endl;
+        return false;
+    }
+
+    VkShaderModule vertex = CreateShaderModule(device, kCompositeVertSpv, sizeof(kCompositeVertSpv));
+    VkShaderModule fragment = CreateShaderModule(device, kCompositeFragSpv, sizeof(kCompositeFragSpv));
+    if (!vertex || !fragment) {
+        if (vertex) vkDestroyShaderModule(device, vertex, nullptr);
+        if (fragment) vkDestroyShaderModule(device, fragment, nullptr);
+        return false;
+    }
+
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertex;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragment;
+    stages[1].pName = "main";
+
+    VkPipelineVertexInputStateCreateInfo vertexInput = {};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState = {};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo raster = {};
+    raster.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    raster.polygonMode = VK_POLYGON_MODE_FILL;
+    raster.cullMode = VK_CULL_MODE_NONE;
+    raster.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    raster.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // Premultiplied "over"
+    VkPipelineColorBlendAttachmentState blend = {};
+    blend.blendEnable = VK_TRUE;
+    blend.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    blend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blend.colorBlendOp = VK_BLEND_OP_ADD;
+    blend.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    blend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blend.alphaBlendOp = VK_BLEND_OP_ADD;
+    blend.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+        VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlend = {};
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments = &blend;
+
+    constexpr VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic = {};
+    dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = 2;
+    dynamic.pDynamicStates = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.stageCount = 2;
+    info.pStages = stages;
+    info.pVertexInputState = &vertexInput;
+    info.pInputAssemblyState = &inputAssembly;
+    info.pViewportState = &viewportState;
+    info.pRasterizationState = &raster;
+    info.pMultisampleState = &multisample;
+    info.pColorBlendState = &colorBlend;
+    info.pDynamicState = &dynamic;
+    info.layout = pipelineLayout;
+    info.renderPass = overlayPass;
+    info.subpass = 0;
+    result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &info, nullptr, &pipeline);
+
+    vkDestroyShaderModule(device, vertex, nullptr);
+    vkDestroyShaderModule(device, fragment, nullptr);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create overlay cache pipeline: " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+namespace OverlayCache {
+
+void OnCreateDevice(const VkPhysicalDeviceMemoryProperties& properties) {
+    memoryProperties = properties;
+}
+
+bool Create(VkDevice device, VkRenderPass overlayPass, VkDescriptorPool descriptorPool, VkExtent2D extent) {
+    Destroy(device);
+    cacheExtent = extent;
+    pool = descriptorPool;
+
+    ready = CreateImage(device) && CreateRenderPass(device) && CreateDescriptors(device) &&
+        CreatePipeline(device, overlayPass);
+    if (!ready) {
+        std::cerr << "[ERROR] Overlay cache unavailable, drawing the overlay directly" << std::endl;
+        Destroy(device);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Release the cache; the caller has waited for the frames that used it
+ */
+void Destroy(VkDevice device) {
+    if (pipeline) vkDestroyPipeline(device, pipeline, nullptr);
+    if (pipelineLayout) vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    if (descriptorSet) vkFreeDescriptorSets(device, pool, 1, &descriptorSet);
+    if (setLayout) vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+    if (sampler) vkDestroySampler(device, sampler, nullptr);
+    if (framebuffer) vkDestroyFramebuffer(device, framebuffer, nullptr);
+    if (renderPass) vkDestroyRenderPass(device, renderPass, nullptr);
+    if (view) vkDestroyImageView(device, view, nullptr);
+    if (image) vkDestroyImage(device, image, nullptr);
+    if (memory) vkFreeMemory(device, memory, nullptr);
+
+    pipeline = VK_NULL_HANDLE;
+    pipelineLayout = VK_NULL_HANDLE;
+    descriptorSet = VK_NULL_HANDLE;
+    setLayout = VK_NULL_HANDLE;
+    sampler = VK_NULL_HANDLE;
+    framebuffer = VK_NULL_HANDLE;
+    renderPass = VK_NULL_HANDLE;
+    view = VK_NULL_HANDLE;
+    image = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+    ready = false;
+    valid = false;
+}
+
+Decision Prepare(ImDrawData* drawData) {
+    if (!ready || !drawData) {
+        return CACHE_BYPASS;
+    }
+
+    bool cachable;
+    const uint64_t hash = HashDrawData(drawData, cachable);
+    if (!cachable) {
+        valid = false;
+        return CACHE_BYPASS;
+    }
+    if (valid && hash == cachedHash) {
+        return CACHE_REUSE;
+    }
+
+    pendingHash = hash;
+    pendingEmpty = drawData->TotalVtxCount == 0;
+    return CACHE_REFRESH;
+}
+
+void RecordRefresh(VkCommandBuffer cmd, ImDrawData* drawData) {
+    // An empty overlay is never composited, so there is nothing to clear
+    if (!pendingEmpty) {
+        VkClearValue clear = {};
+        VkRenderPassBeginInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        info.renderPass = renderPass;
+        info.framebuffer = framebuffer;
+        info.renderArea.extent = cacheExtent;
+        info.clearValueCount = 1;
+        info.pClearValues = &clear;
+
+        vkCmdBeginRenderPass(cmd, &info, VK_SUBPASS_CONTENTS_INLINE);
+        ImGui_ImplVulkan_RenderDrawData(drawData, cmd);
+        vkCmdEndRenderPass(cmd);
+    }
+
+    cachedHash = pendingHash;
+    empty = pendingEmpty;
+    valid = true;
+    ++generation;
+}
+
+void RecordComposite(VkCommandBuffer cmd) {
+    if (empty) {
+        return;
+    }
+
+    VkViewport viewport = {0.0f, 0.0f, static_cast<float>(cacheExtent.width), static_cast<float>(cacheExtent.height), 0.0f, 1.0f};
+    VkRect2D scissor = {{0, 0}, cacheExtent};
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+    vkCmdDraw(cmd, 3, 1, 0, 0);
+}
+
+bool IsValid() {
+    return ready && valid;
+}
+
+void Invalidate() {
+    valid = false;
+}
+
+uint64_t Generation() {
+    return generation;
+}
+
+} // namespace OverlayCache
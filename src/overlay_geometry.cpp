@@ -0,0 +1,100 @@
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+#include <imgui.h>
+
+#include "include/json.hpp"
+#include "include/overlay_geometry.h"
+#include "include/thread_pool.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr const char* markFile = "tsml_overlay_geometry.json";
+
+// Bounds for the pre-sized buffers, so a damaged file cannot ask for too much
+constexpr VkDeviceSize kMinSize = 64ull << 10;
+constexpr VkDeviceSize kMaxSize = 64ull << 20;
+
+std::atomic<uint64_t> vertexMark{0};
+std::atomic<uint64_t> indexMark{0};
+std::atomic<bool> savePending{false};
+std::mutex saveLock;
+
+bool Raise(std::atomic<uint64_t>& mark, uint64_t bytes) {
+    uint64_t current = mark.load();
+    while (bytes > current) {
+        if (mark.compare_exchange_weak(current, bytes)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Load() {
+    std::ifstream file(markFile);
+    if (!file.is_open()) {
+        return;
+    }
+
+    try {
+        json marks = json::parse(file);
+        // The backend may be set up again later in the run; never lower a mark
+        Raise(vertexMark, marks.value("vertexBytes", uint64_t(0)));
+        Raise(indexMark, marks.value("indexBytes", uint64_t(0)));
+    } catch (const json::exception& e) {
+        std::cerr << "[ERROR] Failed to parse " << markFile << ": " << e.what() << std::endl;
+    }
+}
+
+void Save() {
+    std::lock_guard<std::mutex> guard(saveLock);
+    savePending = false;
+
+    json marks;
+    marks["vertexBytes"] = vertexMark.load();
+    marks["indexBytes"] = indexMark.load();
+    std::ofstream file(markFile, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Failed to open " << markFile << std::endl;
+        return;
+    }
+    file << marks.dump(2);
+}
+
+} // namespace
+
+namespace OverlayGeometry {
+
+VkDeviceSize MinAllocationSize() {
+    Load();
+
+    // Half again as much as the largest frame seen, rounded up to a power of two
+    const uint64_t mark = vertexMark > indexMark ? vertexMark.load() : indexMark.load();
+    const VkDeviceSize wanted = mark + mark / 2;
+    VkDeviceSize size = kMinSize;
+    while (size < wanted && size < kMaxSize) {
+        size <<= 1;
+    }
+
+    std::cout << "[+] Overlay geometry buffers start at " << (size >> 10) << " KiB" << std::endl;
+    return size;
+}
+
+void Track(const ImDrawData* drawData) {
+    if (!drawData) {
+        return;
+    }
+
+    const bool vertexGrew = Raise(vertexMark, static_cast<uint64_t>(drawData->TotalVtxCount) * sizeof(ImDrawVert));
+    const bool indexGrew = Raise(indexMark, static_cast<uint64_t>(drawData->TotalIdxCount) * sizeof(ImDrawIdx));
+    if ((vertexGrew || indexGrew) && !savePending.exchange(true)) {
+        ThreadPool::Shared().Submit(Save);
+    }
+}
+
+} // namespace OverlayGeometry
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <vector>
+
+#include "include/overlay_submit.h"
+#include "include/trace.h"
+
+namespace {
+
+/**
+ * @brief Signal operations of a frame's last batch: the binary semaphore present waits on, and
+ *        the frame's timeline value when frames are tracked by a timeline semaphore
+ */
+struct FinalSignal {
+    VkSemaphore semaphores[2] = {};
+    uint64_t values[2] = {};
+    VkTimelineSemaphoreSubmitInfo timeline = {};
+
+    /**
+     * @brief Point a submit's signal operations at this object, which must outlive the submit
+     */
+    void Attach(VkSubmitInfo& submitInfo, VkSemaphore presentSemaphore, const OverlaySubmit::Frame& frame) {
+        semaphores[0] = presentSemaphore;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = semaphores;
+        if (frame.timeline == VK_NULL_HANDLE) {
+            return;
+        }
+
+        semaphores[1] = frame.timeline;
+        values[1] = frame.timelineValue;
+        timeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timeline.signalSemaphoreValueCount = 2;
+        timeline.pSignalSemaphoreValues = values;
+        timeline.pNext = submitInfo.pNext;
+        submitInfo.pNext = &timeline;
+        submitInfo.signalSemaphoreCount = 2;
+    }
+};
+
+} // namespace
+
+namespace OverlaySubmit {
+
+VkResult Submit(const VkLayerDispatchTable& dispatch, const Frame& frame, VkSemaphore& presentWait, bool& overlaySubmitted) {
+    overlaySubmitted = false;
+    const bool releaseBatch = frame.transfer || (frame.gameWaitCount == 0 && frame.presentQueue != frame.graphicsQueue);
+    VkResult result = VK_SUCCESS;
+
+    if (releaseBatch) {
+        std::vector<VkPipelineStageFlags> stages_wait(frame.gameWaitCount, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = frame.gameWaitCount;
+        submitInfo.pWaitSemaphores = frame.gameWaits;
+        submitInfo.pWaitDstStageMask = stages_wait.data();
+        submitInfo.commandBufferCount = frame.transfer ? 1 : 0;
+        submitInfo.pCommandBuffers = &frame.release;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &frame.released;
+
+        TSML_TRACE_SCOPE("vkQueueSubmit", "release");
+        result = dispatch.QueueSubmit(frame.presentQueue, 1, &submitInfo, VK_NULL_HANDLE);
+        if (result != VK_SUCCESS) {
+            std::cerr << "[ERROR] Failed to submit to present queue: " << result << std::endl;
+            return result;
+        }
+    }
+
+    // The overlay starts with the capture copy or the backbuffer's color attachment load
+    {
+        const uint32_t waitCount = releaseBatch ? 1 : frame.gameWaitCount;
+        std::vector<VkPipelineStageFlags> stages_wait(waitCount,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount = waitCount;
+        submitInfo.pWaitSemaphores = releaseBatch ? &frame.released : frame.gameWaits;
+        submitInfo.pWaitDstStageMask = stages_wait.data();
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &frame.overlay;
+
+        // When the image goes back to the present family, that batch finishes the frame instead
+        FinalSignal signal;
+        if (frame.transfer) {
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &frame.drawn;
+        } else {
+            signal.Attach(submitInfo, frame.drawn, frame);
+        }
+
+        TSML_TRACE_SCOPE("vkQueueSubmit", "overlay");
+        result = dispatch.QueueSubmit(frame.graphicsQueue, 1, &submitInfo, frame.transfer ? VK_NULL_HANDLE : frame.fence);
+        if (result != VK_SUCCESS) {
+            std::cerr << "[ERROR] Failed to submit to graphics queue: " << result << std::endl;
+            return result;
+        }
+        overlaySubmitted = true;
+    }
+
+    if (!frame.transfer) {
+        presentWait = frame.drawn;
+        return VK_SUCCESS;
+    }
+
+    constexpr VkPipelineStageFlags stages_wait = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &frame.drawn;
+    submitInfo.pWaitDstStageMask = &stages_wait;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &frame.acquire;
+    FinalSignal signal;
+    signal.Attach(submitInfo, frame.ready, frame);
+
+    TSML_TRACE_SCOPE("vkQueueSubmit", "acquire");
+    result = dispatch.QueueSubmit(frame.presentQueue, 1, &submitInfo, frame.fence);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to submit to present queue: " << result << std::endl;
+        return result;
+    }
+    presentWait = frame.ready;
+    return VK_SUCCESS;
+}
+
+} // namespace OverlaySubmit
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <windows.h>
+
+#include "include/api.h"
+#include "include/pointer_paths.h"
+
+struct ModPointerPath {
+    std::string name;
+    uintptr_t baseOffset = 0;
+    std::vector<uintptr_t> offsets;
+    int node = -1; // Node whose pointer the last offset applies to, -1 when the value is static
+
+    std::vector<uint8_t> data; // Snapshot, written by Resolve
+    bool valid = false;
+};
+
+namespace {
+
+constexpr size_t kMaxSnapshotSize = 4096;
+
+/**
+ * @brief One pointer read in a chain, shared by every path with the same prefix
+ */
+struct Node {
+    int parent;              // -1 for a root, read at skyBase + offset
+    uintptr_t offset;
+    uintptr_t pointer = 0;   // Value read at the node's address
+    uintptr_t readFrom = 0;  // Parent pointer the value was read with
+    bool valid = false;
+};
+
+// Guards registration against Resolve; nodes are in creation order, so parents come first
+std::mutex lock;
+std::vector<Node> nodes;
+std::vector<std::unique_ptr<ModPointerPath>> paths;
+std::unordered_map<std::string, ModPointerPath*> pathsByName;
+
+bool Read(uintptr_t address, void* out, size_t size) {
+    SIZE_T read = 0;
+    return address != 0
+        && ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<LPCVOID>(address), out, size, &read)
+        && read == size;
+}
+
+int FindOrAddNode(int parent, uintptr_t offset) {
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].parent == parent && nodes[i].offset == offset) {
+            return static_cast<int>(i);
+        }
+    }
+    nodes.push_back({ parent, offset });
+    return static_cast<int>(nodes.size() - 1);
+}
+
+/**
+ * @brief Make a chain read every pointer again on the next Resolve
+ */
+void Invalidate(int node) {
+    for (; node >= 0; node = nodes[node].parent) {
+        nodes[node].valid = false;
+    }
+}
+
+} // namespace
+
+namespace PointerPaths {
+
+ModPointerPath* Register(const std::string& name, uintptr_t baseOffset, const std::vector<uintptr_t>& offsets, size_t size) {
+    if (size == 0 || size > kMaxSnapshotSize) {
+        std::cerr << "[ERROR] Pointer path " << name << " has an invalid size: " << size << std::endl;
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = pathsByName.find(name);
+    if (it != pathsByName.end()) {
+        ModPointerPath* existing = it->second;
+        if (existing->baseOffset != baseOffset || existing->offsets != offsets || existing->data.size() != size) {
+            std::cerr << "[ERROR] Pointer path " << name << " is already registered with a different chain" << std::endl;
+            return nullptr;
+        }
+        return existing;
+    }
+
+    auto path = std::make_unique<ModPointerPath>();
+    path->name = name;
+    path->baseOffset = baseOffset;
+    path->offsets = offsets;
+    path->data.resize(size);
+    if (!offsets.empty()) {
+        int node = FindOrAddNode(-1, baseOffset);
+        for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+            node = FindOrAddNode(node, offsets[i]);
+        }
+        path->node = node;
+    }
+
+    ModPointerPath* registered = path.get();
+    pathsByName.emplace(name, registered);
+    paths.push_back(std::move(path));
+    return registered;
+}
+
+ModPointerPath* Find(const std::string& name) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = pathsByName.find(name);
+    return it != pathsByName.end() ? it->second : nullptr;
+}
+
+void Resolve() {
+    const uintptr_t skyBase = ModApi::Instance().GetSkyBase();
+    if (!skyBase) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (Node& node : nodes) {
+        uintptr_t from = skyBase;
+        if (node.parent >= 0) {
+            const Node& parent = nodes[node.parent];
+            if (!parent.valid) {
+                node.valid = false;
+                continue;
+            }
+            from = parent.pointer;
+
+            // The pointer below an unchanged parent is reused; roots are read every frame
+            if (node.valid && node.readFrom == from) {
+                continue;
+            }
+        }
+        node.readFrom = from;
+        node.valid = Read(from + node.offset, &node.pointer, sizeof(node.pointer)) && node.pointer != 0;
+    }
+
+    for (const std::unique_ptr<ModPointerPath>& path : paths) {
+        uintptr_t address = skyBase + path->baseOffset;
+        if (path->node >= 0) {
+            const Node& node = nodes[path->node];
+            if (!node.valid) {
+                path->valid = false;
+                continue;
+            }
+            address = node.pointer + path->offsets.back();
+        }
+
+        path->valid = Read(address, path->data.data(), path->data.size());
+        if (!path->valid) {
+            Invalidate(path->node);
+        }
+    }
+}
+
+const void* Get(ModPointerPath* path, size_t size) {
+    if (!path || !path->valid || path->data.size() != size) {
+        return nullptr;
+    }
+    return path->data.data();
+}
+
+} // namespace PointerPaths
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <cstring>
+
+#include "include/rtti_scan.h"
+
+namespace {
+
+using RttiScan::Image;
+using RttiScan::Section;
+
+constexpr uint32_t kLocatorSignature = 1; // x64 locators hold image-relative offsets
+constexpr uint32_t kMaxSlots = 4096;
+constexpr uint32_t kMaxBases = 1024;
+constexpr size_t kMaxNameLength = 1024;
+constexpr uint32_t kSectionExecute = 0x20000000;
+
+template <typename T>
+bool ReadAt(const uint8_t* data, size_t size, uint64_t offset, T& out) {
+    if (offset > size || size - offset < sizeof(T)) {
+        return false;
+    }
+    memcpy(&out, data + offset, sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool Read(const Image& image, uint64_t rva, T& out) {
+    return ReadAt(image.data, image.size, rva, out);
+}
+
+/**
+ * @brief Image-relative address of a pointer into the image
+ */
+bool ToRva(const Image& image, uint64_t address, uint32_t& rva) {
+    if (address < image.base || address - image.base >= image.size) {
+        return false;
+    }
+    rva = static_cast<uint32_t>(address - image.base);
+    return true;
+}
+
+bool IsCode(const Image& image, uint64_t address) {
+    uint32_t rva;
+    if (!ToRva(image, address, rva)) {
+        return false;
+    }
+    for (const Section& section : image.sections) {
+        if (section.executable && rva >= section.rva && rva - section.rva < section.size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReadName(const Image& image, uint32_t rva, std::string& name) {
+    const size_t limit = std::min(kMaxNameLength, image.size - std::min<size_t>(rva, image.size));
+    const void* end = memchr(image.data + rva, '\0', limit);
+    if (!end) {
+        return false;
+    }
+    name.assign(reinterpret_cast<const char*>(image.data + rva), static_cast<const char*>(end));
+    return true;
+}
+
+/**
+ * @brief Decorated name of a Type Descriptor: vftable pointer, spare pointer, then the name
+ */
+bool ReadTypeName(const Image& image, int32_t descriptor, std::string& name) {
+    return descriptor > 0 && ReadName(image, static_cast<uint32_t>(descriptor) + 16, name) && name.rfind(".?A", 0) == 0;
+}
+
+/**
+ * @brief Base class names from a Class Hierarchy Descriptor; entry 0 is the class itself
+ */
+void ReadBases(const Image& image, int32_t hierarchy, std::vector<std::string>& bases) {
+    uint32_t count = 0;
+    int32_t array = 0;
+    if (hierarchy <= 0 || !Read(image, uint64_t(hierarchy) + 8, count) || !Read(image, uint64_t(hierarchy) + 12, array) || array <= 0) {
+        return;
+    }
+
+    for (uint32_t i = 1; i < count && i < kMaxBases; ++i) {
+        int32_t descriptor = 0;
+        int32_t type = 0;
+        std::string name;
+        if (!Read(image, uint64_t(array) + i * 4, descriptor) || descriptor <= 0
+            || !Read(image, uint64_t(descriptor), type) || !ReadTypeName(image, type, name)) {
+            return;
+        }
+        bases.push_back(RttiScan::Demangle(name));
+    }
+}
+
+} // namespace
+
+namespace RttiScan {
+
+bool ReadSections(const uint8_t* data, size_t size, std::vector<Section>& sections) {
+    uint32_t header = 0;
+    uint32_t signature = 0;
+    uint16_t count = 0;
+    uint16_t optionalSize = 0;
+    uint16_t magic = 0;
+    if (!ReadAt(data, size, 0x3C, header) || !ReadAt(data, size, header, signature) || signature != 0x00004550
+        || !ReadAt(data, size, header + 6, count) || !ReadAt(data, size, header + 20, optionalSize)
+        || !ReadAt(data, size, header + 24, magic) || magic != 0x20B) {
+        return false;
+    }
+
+    sections.clear();
+    const uint64_t table = uint64_t(header) + 24 + optionalSize;
+    for (uint16_t i = 0; i < count; ++i) {
+        const uint64_t entry = table + i * 40ull;
+        char name[9] = {};
+        uint32_t virtualSize = 0;
+        uint32_t rva = 0;
+        uint32_t characteristics = 0;
+        if (entry + 40 > size || !ReadAt(data, size, entry + 8, virtualSize) || !ReadAt(data, size, entry + 12, rva)
+            || !ReadAt(data, size, entry + 36, characteristics)) {
+            return false;
+        }
+        memcpy(name, data + entry, 8);
+        sections.push_back({ name, rva, virtualSize, (characteristics & kSectionExecute) != 0 });
+    }
+    return true;
+}
+
+uint64_t HashHeaders(const uint8_t* data, size_t size) {
+    uint32_t header = 0;
+    uint32_t headersSize = 0;
+    if (!ReadAt(data, size, 0x3C, header) || !ReadAt(data, size, uint64_t(header) + 24 + 60, headersSize)) {
+        headersSize = 0x400;
+    }
+
+    // FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < std::min<size_t>(headersSize, size); ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+std::string Demangle(const std::string& decorated) {
+    const char* kind = nullptr;
+    if (decorated.rfind(".?AV", 0) == 0) {
+        kind = "class ";
+    } else if (decorated.rfind(".?AU", 0) == 0) {
+        kind = "struct ";
+    }
+
+    const size_t end = decorated.size() >= 2 ? decorated.size() - 2 : 0;
+    if (!kind || decorated.compare(end, 2, "@@") != 0 || end <= 4 || decorated.find('?', 4) != std::string::npos) {
+        return decorated;
+    }
+
+    // Bar@Foo: innermost name first
+    std::string name = kind;
+    std::vector<std::string> parts;
+    for (size_t start = 4; start < end;) {
+        const size_t at = std::min(decorated.find('@', start), end);
+        parts.push_back(decorated.substr(start, at - start));
+        start = at + 1;
+    }
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+        name += *it;
+        if (it + 1 != parts.rend()) name += "::";
+    }
+    return name;
+}
+
+std::vector<ClassInfo> Scan(const Image& image) {
+    std::vector<ClassInfo> classes;
+    for (const Section& section : image.sections) {
+        if (section.executable || section.name != ".rdata") {
+            continue;
+        }
+
+        const uint64_t end = std::min<uint64_t>(uint64_t(section.rva) + section.size, image.size);
+        for (uint64_t rva = (section.rva + 7) & ~7ull; rva + 16 <= end; rva += 8) {
+            // The slot before a vtable points at its locator, which points back at itself
+            uint64_t pointer = 0;
+            uint32_t locator = 0;
+            if (!Read(image, rva, pointer) || !ToRva(image, pointer, locator)) {
+                continue;
+            }
+
+            uint32_t signature = 0;
+            uint32_t offset = 0;
+            int32_t type = 0;
+            int32_t hierarchy = 0;
+            int32_t self = 0;
+            if (!Read(image, locator, signature) || signature != kLocatorSignature
+                || !Read(image, uint64_t(locator) + 20, self) || self != static_cast<int32_t>(locator)
+                || !Read(image, uint64_t(locator) + 4, offset) || !Read(image, uint64_t(locator) + 12, type)
+                || !Read(image, uint64_t(locator) + 16, hierarchy)) {
+                continue;
+            }
+
+            ClassInfo info;
+            if (!ReadTypeName(image, type, info.decorated)) {
+                continue;
+            }
+
+            info.vtable = static_cast<uint32_t>(rva + 8);
+            info.offset = offset;
+            info.slots = 0;
+            uint64_t function = 0;
+            while (info.slots < kMaxSlots && Read(image, uint64_t(info.vtable) + info.slots * 8ull, function) && IsCode(image, function)) {
+                ++info.slots;
+            }
+            if (info.slots == 0) {
+                continue;
+            }
+
+            info.name = Demangle(info.decorated);
+            ReadBases(image, hierarchy, info.bases);
+            classes.push_back(std::move(info));
+        }
+    }
+    return classes;
+}
+
+} // namespace RttiScan
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "include/sample_profile.h"
+
+namespace SampleProfile {
+
+void ModuleMap::Assign(std::vector<ModuleRange> ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const ModuleRange& a, const ModuleRange& b) {
+        return a.base < b.base;
+    });
+
+    // Overlapping ranges would make the binary search ambiguous; the lower one wins
+    ranges_.clear();
+    ranges_.reserve(ranges.size());
+    for (ModuleRange& range : ranges) {
+        if (range.end <= range.base || (!ranges_.empty() && range.base < ranges_.back().end)) {
+            continue;
+        }
+        ranges_.push_back(std::move(range));
+    }
+}
+
+int ModuleMap::Find(uintptr_t address) const {
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), address, [](uintptr_t value, const ModuleRange& range) {
+        return value < range.base;
+    });
+    if (it == ranges_.begin()) {
+        return -1;
+    }
+    --it;
+    return address < it->end ? static_cast<int>(it - ranges_.begin()) : -1;
+}
+
+std::string ModuleMap::Symbolize(uintptr_t address) const {
+    char text[48];
+    const int index = Find(address);
+    if (index < 0) {
+        snprintf(text, sizeof(text), "0x%llx", static_cast<unsigned long long>(address));
+        return text;
+    }
+    snprintf(text, sizeof(text), "+0x%llx", static_cast<unsigned long long>(address - ranges_[index].base));
+    return ranges_[index].name + text;
+}
+
+bool FunctionTable::Assign(const uint8_t* image, size_t size) {
+    *this = FunctionTable();
+    auto read = [image, size](uint64_t offset, uint32_t& value) {
+        if (offset + sizeof(value) > size) return false;
+        memcpy(&value, image + offset, sizeof(value));
+        return true;
+    };
+
+    // The exception directory is the fourth data directory of the PE32+ optional header
+    uint32_t header = 0, signature = 0, magic = 0, directories = 0, rva = 0, bytes = 0;
+    if (!read(0x3C, header) || !read(header, signature) || signature != 0x00004550 || !read(header + 24, magic)
+        || (magic & 0xFFFF) != 0x20B || !read(header + 24 + 108, directories) || directories <= 3
+        || !read(header + 24 + 112 + 3 * 8, rva) || !read(header + 24 + 112 + 3 * 8 + 4, bytes)) {
+        return false;
+    }
+    if (bytes < sizeof(FunctionEntry) || rva % alignof(FunctionEntry) != 0 || uint64_t(rva) + bytes > size) {
+        return false;
+    }
+
+    image_ = image;
+    size_ = size;
+    entries_ = reinterpret_cast<const FunctionEntry*>(image + rva);
+    count_ = bytes / sizeof(FunctionEntry);
+    return true;
+}
+
+const FunctionEntry* FunctionTable::Find(uint32_t rva) const {
+    const FunctionEntry* it = std::upper_bound(entries_, entries_ + count_, rva, [](uint32_t value, const FunctionEntry& entry) {
+        return value < entry.begin;
+    });
+    if (it == entries_) {
+        return nullptr;
+    }
+    --it;
+    if (rva >= it->end) {
+        return nullptr;
+    }
+
+    // Function fragments can share the primary entry's unwind data through an indirect entry
+    if (it->unwind & 1) {
+        const uint32_t target = it->unwind & ~1u;
+        if (target % alignof(FunctionEntry) != 0 || uint64_t(target) + sizeof(FunctionEntry) > size_) {
+            return nullptr;
+        }
+        it = reinterpret_cast<const FunctionEntry*>(image_ + target);
+    }
+    return it;
+}
+
+void Aggregator::Add(const ModuleMap& modules, const uintptr_t* frames, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    ++samples_;
+    ++addresses_[frames[0]];
+
+    // A module counts once per sample however many frames of the stack it owns
+    int seen[32];
+    size_t seenCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const int index = modules.Find(frames[i]);
+        if (index < 0) {
+            if (i == 0) ++unknown_;
+            continue;
+        }
+
+        Counts& counts = modules_[modules.At(index).name];
+        if (i == 0) ++counts.self;
+        if (std::find(seen, seen + seenCount, index) != seen + seenCount) {
+            continue;
+        }
+        ++counts.inclusive;
+        if (seenCount < sizeof(seen) / sizeof(seen[0])) {
+            seen[seenCount++] = index;
+        }
+    }
+}
+
+Report Aggregator::Build(const ModuleMap& modules, size_t hottest) const {
+    Report report;
+    report.samples = samples_;
+    report.unknown = unknown_;
+
+    report.modules.reserve(modules_.size());
+    for (const auto& [name, counts] : modules_) {
+        report.modules.push_back({ name, counts.self, counts.inclusive });
+    }
+    std::sort(report.modules.begin(), report.modules.end(), [](const ModuleShare& a, const ModuleShare& b) {
+        return a.self != b.self ? a.self > b.self : a.inclusive > b.inclusive;
+    });
+
+    std::vector<std::pair<uintptr_t, uint64_t>> addresses(addresses_.begin(), addresses_.end());
+    const size_t kept = std::min(hottest, addresses.size());
+    std::partial_sort(addresses.begin(), addresses.begin() + kept, addresses.end(),
+        [](const auto& a, const auto& b) { return a.second > b.second; });
+    report.hottest.reserve(kept);
+    for (size_t i = 0; i < kept; ++i) {
+        report.hottest.push_back({ modules.Symbolize(addresses[i].first), addresses[i].second });
+    }
+    return report;
+}
+
+void Aggregator::Reset() {
+    modules_.clear();
+    addresses_.clear();
+    samples_ = 0;
+    unknown_ = 0;
+}
+
+} // namespace SampleProfile
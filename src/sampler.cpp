@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <windows.h>
+#include <libmem.h>
+
+#include <imgui.h>
+
+#include "include/layer_config.h"
+#include "include/sample_profile.h"
+#include "include/sampler.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kMaxDepth = 16;
+constexpr size_t kStackCopy = 32 * 1024; // Bytes of stack copied per sample, from the stack pointer up
+constexpr size_t kHotAddresses = 8;
+constexpr auto kReportPeriod = std::chrono::seconds(2);
+
+struct WatchedThread {
+    const char* role;
+    DWORD threadId;
+    HANDLE handle;
+    uintptr_t stackLow;  // Reserved range of the thread's stack, empty if it could not be read
+    uintptr_t stackHigh;
+    SampleProfile::Aggregator aggregator; // Sampler thread only
+    SampleProfile::Report published;      // Guarded by lock
+};
+
+// Guards watched, published reports and modNames
+std::mutex lock;
+std::vector<std::unique_ptr<WatchedThread>> watched;
+std::unordered_map<uintptr_t, std::string> modNames;
+
+std::atomic<bool> started{false};
+// Sampler thread only
+SampleProfile::ModuleMap modules;
+std::vector<SampleProfile::FunctionTable> functionTables; // By module index
+// Twice kStackCopy: a frame cut off by the end of the copy reads the zeros after it
+std::unique_ptr<uint8_t[]> stackCopy;
+
+/**
+ * @brief Run body, turning an access violation into a failure
+ *
+ * A module may be unloaded between two refreshes of the module list, taking
+ * its headers and unwind data with it.
+ */
+bool Guarded(void (*body)(void*), void* context) {
+#ifdef _MSC_VER
+    __try {
+        body(context);
+        return true;
+    } __except (GetExceptionCode() == EXCEPTION_ACCESS_VIOLATION ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH) {
+        return false;
+    }
+#else
+    body(context);
+    return true;
+#endif
+}
+
+lm_bool_t LM_CALL CollectModule(lm_module_t* module, lm_void_t* arg) {
+    auto& ranges = *static_cast<std::vector<SampleProfile::ModuleRange>*>(arg);
+    ranges.push_back({ static_cast<uintptr_t>(module->base), static_cast<uintptr_t>(module->end), module->name });
+    return LM_TRUE;
+}
+
+/**
+ * @brief Re-read the process's modules, so DLLs loaded since the last report are attributed
+ */
+void RefreshModules() {
+    std::vector<SampleProfile::ModuleRange> ranges;
+    LM_EnumModules(CollectModule, &ranges);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (SampleProfile::ModuleRange& range : ranges) {
+            auto it = modNames.find(range.base);
+            if (it != modNames.end()) {
+                range.name = it->second + " (mod)";
+            }
+        }
+    }
+    modules.Assign(std::move(ranges));
+
+    functionTables.assign(modules.Size(), {});
+    for (size_t i = 0; i < modules.Size(); ++i) {
+        struct Job {
+            SampleProfile::FunctionTable* table;
+            const SampleProfile::ModuleRange* range;
+        } job{ &functionTables[i], &modules.At(static_cast<int>(i)) };
+        if (!Guarded([](void* context) {
+                Job& job = *static_cast<Job*>(context);
+                job.table->Assign(reinterpret_cast<const uint8_t*>(job.range->base), job.range->end - job.range->base);
+            }, &job)) {
+            functionTables[i] = {};
+        }
+    }
+}
+
+/**
+ * @brief The reserved range of a thread's stack, from the stack base in its TEB
+ */
+bool ReadStackRange(HANDLE thread, uintptr_t& low, uintptr_t& high) {
+    struct ThreadBasicInformation {
+        LONG exitStatus;
+        PVOID teb;
+        HANDLE clientId[2];
+        ULONG_PTR affinityMask;
+        LONG priority;
+        LONG basePriority;
+    };
+    using QueryThread = LONG(NTAPI*)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+    static const auto query = reinterpret_cast<QueryThread>(
+        GetProcAddress(GetModuleHandleA("ntdll.dll"), "NtQueryInformationThread"));
+
+    ThreadBasicInformation info = {};
+    if (!query || query(thread, 0, &info, sizeof(info), nullptr) < 0 || !info.teb) {
+        return false;
+    }
+
+    // The base stays put for the thread's lifetime; the limit in the TEB moves as the stack grows
+    high = reinterpret_cast<uintptr_t>(static_cast<const NT_TIB*>(info.teb)->StackBase);
+    MEMORY_BASIC_INFORMATION region;
+    if (!high || !VirtualQuery(reinterpret_cast<LPCVOID>(high - 1), &region, sizeof(region))) {
+        return false;
+    }
+    low = reinterpret_cast<uintptr_t>(region.AllocationBase);
+    return low < high;
+}
+
+/**
+ * @brief Take a thread's registers and the top of its stack into stackCopy
+ *
+ * The target may hold the heap or loader lock while it is suspended, so
+ * nothing here allocates or looks up unwind data: it only copies memory from
+ * the stack pointer up, all of which is committed while the thread is
+ * stopped. Unwinding happens on the copy once the thread runs again.
+ * @param copied Set to the number of bytes copied, 0 if the stack pointer is outside the thread's stack
+ */
+bool CopyStack(const WatchedThread& thread, CONTEXT& context, size_t& copied) {
+    if (SuspendThread(thread.handle) == static_cast<DWORD>(-1)) {
+        return false;
+    }
+
+    memset(&context, 0, sizeof(context));
+    context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+    const bool captured = GetThreadContext(thread.handle, &context) != FALSE;
+
+    // A thread running on another stack, such as a fiber's, is sampled without its callers
+    copied = 0;
+    if (captured && context.Rsp >= thread.stackLow && context.Rsp < thread.stackHigh) {
+        copied = std::min<size_t>(thread.stackHigh - context.Rsp, kStackCopy);
+        memcpy(stackCopy.get(), reinterpret_cast<const void*>(context.Rsp), copied);
+    }
+
+    ResumeThread(thread.handle);
+    return captured;
+}
+
+struct UnwindJob {
+    CONTEXT* context;
+    size_t copied;
+    uintptr_t* frames;
+    size_t maxFrames;
+    size_t count; // Frames written so far, kept if the unwind faults
+};
+
+/**
+ * @brief Walk the copied stack with the unwind data of the modules found by RefreshModules
+ *
+ * Functions outside every module, such as generated code, are taken for leaf
+ * functions. RtlVirtualUnwind reads the stack through the stack and frame
+ * pointers, so both point into the copy while it runs.
+ */
+void Unwind(void* argument) {
+    UnwindJob& job = *static_cast<UnwindJob*>(argument);
+    CONTEXT& context = *job.context;
+    const uintptr_t top = static_cast<uintptr_t>(context.Rsp);
+    const uintptr_t end = top + job.copied;
+    const uintptr_t copy = reinterpret_cast<uintptr_t>(stackCopy.get());
+    auto toCopy = [&](DWORD64& reg) {
+        if (reg >= top && reg < end) reg = reg - top + copy;
+    };
+    auto fromCopy = [&](DWORD64& reg) {
+        if (reg >= copy && reg < copy + 2 * kStackCopy) reg = reg - copy + top;
+    };
+
+    job.frames[job.count++] = static_cast<uintptr_t>(context.Rip);
+    while (job.count < job.maxFrames && context.Rsp >= top && context.Rsp < end) {
+        const DWORD64 stackPointer = context.Rsp;
+        const int module = modules.Find(static_cast<uintptr_t>(context.Rip));
+        const SampleProfile::FunctionEntry* function = module < 0 ? nullptr :
+            functionTables[module].Find(static_cast<uint32_t>(context.Rip - modules.At(module).base));
+
+        if (function) {
+            PVOID handlerData = nullptr;
+            DWORD64 establisherFrame = 0;
+            toCopy(context.Rsp);
+            toCopy(context.Rbp);
+            RtlVirtualUnwind(UNW_FLAG_NHANDLER, modules.At(module).base, context.Rip,
+                reinterpret_cast<PRUNTIME_FUNCTION>(const_cast<SampleProfile::FunctionEntry*>(function)),
+                &context, &handlerData, &establisherFrame, nullptr);
+            fromCopy(context.Rsp);
+            fromCopy(context.Rbp);
+        } else {
+            // Leaf function without unwind data: the return address is on top of the stack
+            if (context.Rsp + sizeof(DWORD64) > end) {
+                break;
+            }
+            memcpy(&context.Rip, stackCopy.get() + (context.Rsp - top), sizeof(DWORD64));
+            context.Rsp += sizeof(DWORD64);
+        }
+
+        // Callers are further up the stack; anything else is a misread frame
+        if (context.Rip == 0 || context.Rsp <= stackPointer) {
+            break;
+        }
+        job.frames[job.count++] = static_cast<uintptr_t>(context.Rip);
+    }
+}
+
+/**
+ * @brief Read the instruction pointer and return addresses of a thread
+ * @return Number of frames written, 0 if the thread could not be sampled
+ */
+size_t CaptureStack(const WatchedThread& thread, uintptr_t* frames, size_t maxFrames) {
+    CONTEXT context;
+    size_t copied = 0;
+    if (!CopyStack(thread, context, copied)) {
+        return 0;
+    }
+
+    UnwindJob job{ &context, copied, frames, maxFrames, 0 };
+    Guarded(Unwind, &job);
+    return job.count;
+}
+
+void Run() {
+    const DWORD interval = LayerConfig::Get().sampler.intervalMs;
+    const size_t depth = std::min<size_t>(LayerConfig::Get().sampler.stackDepth, kMaxDepth);
+
+    stackCopy = std::make_unique<uint8_t[]>(2 * kStackCopy);
+    RefreshModules();
+    Clock::time_point reportStart = Clock::now();
+    std::vector<WatchedThread*> threads;
+    uintptr_t frames[kMaxDepth];
+
+    for (;;) {
+        threads.clear();
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (const std::unique_ptr<WatchedThread>& thread : watched) {
+                threads.push_back(thread.get());
+            }
+        }
+
+        for (WatchedThread* thread : threads) {
+            const size_t count = CaptureStack(*thread, frames, depth);
+            thread->aggregator.Add(modules, frames, count);
+        }
+
+        if (Clock::now() - reportStart >= kReportPeriod) {
+            for (WatchedThread* thread : threads) {
+                SampleProfile::Report report = thread->aggregator.Build(modules, kHotAddresses);
+                thread->aggregator.Reset();
+                std::lock_guard<std::mutex> guard(lock);
+                thread->published = std::move(report);
+            }
+            RefreshModules();
+            reportStart = Clock::now();
+        }
+
+        Sleep(interval);
+    }
+}
+
+} // namespace
+
+namespace Sampler {
+
+void Start() {
+    if (started.exchange(true)) {
+        return;
+    }
+
+    // Runs until the process exits; it holds no locks the game could wait on
+    std::thread(Run).detach();
+    std::cout << "[+] Sampling profiler started, every " << LayerConfig::Get().sampler.intervalMs << " ms" << std::endl;
+}
+
+void WatchThread(DWORD threadId, const char* role) {
+    if (!LayerConfig::IsEnabled(FEATURE_SAMPLER)) {
+        return;
+    }
+
+    HANDLE handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, FALSE, threadId);
+    if (!handle) {
+        std::cerr << "[ERROR] Failed to open the " << role << " thread for sampling: " << GetLastError() << std::endl;
+        return;
+    }
+
+    auto thread = std::make_unique<WatchedThread>();
+    thread->role = role;
+    thread->threadId = threadId;
+    thread->handle = handle;
+    if (!ReadStackRange(handle, thread->stackLow, thread->stackHigh)) {
+        std::cerr << "[ERROR] Failed to find the stack of the " << role << " thread; only its instruction pointer is sampled" << std::endl;
+        thread->stackLow = thread->stackHigh = 0;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (const std::unique_ptr<WatchedThread>& other : watched) {
+        if (other->threadId == threadId) {
+            CloseHandle(handle);
+            return;
+        }
+    }
+    watched.push_back(std::move(thread));
+}
+
+void WatchCurrentThread(const char* role) {
+    thread_local bool registered = false;
+    if (registered || !LayerConfig::IsEnabled(FEATURE_SAMPLER)) {
+        return;
+    }
+    registered = true;
+    WatchThread(GetCurrentThreadId(), role);
+}
+
+void NameModule(HMODULE module, const std::string& name) {
+    std::lock_guard<std::mutex> guard(lock);
+    modNames[reinterpret_cast<uintptr_t>(module)] = name;
+}
+
+void ForgetModule(HMODULE module) {
+    std::lock_guard<std::mutex> guard(lock);
+    modNames.erase(reinterpret_cast<uintptr_t>(module));
+}
+
+void RenderOverlay() {
+    if (!LayerConfig::IsEnabled(FEATURE_SAMPLER)) {
+        return;
+    }
+
+    ImGui::SetNextWindowSize({ 420, 360 }, ImGuiCond_Once);
+    if (ImGui::Begin("Sampling Profiler")) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (watched.empty()) {
+            ImGui::TextUnformatted("Waiting for the present and window threads...");
+        }
+
+        for (const std::unique_ptr<WatchedThread>& thread : watched) {
+            const SampleProfile::Report& report = thread->published;
+            ImGui::PushID(thread.get());
+            if (!ImGui::CollapsingHeader(thread->role, ImGuiTreeNodeFlags_DefaultOpen)) {
+                ImGui::PopID();
+                continue;
+            }
+
+            ImGui::Text("Thread %lu | %llu samples", thread->threadId, static_cast<unsigned long long>(report.samples));
+            if (report.samples == 0) {
+                ImGui::PopID();
+                continue;
+            }
+
+            const double scale = 100.0 / report.samples;
+            constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+            if (ImGui::BeginTable("##modules", 3, flags)) {
+                ImGui::TableSetupColumn("Module", ImGuiTableColumnFlags_WidthStretch);
+                ImGui::TableSetupColumn("Self %");
+                ImGui::TableSetupColumn("On stack %");
+                ImGui::TableHeadersRow();
+
+                for (const SampleProfile::ModuleShare& share : report.modules) {
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(share.name.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", share.self * scale);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", share.inclusive * scale);
+                }
+                if (report.unknown) {
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted("(no module)");
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", report.unknown * scale);
+                    ImGui::TableNextColumn();
+                }
+                ImGui::EndTable();
+            }
+
+            if (ImGui::TreeNode("Hottest addresses")) {
+                for (const SampleProfile::HotAddress& address : report.hottest) {
+                    ImGui::Text("%5.1f%%  %s", address.samples * scale, address.symbol.c_str());
+                }
+                ImGui::TreePop();
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::End();
+}
+
+} // namespace Sampler
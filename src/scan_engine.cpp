@@ -0,0 +1,507 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SCAN_AVX2
+#else
+#include <cpuid.h>
+#define SCAN_AVX2 __attribute__((target("avx2")))
+#endif
+
+#include "include/scan_engine.h"
+#include "include/thread_pool.h"
+
+namespace {
+
+using namespace ScanEngine;
+
+constexpr size_t kChunkSize = 1u << 20;
+
+std::atomic<bool> forceScalar{false};
+
+/**
+ * @brief A piece of a region scanned by one task; a pattern may run past size up to available
+ */
+struct Chunk {
+    uintptr_t base;
+    size_t size;
+    size_t available;
+};
+
+size_t Step(ValueType type) {
+    return type == VALUE_BYTES ? 1 : 4;
+}
+
+bool DetectAVX2() {
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+        return false; // No AVX, or the OS does not save YMM registers
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0) {
+        return false;
+    }
+    unsigned int xcr0, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+    if ((xcr0 & 6) != 6 || !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (ebx & bit_AVX2) != 0;
+#endif
+}
+
+inline void SetBit(uint64_t* bits, size_t index) {
+    bits[index >> 6] |= uint64_t(1) << (index & 63);
+}
+
+// ---------------------------------------------------------------------------
+// Compare kernels: set bit i of bits for every matching slot i
+// ---------------------------------------------------------------------------
+
+void ScanInt32Scalar(const uint8_t* data, size_t begin, size_t slots, int32_t value, uint64_t* bits) {
+    for (size_t i = begin; i < slots; ++i) {
+        int32_t v;
+        memcpy(&v, data + i * 4, 4);
+        if (v == value) SetBit(bits, i);
+    }
+}
+
+SCAN_AVX2 inline uint64_t EqualMask(const uint8_t* data, __m256i needle) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle))));
+}
+
+SCAN_AVX2 void ScanInt32AVX2(const uint8_t* data, size_t slots, int32_t value, uint64_t* bits) {
+    const __m256i needle = _mm256_set1_epi32(value);
+
+    // 32 slots per iteration, so the masks land in one half of a bitmap word
+    size_t i = 0;
+    for (; i + 32 <= slots; i += 32) {
+        const uint8_t* p = data + i * 4;
+        const uint64_t mask = EqualMask(p, needle) | EqualMask(p + 32, needle) << 8
+            | EqualMask(p + 64, needle) << 16 | EqualMask(p + 96, needle) << 24;
+        if (mask) bits[i >> 6] |= mask << (i & 63);
+    }
+    ScanInt32Scalar(data, i, slots, value, bits);
+}
+
+void ScanFloatScalar(const uint8_t* data, size_t begin, size_t slots, float value, float tolerance, uint64_t* bits) {
+    for (size_t i = begin; i < slots; ++i) {
+        float v;
+        memcpy(&v, data + i * 4, 4);
+        if (std::fabs(v - value) <= tolerance) SetBit(bits, i);
+    }
+}
+
+SCAN_AVX2 inline uint64_t NearMask(const uint8_t* data, __m256 needle, __m256 limit) {
+    const __m256 magnitude = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 v = _mm256_loadu_ps(reinterpret_cast<const float*>(data));
+    const __m256 distance = _mm256_and_ps(_mm256_sub_ps(v, needle), magnitude);
+    // Ordered compare, so NaN never matches
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(distance, limit, _CMP_LE_OQ)));
+}
+
+SCAN_AVX2 void ScanFloatAVX2(const uint8_t* data, size_t slots, float value, float tolerance, uint64_t* bits) {
+    const __m256 needle = _mm256_set1_ps(value);
+    const __m256 limit = _mm256_set1_ps(tolerance);
+
+    size_t i = 0;
+    for (; i + 32 <= slots; i += 32) {
+        const uint8_t* p = data + i * 4;
+        const uint64_t mask = NearMask(p, needle, limit) | NearMask(p + 32, needle, limit) << 8
+            | NearMask(p + 64, needle, limit) << 16 | NearMask(p + 96, needle, limit) << 24;
+        if (mask) bits[i >> 6] |= mask << (i & 63);
+    }
+    ScanFloatScalar(data, i, slots, value, tolerance, bits);
+}
+
+void ScanBytesScalar(const uint8_t* data, size_t begin, size_t starts, const uint8_t* pattern, size_t length, uint64_t* bits) {
+    for (size_t i = begin; i < starts;) {
+        const void* found = memchr(data + i, pattern[0], starts - i);
+        if (!found) {
+            return;
+        }
+        i = static_cast<const uint8_t*>(found) - data;
+        if (memcmp(data + i + 1, pattern + 1, length - 1) == 0) SetBit(bits, i);
+        ++i;
+    }
+}
+
+/**
+ * @brief Filter on the first and last byte 32 positions at a time, then confirm candidates
+ */
+SCAN_AVX2 void ScanBytesAVX2(const uint8_t* data, size_t starts, const uint8_t* pattern, size_t length, uint64_t* bits) {
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(pattern[length - 1]));
+
+    size_t i = 0;
+    for (; i + 32 <= starts; i += 32) {
+        const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + length - 1));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        while (mask) {
+            const size_t at = i + std::countr_zero(mask);
+            if (length <= 2 || memcmp(data + at + 1, pattern + 1, length - 2) == 0) SetBit(bits, at);
+            mask &= mask - 1;
+        }
+    }
+    ScanBytesScalar(data, i, starts, pattern, length, bits);
+}
+
+// ---------------------------------------------------------------------------
+// Hit encoding
+// ---------------------------------------------------------------------------
+
+void AppendVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void StoreBitmap(ChunkHits& hits, const uint64_t* bits) {
+    hits.bitmap = true;
+    hits.encoded.resize((hits.slots + 7) / 8);
+    memcpy(hits.encoded.data(), bits, hits.encoded.size());
+}
+
+/**
+ * @brief Encode hits as slot deltas, or keep the bitmap once the deltas would not be smaller
+ */
+void EncodeBitmap(ChunkHits& hits, const uint64_t* bits) {
+    const size_t words = (hits.slots + 63) / 64;
+    const size_t bitmapBytes = (hits.slots + 7) / 8;
+    hits.encoded.clear();
+    hits.bitmap = false;
+
+    uint32_t previous = 0;
+    for (size_t w = 0; w < words; ++w) {
+        for (uint64_t word = bits[w]; word; word &= word - 1) {
+            const uint32_t slot = static_cast<uint32_t>(w * 64 + std::countr_zero(word));
+            AppendVarint(hits.encoded, slot - previous);
+            previous = slot;
+            if (hits.encoded.size() >= bitmapBytes) {
+                StoreBitmap(hits, bits);
+                return;
+            }
+        }
+    }
+    hits.encoded.shrink_to_fit();
+}
+
+void EncodeSlots(ChunkHits& hits, const std::vector<uint32_t>& slots) {
+    hits.count = static_cast<uint32_t>(slots.size());
+    hits.encoded.clear();
+    hits.bitmap = false;
+
+    uint32_t previous = 0;
+    for (uint32_t slot : slots) {
+        AppendVarint(hits.encoded, slot - previous);
+        previous = slot;
+    }
+    if (hits.encoded.size() >= (hits.slots + 7) / 8) {
+        std::vector<uint64_t> bits((hits.slots + 63) / 64);
+        for (uint32_t slot : slots) {
+            SetBit(bits.data(), slot);
+        }
+        StoreBitmap(hits, bits.data());
+    }
+    hits.encoded.shrink_to_fit();
+}
+
+void DecodeSlots(const ChunkHits& hits, std::vector<uint32_t>& slots) {
+    slots.clear();
+    slots.reserve(hits.count);
+    if (hits.bitmap) {
+        for (size_t byte = 0; byte < hits.encoded.size(); ++byte) {
+            for (uint32_t value = hits.encoded[byte]; value; value &= value - 1) {
+                slots.push_back(static_cast<uint32_t>(byte * 8 + std::countr_zero(value)));
+            }
+        }
+        return;
+    }
+
+    uint32_t slot = 0;
+    for (size_t i = 0; i < hits.encoded.size();) {
+        uint32_t delta = 0;
+        for (int shift = 0;; shift += 7) {
+            const uint8_t byte = hits.encoded[i++];
+            delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) break;
+        }
+        slot += delta;
+        slots.push_back(slot);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Guarded memory access; nothing in these bodies allocates
+// ---------------------------------------------------------------------------
+
+struct FirstScanJob {
+    const Query* query;
+    const uint8_t* data;
+    size_t slots;
+    uint64_t* bits;
+};
+
+void RunFirstScan(void* context) {
+    const FirstScanJob& job = *static_cast<const FirstScanJob*>(context);
+    const Query& query = *job.query;
+    const bool avx2 = HasAVX2();
+
+    if (query.type == VALUE_BYTES) {
+        if (avx2) ScanBytesAVX2(job.data, job.slots, query.value.data(), query.value.size(), job.bits);
+        else ScanBytesScalar(job.data, 0, job.slots, query.value.data(), query.value.size(), job.bits);
+    } else if (query.type == VALUE_FLOAT) {
+        float value;
+        memcpy(&value, query.value.data(), 4);
+        if (avx2) ScanFloatAVX2(job.data, job.slots, value, query.tolerance, job.bits);
+        else ScanFloatScalar(job.data, 0, job.slots, value, query.tolerance, job.bits);
+    } else {
+        int32_t value;
+        memcpy(&value, query.value.data(), 4);
+        if (avx2) ScanInt32AVX2(job.data, job.slots, value, job.bits);
+        else ScanInt32Scalar(job.data, 0, job.slots, value, job.bits);
+    }
+}
+
+struct ReadJob {
+    uintptr_t base;
+    size_t step;
+    size_t size;
+    const uint32_t* slots;
+    size_t count;
+    uint8_t* out;
+};
+
+void RunRead(void* context) {
+    const ReadJob& job = *static_cast<const ReadJob*>(context);
+    for (size_t i = 0; i < job.count; ++i) {
+        memcpy(job.out + i * job.size, reinterpret_cast<const void*>(job.base + job.slots[i] * job.step), job.size);
+    }
+}
+
+bool Run(Guard guard, void (*body)(void*), void* context) {
+    if (guard) {
+        return guard(body, context);
+    }
+    body(context);
+    return true;
+}
+
+bool Matches(const Query& query, Condition condition, const uint8_t* current, const uint8_t* previous, const uint8_t* target) {
+    const size_t size = ValueSize(query);
+    if (query.type == VALUE_BYTES) {
+        const bool same = memcmp(current, condition == CONDITION_EQUAL ? target : previous, size) == 0;
+        return condition == CONDITION_CHANGED ? !same : same;
+    }
+
+    if (query.type == VALUE_FLOAT) {
+        float now, before, wanted;
+        memcpy(&now, current, 4);
+        memcpy(&before, previous, 4);
+        memcpy(&wanted, target, 4);
+        const bool near = std::fabs(now - before) <= query.tolerance;
+        switch (condition) {
+        case CONDITION_EQUAL:     return std::fabs(now - wanted) <= query.tolerance;
+        case CONDITION_CHANGED:   return !near;
+        case CONDITION_UNCHANGED: return near;
+        case CONDITION_INCREASED: return now > before && !near;
+        case CONDITION_DECREASED: return now < before && !near;
+        }
+        return false;
+    }
+
+    int32_t now, before, wanted;
+    memcpy(&now, current, 4);
+    memcpy(&before, previous, 4);
+    memcpy(&wanted, target, 4);
+    switch (condition) {
+    case CONDITION_EQUAL:     return now == wanted;
+    case CONDITION_CHANGED:   return now != before;
+    case CONDITION_UNCHANGED: return now == before;
+    case CONDITION_INCREASED: return now > before;
+    case CONDITION_DECREASED: return now < before;
+    }
+    return false;
+}
+
+void Recount(ResultSet& results) {
+    results.chunks.erase(std::remove_if(results.chunks.begin(), results.chunks.end(),
+        [](const ChunkHits& hits) { return hits.count == 0; }), results.chunks.end());
+    results.count = 0;
+    for (const ChunkHits& hits : results.chunks) {
+        results.count += hits.count;
+    }
+}
+
+} // namespace
+
+namespace ScanEngine {
+
+size_t ValueSize(const Query& query) {
+    return query.type == VALUE_BYTES ? query.value.size() : 4;
+}
+
+bool HasAVX2() {
+    static const bool supported = DetectAVX2();
+    return supported && !forceScalar.load(std::memory_order_relaxed);
+}
+
+void ForceScalar(bool scalar) {
+    forceScalar.store(scalar, std::memory_order_relaxed);
+}
+
+std::unique_ptr<ResultSet> First(const std::vector<Region>& regions, const Query& query, Guard guard) {
+    if (query.value.empty() || (query.type != VALUE_BYTES && query.value.size() != 4)) {
+        return nullptr;
+    }
+
+    const size_t step = Step(query.type);
+    const size_t length = ValueSize(query);
+    std::vector<Chunk> chunks;
+    for (const Region& region : regions) {
+        for (size_t offset = 0; offset < region.size; offset += kChunkSize) {
+            chunks.push_back({ region.base + offset, std::min(kChunkSize, region.size - offset), region.size - offset });
+        }
+    }
+
+    auto results = std::make_unique<ResultSet>();
+    results->query = query;
+    std::vector<ChunkHits> hits(chunks.size());
+    std::atomic<uint32_t> faults{0};
+    ThreadPool::Shared().ParallelFor(chunks.size(), [&](size_t index) {
+        const Chunk& chunk = chunks[index];
+        ChunkHits& out = hits[index];
+        out.base = chunk.base;
+        out.count = 0;
+        out.slots = static_cast<uint32_t>(step == 1
+            ? (chunk.available >= length ? std::min(chunk.size, chunk.available - length + 1) : 0)
+            : chunk.size / step);
+        if (out.slots == 0) {
+            return;
+        }
+
+        thread_local std::vector<uint64_t> bits;
+        bits.assign((out.slots + 63) / 64, 0);
+        FirstScanJob job = { &query, reinterpret_cast<const uint8_t*>(chunk.base), out.slots, bits.data() };
+        if (!Run(guard, RunFirstScan, &job)) {
+            faults.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        uint64_t count = 0;
+        for (uint64_t word : bits) {
+            count += std::popcount(word);
+        }
+        out.count = static_cast<uint32_t>(count);
+        if (count) {
+            EncodeBitmap(out, bits.data());
+        }
+    });
+
+    for (const Chunk& chunk : chunks) {
+        results->bytesScanned += chunk.size;
+    }
+    results->chunks = std::move(hits);
+    results->faults = faults.load();
+    Recount(*results);
+    return results;
+}
+
+bool Next(ResultSet& results, Condition condition, const std::vector<uint8_t>& value, Guard guard) {
+    const Query& query = results.query;
+    const size_t size = ValueSize(query);
+    if (query.type == VALUE_BYTES && (condition == CONDITION_INCREASED || condition == CONDITION_DECREASED)) {
+        return false;
+    }
+    if (condition == CONDITION_EQUAL && value.size() != size) {
+        return false;
+    }
+
+    // Hits keep one shared value after an equality scan; otherwise every hit stores its own
+    const bool uniformBefore = std::all_of(results.chunks.begin(), results.chunks.end(),
+        [](const ChunkHits& hits) { return hits.values.empty(); });
+    const bool uniformAfter = condition == CONDITION_EQUAL
+        || (condition == CONDITION_UNCHANGED && uniformBefore && query.type != VALUE_FLOAT);
+    const uint8_t* target = condition == CONDITION_EQUAL ? value.data() : query.value.data();
+
+    const size_t step = Step(query.type);
+    std::atomic<uint32_t> faults{0};
+    ThreadPool::Shared().ParallelFor(results.chunks.size(), [&](size_t index) {
+        ChunkHits& hits = results.chunks[index];
+        std::vector<uint32_t> slots;
+        DecodeSlots(hits, slots);
+
+        std::vector<uint8_t> current(slots.size() * size);
+        ReadJob job = { hits.base, step, size, slots.data(), slots.size(), current.data() };
+        if (!Run(guard, RunRead, &job)) {
+            faults.fetch_add(1, std::memory_order_relaxed);
+            hits.count = 0;
+            return;
+        }
+
+        std::vector<uint32_t> kept;
+        std::vector<uint8_t> keptValues;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            const uint8_t* now = current.data() + i * size;
+            const uint8_t* before = hits.values.empty() ? query.value.data() : hits.values.data() + i * size;
+            if (!Matches(query, condition, now, before, target)) {
+                continue;
+            }
+            kept.push_back(slots[i]);
+            if (!uniformAfter) {
+                keptValues.insert(keptValues.end(), now, now + size);
+            }
+        }
+
+        EncodeSlots(hits, kept);
+        hits.values = std::move(keptValues);
+    });
+
+    if (condition == CONDITION_EQUAL) {
+        results.query.value = value;
+    }
+    results.faults += faults.load();
+    Recount(results);
+    return true;
+}
+
+void ForEach(const ResultSet& results, const std::function<bool(uintptr_t address, const uint8_t* value)>& visit) {
+    const size_t step = Step(results.query.type);
+    const size_t size = ValueSize(results.query);
+    std::vector<uint32_t> slots;
+    for (const ChunkHits& hits : results.chunks) {
+        DecodeSlots(hits, slots);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            const uint8_t* value = hits.values.empty() ? results.query.value.data() : hits.values.data() + i * size;
+            if (!visit(hits.base + slots[i] * step, value)) {
+                return;
+            }
+        }
+    }
+}
+
+size_t Footprint(const ResultSet& results) {
+    size_t bytes = results.chunks.capacity() * sizeof(ChunkHits);
+    for (const ChunkHits& hits : results.chunks) {
+        bytes += hits.encoded.capacity() + hits.values.capacity();
+    }
+    return bytes;
+}
+
+} // namespace ScanEngine
@@ -0,0 +1,145 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <windows.h>
+
+#include "include/draw_stats.h"
+#include "include/layer_config.h"
+#include "include/shared_metrics.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+HANDLE mapping = nullptr;
+SharedMetrics::Block* block = nullptr;
+
+// Render thread only
+Clock::time_point lastPresent;
+Clock::time_point windowStart;
+uint32_t windowFrames = 0;
+float windowFrameMs = 0.0f;
+float windowFrameMsMax = 0.0f;
+uint64_t windowLogLines = 0;
+float frameMsAverage = 0.0f;
+float frameMsMax = 0.0f;
+float logLinesPerSecond = 0.0f;
+uint64_t presents = 0;
+SharedMetrics::ModMetrics mods[SharedMetrics::kMaxMods] = {};
+uint32_t modCount = 0;
+
+std::atomic<uint64_t> windowMessages{0}; // Written by the window thread only
+std::atomic<uint64_t> logLines{0};
+
+} // namespace
+
+namespace SharedMetrics {
+
+void Init() {
+    mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(Block), kSegmentName);
+    if (!mapping) {
+        std::cerr << "[ERROR] Failed to create metrics segment: " << GetLastError() << std::endl;
+        return;
+    }
+
+    block = static_cast<Block*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Block)));
+    if (!block) {
+        std::cerr << "[ERROR] Failed to map metrics segment: " << GetLastError() << std::endl;
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return;
+    }
+
+    // A new segment is zeroed; one left by an earlier run of the loader is taken over
+    const uint64_t writing = BeginWrite(*block);
+    block->magic = kMagic;
+    block->version = kVersion;
+    block->size = sizeof(Block);
+    block->processId = GetCurrentProcessId();
+    EndWrite(*block, writing);
+
+    windowStart = Clock::now();
+    std::cout << "[+] Publishing metrics to " << kSegmentName << std::endl;
+}
+
+void EndFrame(float overlayMs) {
+    if (!block) {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    const float frameMs = lastPresent == Clock::time_point{} ? 0.0f
+        : std::chrono::duration<float, std::milli>(now - lastPresent).count();
+    lastPresent = now;
+    ++presents;
+
+    ++windowFrames;
+    windowFrameMs += frameMs;
+    windowFrameMsMax = frameMs > windowFrameMsMax ? frameMs : windowFrameMsMax;
+    const float windowSeconds = std::chrono::duration<float>(now - windowStart).count();
+    if (windowSeconds >= 1.0f) {
+        const uint64_t lines = logLines.load(std::memory_order_relaxed);
+        frameMsAverage = windowFrameMs / windowFrames;
+        frameMsMax = windowFrameMsMax;
+        logLinesPerSecond = (lines - windowLogLines) / windowSeconds;
+        windowLogLines = lines;
+        windowFrames = 0;
+        windowFrameMs = 0.0f;
+        windowFrameMsMax = 0.0f;
+        windowStart = now;
+    }
+
+    uint64_t draws = 0, dispatches = 0, submits = 0;
+    if (LayerConfig::IsEnabled(FEATURE_DRAWSTATS)) {
+        DrawStats::LastFrame(draws, dispatches, submits);
+    }
+
+    const uint64_t writing = BeginWrite(*block);
+
+    block->presents = presents;
+    block->timeUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        now.time_since_epoch()).count());
+    block->frameMs = frameMs;
+    block->frameMsAverage = frameMsAverage;
+    block->frameMsMax = frameMsMax;
+    block->overlayMs = overlayMs;
+    block->windowMessages = windowMessages.load(std::memory_order_relaxed);
+    block->logLines = logLines.load(std::memory_order_relaxed);
+    block->logLinesPerSecond = logLinesPerSecond;
+    block->draws = static_cast<uint32_t>(draws);
+    block->dispatches = static_cast<uint32_t>(dispatches);
+    block->submits = static_cast<uint32_t>(submits);
+    block->modCount = modCount;
+    memcpy(block->mods, mods, sizeof(ModMetrics) * modCount);
+
+    EndWrite(*block, writing);
+}
+
+void RecordModRender(int index, const char* name, float renderUs) {
+    if (!block || index < 0 || index >= static_cast<int>(kMaxMods)) {
+        return;
+    }
+
+    ModMetrics& mod = mods[index];
+    if (strncmp(mod.name, name, sizeof(mod.name) - 1) != 0) {
+        mod = {};
+        strncpy(mod.name, name, sizeof(mod.name) - 1);
+    }
+    mod.renderUsAverage = mod.renders == 0 ? renderUs : mod.renderUsAverage * 0.95f + renderUs * 0.05f;
+    mod.renderUs = renderUs;
+    ++mod.renders;
+    if (static_cast<uint32_t>(index) >= modCount) {
+        modCount = index + 1;
+    }
+}
+
+void CountWindowMessage() {
+    windowMessages.store(windowMessages.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void CountLogLine() {
+    logLines.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace SharedMetrics
@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "include/layer_config.h"
+#include "include/staging_ring.h"
+
+namespace {
+
+/**
+ * @brief One submit's worth of copies and the ring space they read from
+ */
+struct Batch {
+    VkCommandBuffer cmd = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+    uint64_t serial = 0;
+    VkDeviceSize start = 0; // head before the batch's first allocation
+    VkDeviceSize bytes = 0; // Ring space including alignment and wrap padding
+    bool recording = false;
+};
+
+VkPhysicalDeviceMemoryProperties memoryProperties = {};
+VkDeviceSize alignment = 4;
+
+VkDevice device = VK_NULL_HANDLE;
+VkBuffer buffer = VK_NULL_HANDLE;
+VkDeviceMemory memory = VK_NULL_HANDLE;
+uint8_t* mapped = nullptr;
+VkDeviceSize capacity = 0;
+VkCommandPool commandPool = VK_NULL_HANDLE;
+
+// Space is taken at head and given back in submission order
+VkDeviceSize head = 0;
+VkDeviceSize used = 0;
+
+Batch current;
+std::deque<Batch> inFlight;
+std::vector<Batch> idle; // Finished batches whose command buffer and fence are reused
+uint64_t submittedSerial = 0;
+uint64_t completedSerial = 0;
+/**
+ * @brief A batch that never reached the GPU, kept until its waiters have been told
+ */
+struct FailedBatch {
+    uint64_t serial;
+    bool reported;
+};
+
+std::vector<FailedBatch> failedBatches;
+
+uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags flags) {
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+        if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+bool CreateRing(uint32_t queueFamily) {
+    capacity = static_cast<VkDeviceSize>(LayerConfig::Get().overlay.stagingBufferMb) << 20;
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = capacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkResult result = vkCreateBuffer(device, &bufferInfo, nullptr, &buffer);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create staging ring: " << result << std::endl;
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device, buffer, &requirements);
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX) {
+        std::cerr << "[ERROR] No memory type for the staging ring" << std::endl;
+        return false;
+    }
+
+    result = vkAllocateMemory(device, &allocInfo, nullptr, &memory);
+    if (result == VK_SUCCESS) result = vkBindBufferMemory(device, buffer, memory, 0);
+    if (result == VK_SUCCESS) result = vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void**>(&mapped));
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to allocate staging ring memory: " << result << std::endl;
+        return false;
+    }
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+    result = vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create staging command pool: " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void DestroyBatch(const Batch& batch) {
+    if (batch.fence) vkDestroyFence(device, batch.fence, nullptr);
+    if (batch.cmd) vkFreeCommandBuffers(device, commandPool, 1, &batch.cmd);
+}
+
+void DestroyRing() {
+    for (const Batch& batch : inFlight) {
+        vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        DestroyBatch(batch);
+    }
+    for (const Batch& batch : idle) {
+        DestroyBatch(batch);
+    }
+    if (current.recording) vkEndCommandBuffer(current.cmd);
+    DestroyBatch(current);
+    inFlight.clear();
+    idle.clear();
+    current = {};
+
+    if (commandPool) vkDestroyCommandPool(device, commandPool, nullptr);
+    if (buffer) vkDestroyBuffer(device, buffer, nullptr);
+    if (memory) vkFreeMemory(device, memory, nullptr);
+    commandPool = VK_NULL_HANDLE;
+    buffer = VK_NULL_HANDLE;
+    memory = VK_NULL_HANDLE;
+    mapped = nullptr;
+    head = 0;
+    used = 0;
+    completedSerial = submittedSerial;
+}
+
+} // namespace
+
+namespace StagingRing {
+
+void OnCreateDevice(const VkPhysicalDeviceMemoryProperties& properties, VkDeviceSize copyAlignment) {
+    memoryProperties = properties;
+    // Both are powers of two; copies into color images also need offsets in whole texels
+    alignment = copyAlignment > 4 ? copyAlignment : 4;
+}
+
+void OnDestroyDevice(VkDevice oldDevice) {
+    if (device == VK_NULL_HANDLE || device != oldDevice) {
+        return;
+    }
+    DestroyRing();
+    device = VK_NULL_HANDLE;
+}
+
+bool BeginFrame(VkDevice newDevice, uint32_t queueFamily) {
+    if (device != newDevice) {
+        if (device != VK_NULL_HANDLE) {
+            return false;
+        }
+        device = newDevice;
+        if (!CreateRing(queueFamily)) {
+            DestroyRing();
+            device = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+
+    while (!inFlight.empty() && vkGetFenceStatus(device, inFlight.front().fence) == VK_SUCCESS) {
+        Batch& batch = inFlight.front();
+        used -= batch.bytes;
+        completedSerial = batch.serial;
+        idle.push_back(batch);
+        inFlight.pop_front();
+    }
+
+    // Waiters all poll between one BeginFrame and the next, so a reported failure has reached every one
+    failedBatches.erase(std::remove_if(failedBatches.begin(), failedBatches.end(),
+        [](const FailedBatch& failed) { return failed.reported; }), failedBatches.end());
+    return true;
+}
+
+void* Allocate(VkDeviceSize size, VkDeviceSize& offset) {
+    if (!mapped || size > capacity) {
+        return nullptr;
+    }
+
+    VkDeviceSize start = (head + alignment - 1) / alignment * alignment;
+    VkDeviceSize taken = start - head + size;
+    if (start + size > capacity) {
+        // Skip the tail end and wrap around
+        start = 0;
+        taken = capacity - head + size;
+    }
+    if (used + taken > capacity) {
+        return nullptr;
+    }
+
+    if (current.bytes == 0) {
+        current.start = head;
+    }
+    head = start + size;
+    used += taken;
+    current.bytes += taken;
+    offset = start;
+    return mapped + start;
+}
+
+VkBuffer Buffer() {
+    return buffer;
+}
+
+VkDeviceSize Capacity() {
+    return capacity;
+}
+
+VkCommandBuffer Commands() {
+    if (current.recording) {
+        return current.cmd;
+    }
+
+    if (current.cmd == VK_NULL_HANDLE) {
+        if (!idle.empty()) {
+            current.cmd = idle.back().cmd;
+            current.fence = idle.back().fence;
+            idle.pop_back();
+            vkResetFences(device, 1, &current.fence);
+        } else {
+            VkCommandBufferAllocateInfo allocInfo = {};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
+            VkFenceCreateInfo fenceInfo = {};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            if (vkAllocateCommandBuffers(device, &allocInfo, &current.cmd) != VK_SUCCESS ||
+                vkCreateFence(device, &fenceInfo, nullptr, &current.fence) != VK_SUCCESS) {
+                std::cerr << "[ERROR] Failed to create a staging batch" << std::endl;
+                return VK_NULL_HANDLE;
+            }
+        }
+    }
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(current.cmd, &beginInfo) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    current.recording = true;
+    return current.cmd;
+}
+
+uint64_t PendingSerial() {
+    return submittedSerial + 1;
+}
+
+VkResult Submit(VkQueue queue) {
+    if (!current.recording) {
+        // Space taken without copies recorded is free again right away; it is the newest in the ring
+        if (current.bytes > 0) {
+            head = current.start;
+            used -= current.bytes;
+            current.bytes = 0;
+        }
+        return VK_SUCCESS;
+    }
+
+    VkResult result = vkEndCommandBuffer(current.cmd);
+    if (result == VK_SUCCESS) {
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &current.cmd;
+        result = vkQueueSubmit(queue, 1, &submitInfo, current.fence);
+    }
+    if (result != VK_SUCCESS) {
+        // Nothing reached the GPU, so the space is free again and the uploads have failed
+        std::cerr << "[ERROR] Failed to submit staging batch: " << result << std::endl;
+        vkResetCommandBuffer(current.cmd, 0);
+        if (current.bytes > 0) {
+            head = current.start;
+            used -= current.bytes;
+        }
+        failedBatches.push_back({ ++submittedSerial, false });
+        idle.push_back({current.cmd, current.fence});
+        current = {};
+        return result;
+    }
+
+    current.serial = ++submittedSerial;
+    current.recording = false;
+    inFlight.push_back(current);
+    current = {};
+    return VK_SUCCESS;
+}
+
+bool IsComplete(uint64_t serial) {
+    return serial <= completedSerial;
+}
+
+bool IsFailed(uint64_t serial) {
+    for (FailedBatch& failed : failedBatches) {
+        if (failed.serial == serial) {
+            failed.reported = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace StagingRing
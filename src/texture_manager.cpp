@@ -0,0 +1,410 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+#include <imgui_impl_vulkan.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_WINDOWS_UTF8
+#include <stb_image.h>
+
+#include "include/layer_config.h"
+#include "include/overlay_cache.h"
+#include "include/staging_ring.h"
+#include "include/texture_manager.h"
+#include "include/thread_pool.h"
+
+enum TextureState {
+    TEXTURE_DECODING,  // stb_image is running on the thread pool
+    TEXTURE_DECODED,   // Pixels are waiting for room in the staging ring
+    TEXTURE_UPLOADING, // Copy is in a staging batch that has not finished
+    TEXTURE_READY,
+    TEXTURE_EVICTED,   // Memory given back for the budget, loaded again when drawn
+    TEXTURE_FAILED,
+};
+
+struct ModTexture {
+    std::string path;
+    uint32_t refs = 0;
+    TextureState state = TEXTURE_DECODING;
+    uint64_t lastUse = 0;   // UI frame a mod last asked for the texture in
+    uint64_t lastDrawn = 0; // Last present whose draw data may contain it
+
+    stbi_uc* pixels = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0; // Device memory held by image
+    VkImageView view = VK_NULL_HANDLE;
+    VkDescriptorSet set = VK_NULL_HANDLE;
+    uint64_t uploadSerial = 0; // Staging batch holding the copy
+};
+
+namespace {
+
+// Presents after which a texture no longer drawn is out of every overlay command buffer
+constexpr uint64_t kFramesInFlight = 8;
+
+std::mutex lock;
+std::unordered_map<std::string, std::unique_ptr<ModTexture>> textures;
+VkDeviceSize residentBytes = 0;
+uint64_t uiFrame = 0; // Counts UI rebuilds; between them the last draw data is presented again
+uint64_t present = 0;
+
+VkPhysicalDeviceMemoryProperties memoryProperties = {};
+VkDevice device = VK_NULL_HANDLE;
+VkSampler sampler = VK_NULL_HANDLE;
+
+uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) {
+    for (VkMemoryPropertyFlags flags : {required | preferred, required}) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+            if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+                return i;
+            }
+        }
+    }
+    return UINT32_MAX;
+}
+
+/**
+ * @brief Decode a texture's file on the thread pool; the caller holds the lock
+ */
+void Decode(ModTexture* texture) {
+    texture->state = TEXTURE_DECODING;
+    ThreadPool::Shared().Submit([texture] {
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* pixels = stbi_load(texture->path.c_str(), &width, &height, &channels, 4);
+
+        std::lock_guard<std::mutex> guard(lock);
+        if (!pixels) {
+            std::cerr << "[ERROR] Failed to load texture " << texture->path << ": " << stbi_failure_reason() << std::endl;
+            texture->state = TEXTURE_FAILED;
+            return;
+        }
+        texture->pixels = pixels;
+        texture->width = static_cast<uint32_t>(width);
+        texture->height = static_cast<uint32_t>(height);
+        texture->state = TEXTURE_DECODED;
+    });
+}
+
+/**
+ * @brief Free everything the texture holds on the device
+ * @param freeSet Whether the descriptor set goes back to the ImGui backend's pool
+ */
+void DestroyImage(ModTexture& texture, bool freeSet) {
+    if (texture.set && freeSet) ImGui_ImplVulkan_RemoveTexture(texture.set);
+    if (texture.view) vkDestroyImageView(device, texture.view, nullptr);
+    if (texture.image) vkDestroyImage(device, texture.image, nullptr);
+    if (texture.memory) vkFreeMemory(device, texture.memory, nullptr);
+    texture.set = VK_NULL_HANDLE;
+    texture.view = VK_NULL_HANDLE;
+    texture.image = VK_NULL_HANDLE;
+    texture.memory = VK_NULL_HANDLE;
+    residentBytes -= texture.size;
+    texture.size = 0;
+}
+
+bool CreateImage(ModTexture& texture) {
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    imageInfo.extent = {texture.width, texture.height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkResult result = vkCreateImage(device, &imageInfo, nullptr, &texture.image);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to create texture image: " << result << std::endl;
+        return false;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device, texture.image, &requirements);
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (allocInfo.memoryTypeIndex == UINT32_MAX) {
+        std::cerr << "[ERROR] No memory type for texture " << texture.path << std::endl;
+        return false;
+    }
+
+    result = vkAllocateMemory(device, &allocInfo, nullptr, &texture.memory);
+    if (result == VK_SUCCESS) result = vkBindImageMemory(device, texture.image, texture.memory, 0);
+    if (result != VK_SUCCESS) {
+        std::cerr << "[ERROR] Failed to allocate texture memory: " << result << std::endl;
+        return false;
+    }
+    texture.size = requirements.size;
+    residentBytes += texture.size;
+    return true;
+}
+
+void RecordUpload(const ModTexture& texture, VkCommandBuffer cmd, VkDeviceSize offset) {
+    VkImageMemoryBarrier toTransfer = {};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = texture.image;
+    toTransfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &toTransfer);
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset = offset;
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {texture.width, texture.height, 1};
+    vkCmdCopyBufferToImage(cmd, StagingRing::Buffer(), texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    VkImageMemoryBarrier toShader = toTransfer;
+    toShader.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toShader.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    toShader.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    toShader.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &toShader);
+}
+
+/**
+ * @brief Stage a decoded image and record its copy into this frame's staging batch
+ *
+ * Leaves the texture decoded when the ring has no room this frame.
+ */
+void BeginUpload(ModTexture& texture) {
+    const VkDeviceSize size = static_cast<VkDeviceSize>(texture.width) * texture.height * 4;
+    if (size > StagingRing::Capacity()) {
+        std::cerr << "[ERROR] Texture " << texture.path << " is larger than the staging ring" << std::endl;
+        stbi_image_free(texture.pixels);
+        texture.pixels = nullptr;
+        texture.state = TEXTURE_FAILED;
+        return;
+    }
+
+    VkDeviceSize offset = 0;
+    void* staging = StagingRing::Allocate(size, offset);
+    if (!staging) {
+        return;
+    }
+    memcpy(staging, texture.pixels, static_cast<size_t>(size));
+    stbi_image_free(texture.pixels);
+    texture.pixels = nullptr;
+
+    VkCommandBuffer cmd = StagingRing::Commands();
+    if (cmd == VK_NULL_HANDLE || !CreateImage(texture)) {
+        DestroyImage(texture, true);
+        texture.state = TEXTURE_FAILED;
+        return;
+    }
+
+    RecordUpload(texture, cmd, offset);
+    texture.uploadSerial = StagingRing::PendingSerial();
+    texture.state = TEXTURE_UPLOADING;
+}
+
+bool FinishUpload(ModTexture& texture) {
+    VkImageViewCreateInfo viewInfo = {};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = texture.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    if (vkCreateImageView(device, &viewInfo, nullptr, &texture.view) != VK_SUCCESS) {
+        texture.view = VK_NULL_HANDLE;
+        return false;
+    }
+
+    texture.set = ImGui_ImplVulkan_AddTexture(sampler, texture.view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    return texture.set != VK_NULL_HANDLE;
+}
+
+bool CreateSampler() {
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod = 1000.0f;
+    if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+        sampler = VK_NULL_HANDLE;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Give back the memory of the least recently drawn textures until the budget holds
+ */
+void EnforceBudget() {
+    const VkDeviceSize budget = static_cast<VkDeviceSize>(LayerConfig::Get().overlay.textureBudgetMb) << 20;
+    if (residentBytes <= budget) {
+        return;
+    }
+
+    std::vector<ModTexture*> candidates;
+    for (auto& entry : textures) {
+        ModTexture* texture = entry.second.get();
+        if (texture->state == TEXTURE_READY && texture->lastDrawn + kFramesInFlight <= present) {
+            candidates.push_back(texture);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const ModTexture* a, const ModTexture* b) { return a->lastDrawn < b->lastDrawn; });
+
+    for (ModTexture* texture : candidates) {
+        if (residentBytes <= budget) {
+            break;
+        }
+        DestroyImage(*texture, true);
+        texture->state = TEXTURE_EVICTED;
+    }
+}
+
+} // namespace
+
+namespace TextureManager {
+
+void OnCreateDevice(const VkPhysicalDeviceMemoryProperties& properties) {
+    memoryProperties = properties;
+}
+
+void OnDestroyDevice(VkDevice oldDevice) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (device == VK_NULL_HANDLE || device != oldDevice) {
+        return;
+    }
+
+    // Pending copies were waited for with the staging ring. The descriptor pool goes
+    // away with the device, so sets are not freed one by one.
+    for (auto& entry : textures) {
+        ModTexture& texture = *entry.second;
+        DestroyImage(texture, false);
+        if (texture.state == TEXTURE_UPLOADING || texture.state == TEXTURE_READY) {
+            texture.state = TEXTURE_EVICTED;
+        }
+    }
+
+    if (sampler) vkDestroySampler(device, sampler, nullptr);
+    sampler = VK_NULL_HANDLE;
+    device = VK_NULL_HANDLE;
+}
+
+ModTexture* Load(const std::string& path) {
+    std::lock_guard<std::mutex> guard(lock);
+    std::unique_ptr<ModTexture>& slot = textures[path];
+    if (!slot) {
+        slot = std::make_unique<ModTexture>();
+        slot->path = path;
+        slot->lastUse = uiFrame;
+        slot->lastDrawn = present;
+        Decode(slot.get());
+    }
+    ++slot->refs;
+    return slot.get();
+}
+
+void Release(ModTexture* texture) {
+    if (!texture) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (texture->refs > 0) {
+        --texture->refs;
+    }
+}
+
+void* GetId(ModTexture* texture, uint32_t* width, uint32_t* height) {
+    if (!texture) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    texture->lastUse = uiFrame;
+    texture->lastDrawn = present;
+    if (texture->state == TEXTURE_EVICTED) {
+        Decode(texture);
+    }
+    if (width) *width = texture->width;
+    if (height) *height = texture->height;
+    return texture->state == TEXTURE_READY ? reinterpret_cast<void*>(texture->set) : nullptr;
+}
+
+void Update(VkDevice newDevice) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (device != newDevice) {
+        if (device != VK_NULL_HANDLE) {
+            return;
+        }
+        device = newDevice;
+        if (!CreateSampler()) {
+            std::cerr << "[ERROR] Failed to create texture sampler" << std::endl;
+            device = VK_NULL_HANDLE;
+            return;
+        }
+    }
+    ++present;
+
+    for (auto it = textures.begin(); it != textures.end();) {
+        ModTexture& texture = *it->second;
+        if (texture.lastUse == uiFrame) {
+            texture.lastDrawn = present;
+        }
+
+        if (texture.state == TEXTURE_DECODED) {
+            BeginUpload(texture);
+        } else if (texture.state == TEXTURE_UPLOADING && StagingRing::IsFailed(texture.uploadSerial)) {
+            DestroyImage(texture, true);
+            texture.state = TEXTURE_FAILED;
+        } else if (texture.state == TEXTURE_UPLOADING && StagingRing::IsComplete(texture.uploadSerial)) {
+            if (FinishUpload(texture)) {
+                texture.state = TEXTURE_READY;
+                // The set may reuse the handle of one the cached overlay drew
+                OverlayCache::Invalidate();
+            } else {
+                std::cerr << "[ERROR] Failed to publish texture " << texture.path << std::endl;
+                DestroyImage(texture, true);
+                texture.state = TEXTURE_FAILED;
+            }
+        }
+
+        // Unreferenced textures go once no command buffer can still draw them; a decode
+        // or upload in flight finishes first
+        const bool settled = texture.state != TEXTURE_DECODING && texture.state != TEXTURE_UPLOADING;
+        if (texture.refs == 0 && settled && texture.lastDrawn + kFramesInFlight <= present) {
+            DestroyImage(texture, true);
+            stbi_image_free(texture.pixels);
+            it = textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    EnforceBudget();
+}
+
+void BeginUiFrame() {
+    std::lock_guard<std::mutex> guard(lock);
+    ++uiFrame;
+}
+
+} // namespace TextureManager
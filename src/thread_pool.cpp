@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "include/thread_pool.h"
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        const size_t cores = std::thread::hardware_concurrency();
+        threads = cores > 1 ? cores - 1 : 1;
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    // Helpers may still be queued after the caller has finished every index,
+    // so the shared state outlives this call and holds no reference to body
+    struct Batch {
+        std::function<void(size_t)> body;
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->body = body;
+    batch->count = count;
+
+    auto drain = [](Batch& b) {
+        size_t completed = 0;
+        for (size_t i; (i = b.next.fetch_add(1, std::memory_order_relaxed)) < b.count; ++completed) {
+            b.body(i);
+        }
+        if (completed && b.done.fetch_add(completed, std::memory_order_acq_rel) + completed == b.count) {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            b.finished.notify_all();
+        }
+    };
+
+    const size_t helpers = std::min(count - 1, workers_.size());
+    for (size_t i = 0; i < helpers; ++i) {
+        Submit([batch, drain] { drain(*batch); });
+    }
+    drain(*batch);
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait(lock, [&] { return batch->done.load(std::memory_order_acquire) == count; });
+}
+
+ThreadPool& ThreadPool::Shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
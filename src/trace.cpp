@@ -0,0 +1,206 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <windows.h>
+
+#include "include/layer_config.h"
+#include "include/thread_pool.h"
+#include "include/trace.h"
+
+namespace {
+
+constexpr size_t kEventsPerThread = 16384;
+
+struct Event {
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+    char detail[40];
+};
+
+/**
+ * @brief Events of one thread; only that thread writes, count publishes them to the writer
+ */
+struct ThreadBuffer {
+    DWORD threadId = 0;
+    std::atomic<uint64_t> session{0};
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> dropped{0};
+    std::unique_ptr<Event[]> events;
+};
+
+std::mutex registryLock;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+std::atomic<uint64_t> currentSession{0};
+uint64_t sessionStart = 0;
+std::atomic<bool> writing{false};
+
+ThreadBuffer& Local() {
+    thread_local ThreadBuffer* buffer = [] {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->threadId = GetCurrentThreadId();
+        created->events = std::make_unique<Event[]>(kEventsPerThread);
+        std::lock_guard<std::mutex> guard(registryLock);
+        buffers.push_back(std::move(created));
+        return buffers.back().get();
+    }();
+    return *buffer;
+}
+
+void WriteEscaped(std::ofstream& file, const char* text) {
+    for (; *text; ++text) {
+        const unsigned char c = static_cast<unsigned char>(*text);
+        if (c == '"' || c == '\\') {
+            file << '\\' << static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            file << escaped;
+        } else {
+            file << static_cast<char>(c);
+        }
+    }
+}
+
+/**
+ * @brief Write the events of a finished session as a Chrome trace_event file
+ */
+void Write(uint64_t recorded, uint64_t start) {
+    const std::string& path = LayerConfig::Get().trace.output;
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Failed to open " << path << std::endl;
+        writing = false;
+        return;
+    }
+
+    const DWORD processId = GetCurrentProcessId();
+    size_t written = 0;
+    size_t dropped = 0;
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    {
+        std::lock_guard<std::mutex> guard(registryLock);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+            if (buffer->session.load(std::memory_order_relaxed) != recorded) {
+                continue;
+            }
+
+            const size_t count = buffer->count.load(std::memory_order_acquire);
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                const Event& event = buffer->events[i];
+                if (event.start < start) {
+                    continue; // Scope opened before the session started
+                }
+                file << (written++ ? ",\n" : "") << "{\"name\":\"";
+                WriteEscaped(file, event.name);
+                file << "\",\"ph\":\"X\",\"pid\":" << processId << ",\"tid\":" << buffer->threadId
+                     << ",\"ts\":" << (event.start - start) / 1000.0 << ",\"dur\":" << event.duration / 1000.0;
+                if (event.detail[0]) {
+                    file << ",\"args\":{\"detail\":\"";
+                    WriteEscaped(file, event.detail);
+                    file << "\"}";
+                }
+                file << '}';
+            }
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+
+    std::cout << "[+] Wrote " << written << " trace events to " << path;
+    if (dropped) {
+        std::cout << " (" << dropped << " dropped, thread buffers were full)";
+    }
+    std::cout << std::endl;
+    writing = false;
+}
+
+} // namespace
+
+namespace Trace {
+
+std::atomic<bool> enabled{false};
+
+uint64_t Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Complete(const char* name, uint64_t start, const char* detail) {
+    const uint64_t end = Now();
+    ThreadBuffer& buffer = Local();
+
+    // The first event of a new session starts the thread's buffer over
+    const uint64_t current = currentSession.load(std::memory_order_acquire);
+    if (buffer.session.load(std::memory_order_relaxed) != current) {
+        buffer.count.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+        buffer.session.store(current, std::memory_order_release);
+    }
+
+    const size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= kEventsPerThread) {
+        buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& event = buffer.events[index];
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    event.detail[0] = '\0';
+    if (detail) {
+        strncpy(event.detail, detail, sizeof(event.detail) - 1);
+        event.detail[sizeof(event.detail) - 1] = '\0';
+    }
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void Start() {
+    // Thread buffers are reused, so wait for the last session to be written out
+    if (IsEnabled() || writing) {
+        return;
+    }
+    sessionStart = Now();
+    currentSession.fetch_add(1, std::memory_order_release);
+    enabled = true;
+    std::cout << "[+] Tracing started" << std::endl;
+}
+
+void Stop() {
+    if (!IsEnabled()) {
+        return;
+    }
+    enabled = false;
+    writing = true;
+    const uint64_t recorded = currentSession.load(std::memory_order_relaxed);
+    const uint64_t start = sessionStart;
+    ThreadPool::Shared().Submit([recorded, start] { Write(recorded, start); });
+}
+
+void Toggle() {
+    if (IsEnabled()) {
+        Stop();
+    } else {
+        Start();
+    }
+}
+
+void Shutdown() {
+    if (!IsEnabled()) {
+        return;
+    }
+    enabled = false;
+    writing = true;
+    Write(currentSession.load(std::memory_order_relaxed), sessionStart);
+}
+
+} // namespace Trace
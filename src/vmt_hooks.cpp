@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#ifdef _MSC_VER
+#include <windows.h>
+#endif
+#include <libmem.h>
+
+#include "include/api.h"
+#include "include/vmt_hooks.h"
+#include "include/vtable_index.h"
+
+namespace {
+struct Table;
+} // namespace
+
+struct ModVmtHook {
+    void* function;
+    int priority;
+    void* owner;
+    Table* table; // nullptr once removed
+    size_t slot;
+    std::atomic<void*> next{ nullptr }; // Read by the hook on every call, so not behind the lock
+    std::chrono::steady_clock::time_point removed;
+};
+
+namespace {
+
+/**
+ * @brief A patched vtable: a class's own, or the shadow one object was pointed at
+ */
+struct Table {
+    uintptr_t* object = nullptr; // Whose vtable pointer was swapped, nullptr for a class
+    uintptr_t source = 0;        // The class vtable an object's chains continue into
+    size_t slots = 0;
+    std::unique_ptr<lm_address_t[]> shadow; // Locator slot, then the copied functions
+    lm_vmt_t vmt{};
+    std::map<size_t, std::vector<ModVmtHook*>> chains; // First to run first
+    std::vector<bool> patched; // Slots hooked through LM_VmtHook
+    bool dirty = false;
+    std::chrono::steady_clock::time_point retired;
+};
+
+// How long a removed hook or shadow vtable is kept for threads that were already in it
+constexpr std::chrono::seconds kGracePeriod{ 10 };
+
+std::mutex lock;
+std::unordered_map<uintptr_t, std::unique_ptr<Table>> classTables;
+std::unordered_map<uintptr_t*, std::unique_ptr<Table>> objectTables;
+// Removed entries outlive the grace period: another thread may still be in a removed hook, or have loaded a released shadow
+std::vector<std::unique_ptr<ModVmtHook>> hooks;
+std::vector<std::unique_ptr<Table>> retired;
+int batchDepth = 0;
+size_t batchAdded = 0;
+
+void Store(lm_address_t& entry, void* function) {
+    std::atomic_ref<lm_address_t>(entry).store(reinterpret_cast<lm_address_t>(function));
+}
+
+/**
+ * @brief What the last hook of a slot continues into
+ */
+void* Base(Table& table, size_t slot) {
+    if (table.object) {
+        // Class tables are relinked first, so this is the head of the class's chain
+        lm_address_t* source = reinterpret_cast<lm_address_t*>(table.source);
+        return reinterpret_cast<void*>(std::atomic_ref<lm_address_t>(source[slot]).load());
+    }
+    return reinterpret_cast<void*>(table.patched[slot] ? LM_VmtGetOriginal(&table.vmt, slot) : table.vmt.vtable[slot]);
+}
+
+/**
+ * @brief Point every hook at the next one and the slot at the first
+ */
+void Relink(Table& table) {
+    for (size_t slot = 0; slot < table.slots; ++slot) {
+        auto chain = table.chains.find(slot);
+        const bool hooked = chain != table.chains.end() && !chain->second.empty();
+        if (!hooked) {
+            if (chain != table.chains.end()) {
+                table.chains.erase(chain);
+            }
+            if (table.patched[slot]) {
+                LM_VmtUnhook(&table.vmt, slot);
+                table.patched[slot] = false;
+            }
+            if (table.object) {
+                // Follow the class's chain, which may have changed since the shadow was copied
+                Store(table.vmt.vtable[slot], Base(table, slot));
+            }
+            continue;
+        }
+
+        void* base = Base(table, slot);
+
+        // Link back to front so the slot only ever leads to a complete chain
+        const std::vector<ModVmtHook*>& list = chain->second;
+        for (size_t i = list.size(); i-- > 0;) {
+            list[i]->next.store(i + 1 < list.size() ? list[i + 1]->function : base, std::memory_order_release);
+        }
+        if (!table.patched[slot]) {
+            LM_VmtHook(&table.vmt, slot, reinterpret_cast<lm_address_t>(list[0]->function));
+            table.patched[slot] = true;
+        } else {
+            Store(table.vmt.vtable[slot], list[0]->function);
+        }
+    }
+}
+
+/**
+ * @brief Drop a table whose hooks are all gone, or whose object was rebuilt under it
+ */
+void Retire(std::unique_ptr<Table> table) {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& [slot, chain] : table->chains) {
+        for (ModVmtHook* hook : chain) {
+            hook->table = nullptr;
+            hook->removed = now;
+        }
+    }
+    LM_VmtFree(&table->vmt);
+    table->retired = now;
+    retired.push_back(std::move(table));
+}
+
+/**
+ * @brief Free the hooks and shadows removed longer than the grace period ago
+ */
+void Collect() {
+    const auto expired = std::chrono::steady_clock::now() - kGracePeriod;
+    hooks.erase(std::remove_if(hooks.begin(), hooks.end(),
+        [expired](const std::unique_ptr<ModVmtHook>& hook) { return !hook->table && hook->removed < expired; }), hooks.end());
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [expired](const std::unique_ptr<Table>& table) { return table->retired < expired; }), retired.end());
+}
+
+void* OwnerOf(void* function) {
+#ifdef _MSC_VER
+    HMODULE owner = nullptr;
+    GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCSTR>(function), &owner);
+    return owner;
+#else
+    // Only the dispatch benchmark builds this elsewhere, and it never unloads a module
+    (void)function;
+    return nullptr;
+#endif
+}
+
+/**
+ * @brief Relink what changed since the last call, unless a batch is open
+ */
+void Apply() {
+    if (batchDepth > 0) {
+        return;
+    }
+
+    std::vector<uintptr_t> changed;
+    for (auto it = classTables.begin(); it != classTables.end();) {
+        Table& table = *it->second;
+        if (table.dirty) {
+            Relink(table);
+            table.dirty = false;
+            changed.push_back(it->first);
+        }
+        if (table.chains.empty()) {
+            // Every slot is restored; the table stays writable for the next hook
+            LM_VmtFree(&table.vmt);
+            it = classTables.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = objectTables.begin(); it != objectTables.end();) {
+        Table& table = *it->second;
+        if (table.dirty || std::find(changed.begin(), changed.end(), table.source) != changed.end()) {
+            Relink(table);
+            table.dirty = false;
+        }
+        if (table.chains.empty()) {
+            std::atomic_ref<uintptr_t> vtable(*table.object);
+            uintptr_t shadow = reinterpret_cast<uintptr_t>(&table.shadow[1]);
+            vtable.compare_exchange_strong(shadow, table.source);
+            Retire(std::move(it->second));
+            it = objectTables.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    Collect();
+}
+
+void Detach(ModVmtHook* hook) {
+    std::vector<ModVmtHook*>& chain = hook->table->chains[hook->slot];
+    chain.erase(std::find(chain.begin(), chain.end(), hook));
+    hook->table->dirty = true;
+    hook->table = nullptr;
+    hook->removed = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Add a hook to a table's chain; a table made for a hook that fails is dropped by Apply
+ */
+ModVmtHook* Add(Table& table, size_t slot, void* function, int priority) {
+    if (slot >= table.slots) {
+        std::cerr << "[ERROR] Vtable slot " << slot << " is out of range, the vtable has " << table.slots << std::endl;
+        Apply();
+        return nullptr;
+    }
+
+    std::vector<ModVmtHook*>& chain = table.chains[slot];
+    for (ModVmtHook* other : chain) {
+        if (other->function == function) {
+            std::cerr << "[ERROR] The function is already hooked on vtable slot " << slot << std::endl;
+            Apply();
+            return nullptr;
+        }
+    }
+
+    auto hook = std::make_unique<ModVmtHook>();
+    hook->function = function;
+    hook->priority = priority;
+    hook->owner = OwnerOf(function);
+    hook->table = &table;
+    hook->slot = slot;
+
+    // After every hook of the same or higher priority
+    auto position = std::find_if(chain.begin(), chain.end(), [priority](const ModVmtHook* other) { return other->priority < priority; });
+    chain.insert(position, hook.get());
+    table.dirty = true;
+    ModVmtHook* added = hook.get();
+    hooks.push_back(std::move(hook));
+    ++batchAdded;
+
+    Apply();
+    return added;
+}
+
+} // namespace
+
+namespace VmtHooks {
+
+ModVmtHook* HookClass(uintptr_t vtable, size_t slot, void* hook, int priority) {
+    if (!hook) {
+        return nullptr;
+    }
+
+    // Before the lock: the index may still have to be built, which takes a while
+    const size_t slots = VTableIndex::Slots(vtable);
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = classTables.find(vtable);
+    if (it == classTables.end()) {
+        if (slots == 0) {
+            std::cerr << "[ERROR] 0x" << std::hex << vtable << std::dec << " is not a vtable of Sky.exe" << std::endl;
+            return nullptr;
+        }
+
+        // .rdata is read-only; chains are relinked with plain stores into the table
+        lm_prot_t oldProt;
+        if (!LM_ProtMemory(vtable, slots * sizeof(lm_address_t), LM_PROT_RW, &oldProt)) {
+            std::cerr << "[ERROR] Failed to make the vtable at 0x" << std::hex << vtable << std::dec << " writable" << std::endl;
+            return nullptr;
+        }
+
+        auto table = std::make_unique<Table>();
+        table->slots = slots;
+        table->patched.assign(slots, false);
+        LM_VmtNew(reinterpret_cast<lm_address_t*>(vtable), &table->vmt);
+        it = classTables.emplace(vtable, std::move(table)).first;
+    }
+    return Add(*it->second, slot, hook, priority);
+}
+
+ModVmtHook* HookObject(void* object, size_t slot, void* hook, int priority) {
+    if (!object || !hook) {
+        return nullptr;
+    }
+
+    uintptr_t* key = static_cast<uintptr_t*>(object);
+    const uintptr_t vtable = std::atomic_ref<uintptr_t>(*key).load();
+    const size_t slots = VTableIndex::Slots(vtable); // 0 for a shadow we already installed
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = objectTables.find(key);
+    const uintptr_t current = std::atomic_ref<uintptr_t>(*key).load();
+    if (it != objectTables.end() && current != reinterpret_cast<uintptr_t>(&it->second->shadow[1])) {
+        // The object was destroyed and its memory reused; its hooks went with it
+        Retire(std::move(it->second));
+        objectTables.erase(it);
+        it = objectTables.end();
+    }
+
+    if (it == objectTables.end()) {
+        if (current != vtable) {
+            std::cerr << "[ERROR] The object at 0x" << std::hex << key << std::dec << " changed class while being hooked" << std::endl;
+            return nullptr;
+        }
+        if (slots == 0) {
+            std::cerr << "[ERROR] The object at 0x" << std::hex << key << std::dec << " does not have a vtable of Sky.exe" << std::endl;
+            return nullptr;
+        }
+
+        // Keep the locator in front so RTTI and dynamic_cast still work on the object
+        auto table = std::make_unique<Table>();
+        table->object = key;
+        table->source = vtable;
+        table->slots = slots;
+        table->patched.assign(slots, false);
+        table->shadow = std::make_unique<lm_address_t[]>(slots + 1);
+        memcpy(table->shadow.get(), reinterpret_cast<const lm_address_t*>(vtable) - 1, (slots + 1) * sizeof(lm_address_t));
+        LM_VmtNew(&table->shadow[1], &table->vmt);
+        std::atomic_ref<uintptr_t>(*key).store(reinterpret_cast<uintptr_t>(&table->shadow[1]));
+        it = objectTables.emplace(key, std::move(table)).first;
+    }
+    return Add(*it->second, slot, hook, priority);
+}
+
+void* GetNext(const ModVmtHook* hook) {
+    return hook ? hook->next.load(std::memory_order_acquire) : nullptr;
+}
+
+void Unhook(ModVmtHook* hook) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!hook || !hook->table) {
+        return;
+    }
+    Detach(hook);
+    Apply();
+}
+
+void RemoveModule(void* module) {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t removed = 0;
+    for (const auto& hook : hooks) {
+        if (hook->owner == module && hook->table) {
+            Detach(hook.get());
+            ++removed;
+        }
+    }
+    if (removed > 0) {
+        Apply();
+        std::cout << "[+] Removed " << removed << " vtable hooks" << std::endl;
+    }
+}
+
+void BeginBatch() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (batchDepth++ == 0) {
+        batchAdded = 0;
+    }
+}
+
+void EndBatch() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (batchDepth == 0 || --batchDepth > 0) {
+        return;
+    }
+    Apply();
+    if (batchAdded > 0) {
+        std::cout << "[+] Installed " << batchAdded << " vtable hooks on "
+                  << classTables.size() + objectTables.size() << " tables" << std::endl;
+    }
+}
+
+} // namespace VmtHooks
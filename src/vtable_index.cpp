@@ -0,0 +1,204 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "include/api.h"
+#include "include/json.hpp"
+#include "include/rtti_scan.h"
+#include "include/thread_pool.h"
+#include "include/vtable_index.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr const char* cacheFile = "tsml_rtti_cache.json";
+
+std::mutex indexLock;
+std::condition_variable indexReady;
+bool ready = false;
+bool started = false;
+bool building = false; // Claimed by whichever of the pool task and the first lookup gets there first
+uintptr_t imageBase = 0;
+std::vector<RttiScan::ClassInfo> classes;
+std::unordered_multimap<std::string, size_t> byName; // Both the readable and the decorated name
+
+std::string HashString(uint64_t hash) {
+    char text[17];
+    snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+bool LoadCache(const std::string& hash, std::vector<RttiScan::ClassInfo>& loaded) {
+    std::ifstream file(cacheFile);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    try {
+        json cache = json::parse(file);
+        if (cache.value("imageHash", std::string()) != hash) {
+            return false;
+        }
+        for (const json& entry : cache.at("classes")) {
+            RttiScan::ClassInfo info;
+            info.name = entry.at("name").get<std::string>();
+            info.decorated = entry.at("decorated").get<std::string>();
+            info.vtable = entry.at("vtable").get<uint32_t>();
+            info.offset = entry.at("offset").get<uint32_t>();
+            info.slots = entry.at("slots").get<uint32_t>();
+            info.bases = entry.value("bases", std::vector<std::string>());
+            loaded.push_back(std::move(info));
+        }
+        return true;
+    } catch (const json::exception& e) {
+        std::cerr << "[ERROR] Failed to parse " << cacheFile << ": " << e.what() << std::endl;
+        loaded.clear();
+        return false;
+    }
+}
+
+void SaveCache(const std::string& hash, const std::vector<RttiScan::ClassInfo>& scanned) {
+    json cache;
+    cache["imageHash"] = hash;
+    cache["classes"] = json::array();
+    for (const RttiScan::ClassInfo& info : scanned) {
+        cache["classes"].push_back({
+            { "name", info.name },
+            { "decorated", info.decorated },
+            { "vtable", info.vtable },
+            { "offset", info.offset },
+            { "slots", info.slots },
+            { "bases", info.bases },
+        });
+    }
+
+    std::ofstream file(cacheFile, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[ERROR] Failed to open " << cacheFile << std::endl;
+        return;
+    }
+    file << cache.dump();
+}
+
+void Build() {
+    const auto start = std::chrono::steady_clock::now();
+    const uintptr_t base = ModApi::Instance().GetSkyBase();
+    const size_t size = ModApi::Instance().GetSkySize();
+
+    RttiScan::Image image{ base, reinterpret_cast<const uint8_t*>(base), size, {} };
+    std::vector<RttiScan::ClassInfo> found;
+    bool cached = false;
+    if (!base || !RttiScan::ReadSections(image.data, image.size, image.sections)) {
+        std::cerr << "[ERROR] Sky.exe has no PE32+ headers to index vtables from" << std::endl;
+    } else {
+        const std::string hash = HashString(RttiScan::HashHeaders(image.data, image.size));
+        cached = LoadCache(hash, found);
+        if (!cached) {
+            found = RttiScan::Scan(image);
+            SaveCache(hash, found);
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "[+] Indexed " << found.size() << " vtables in " << elapsed.count() << " ms"
+              << (cached ? " (cached)" : "") << std::endl;
+
+    {
+        std::lock_guard<std::mutex> guard(indexLock);
+        imageBase = base;
+        classes = std::move(found);
+        for (size_t i = 0; i < classes.size(); ++i) {
+            byName.emplace(classes[i].name, i);
+            if (classes[i].decorated != classes[i].name) {
+                byName.emplace(classes[i].decorated, i);
+            }
+        }
+        ready = true;
+    }
+    indexReady.notify_all();
+}
+
+/**
+ * @brief Wait for the index, or build it here if the pool has not started on it
+ *
+ * Mods look classes up in Start, under the loader lock, when the pool's
+ * workers cannot run yet; waiting on them there would never return.
+ */
+void AwaitIndex(std::unique_lock<std::mutex>& guard) {
+    if (ready) {
+        return;
+    }
+    if (!building) {
+        building = true;
+        guard.unlock();
+        Build();
+        guard.lock();
+        return;
+    }
+    indexReady.wait(guard, [] { return ready; });
+}
+
+} // namespace
+
+namespace VTableIndex {
+
+void Start() {
+    {
+        std::lock_guard<std::mutex> guard(indexLock);
+        if (started) {
+            return;
+        }
+        started = true;
+    }
+    ThreadPool::Shared().Submit([] {
+        {
+            std::lock_guard<std::mutex> guard(indexLock);
+            if (building) {
+                return;
+            }
+            building = true;
+        }
+        Build();
+    });
+}
+
+uintptr_t Find(const std::string& name, uint32_t offset, size_t* slots) {
+    std::unique_lock<std::mutex> guard(indexLock);
+    if (!started) {
+        return 0;
+    }
+    AwaitIndex(guard);
+
+    auto [first, last] = byName.equal_range(name);
+    for (auto it = first; it != last; ++it) {
+        const RttiScan::ClassInfo& info = classes[it->second];
+        if (info.offset == offset) {
+            if (slots) *slots = info.slots;
+            return imageBase + info.vtable;
+        }
+    }
+    return 0;
+}
+
+size_t Slots(uintptr_t vtable) {
+    std::unique_lock<std::mutex> guard(indexLock);
+    if (!started) {
+        return 0;
+    }
+    AwaitIndex(guard);
+
+    for (const RttiScan::ClassInfo& info : classes) {
+        if (imageBase + info.vtable == vtable) {
+            return info.slots;
+        }
+    }
+    return 0;
+}
+
+} // namespace VTableIndex
@@ -0,0 +1,63 @@
+#include <array>
+
+#include "include/layer_config.h"
+#include "include/window_filter.h"
+
+namespace {
+
+using namespace WindowFilter;
+
+/**
+ * @brief Where each message below WM_USER goes while the menu is hidden
+ *
+ * Releases, focus and input device changes still reach ImGui, which keeps its
+ * key and button state from going stale for when the menu opens again. Every
+ * other message goes straight to the game, since nothing draws with ImGui
+ * while it is hidden; only the ones InputEvents::Publish turns into events
+ * stop at the event ring on the way.
+ */
+constexpr auto hiddenMenuActions = [] {
+    std::array<Action, kUser> table{};
+    table.fill(ACTION_PASS);
+    for (uint32_t message : {kKeyDown, kKeyUp, kChar, kSysKeyDown, kSysKeyUp, kSetFocus, kKillFocus}) {
+        table[message] = ACTION_GAME;
+    }
+    for (uint32_t message = kMouseFirst; message <= kMouseLast; ++message) {
+        table[message] = ACTION_GAME;
+    }
+    for (uint32_t message : {kKeyUp, kSysKeyUp, kLButtonUp, kRButtonUp, kMButtonUp, kXButtonUp,
+                             kSetFocus, kKillFocus, kMouseLeave, kInputLangChange, kDeviceChange}) {
+        table[message] = ACTION_IMGUI;
+    }
+    return table;
+}();
+
+} // namespace
+
+namespace WindowFilter {
+
+Action Classify(uint32_t message, uint64_t wParam, bool menuVisible) {
+    if (message == kKeyDown) {
+        const LayerSettings& settings = LayerConfig::Get();
+        if (wParam == kMenuKey) {
+            return ACTION_TOGGLE_MENU;
+        }
+        if (wParam == settings.capture.hotkey && LayerConfig::IsEnabled(FEATURE_CAPTURE)) {
+            return ACTION_SCREENSHOT;
+        }
+        if (wParam == settings.recording.hotkey && LayerConfig::IsEnabled(FEATURE_CAPTURE)) {
+            return ACTION_RECORDING;
+        }
+        if (wParam == settings.trace.hotkey && LayerConfig::IsEnabled(FEATURE_TRACE)) {
+            return ACTION_TRACE;
+        }
+    }
+
+    // Mod UIs are drawn by the menu, so a hidden menu means ImGui has no use for the message
+    if (menuVisible) {
+        return ACTION_IMGUI;
+    }
+    return message < hiddenMenuActions.size() ? hiddenMenuActions[message] : ACTION_PASS;
+}
+
+} // namespace WindowFilter
@@ -0,0 +1,164 @@
+// FrameEncode: pixel conversion against a per-channel reference, and PNG
+// output decoded back with stb_image.
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// stb_image's 16-bit transparency path trips -Wmaybe-uninitialized at -O2
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include <stb_image.h>
+#pragma GCC diagnostic pop
+
+#include "include/frame_encode.h"
+#include "test.h"
+
+namespace {
+
+using FrameEncode::PixelFormat;
+
+/**
+ * @brief RGBA8 of one source pixel, from its channels rather than bit tricks
+ */
+uint32_t Reference(uint32_t p, PixelFormat format) {
+    uint32_t r, g, b;
+    switch (format) {
+    case FrameEncode::PIXEL_BGRA8:
+        b = p & 0xFF;
+        g = (p >> 8) & 0xFF;
+        r = (p >> 16) & 0xFF;
+        break;
+    case FrameEncode::PIXEL_A2B10G10R10:
+        r = (p & 0x3FF) >> 2;
+        g = ((p >> 10) & 0x3FF) >> 2;
+        b = ((p >> 20) & 0x3FF) >> 2;
+        break;
+    case FrameEncode::PIXEL_A2R10G10B10:
+        b = (p & 0x3FF) >> 2;
+        g = ((p >> 10) & 0x3FF) >> 2;
+        r = ((p >> 20) & 0x3FF) >> 2;
+        break;
+    default:
+        r = p & 0xFF;
+        g = (p >> 8) & 0xFF;
+        b = (p >> 16) & 0xFF;
+        break;
+    }
+    return r | (g << 8) | (b << 16) | 0xFF000000u;
+}
+
+void TestToRGBA8() {
+    std::mt19937 random(1234);
+    const PixelFormat formats[] = {
+        FrameEncode::PIXEL_RGBA8, FrameEncode::PIXEL_BGRA8,
+        FrameEncode::PIXEL_A2B10G10R10, FrameEncode::PIXEL_A2R10G10B10,
+    };
+
+    // Counts around the 4-pixel vector width exercise the scalar tails
+    for (size_t pixels : {0, 1, 3, 4, 5, 17, 1031}) {
+        std::vector<uint32_t> source(pixels);
+        for (uint32_t& p : source) {
+            p = random();
+        }
+
+        for (PixelFormat format : formats) {
+            std::vector<uint8_t> out(pixels * 4);
+            FrameEncode::ToRGBA8(source.data(), out.data(), pixels, format);
+            for (size_t i = 0; i < pixels; ++i) {
+                uint32_t p;
+                memcpy(&p, out.data() + i * 4, 4);
+                CHECK_EQ(p, Reference(source[i], format));
+            }
+
+            // In place, as the capture path converts its readback buffer
+            std::vector<uint32_t> inPlace = source;
+            FrameEncode::ToRGBA8(inPlace.data(), reinterpret_cast<uint8_t*>(inPlace.data()), pixels, format);
+            CHECK(memcmp(inPlace.data(), out.data(), out.size()) == 0);
+        }
+    }
+}
+
+void TestI420() {
+    // Limited range: white is Y 235, black Y 16, and grey has no chroma
+    const uint32_t width = 5;
+    std::vector<uint8_t> white(width * 4, 255);
+    std::vector<uint8_t> black(width * 4, 0);
+    for (uint32_t x = 0; x < width; ++x) {
+        black[x * 4 + 3] = 255;
+    }
+
+    std::vector<uint8_t> y0(width), y1(width), u((width + 1) / 2), v((width + 1) / 2);
+    FrameEncode::RGBA8ToI420Rows(white.data(), black.data(), width, y0.data(), y1.data(), u.data(), v.data());
+    for (uint32_t x = 0; x < width; ++x) {
+        CHECK_EQ(y0[x], 235);
+        CHECK_EQ(y1[x], 16);
+    }
+    for (size_t i = 0; i < u.size(); ++i) {
+        CHECK_EQ(u[i], 128);
+        CHECK_EQ(v[i], 128);
+    }
+}
+
+void TestPNG() {
+    const FrameEncode::Encoder* png = FrameEncode::FindEncoder("png");
+    CHECK(png != nullptr);
+    CHECK(FrameEncode::FindEncoder("tiff") == nullptr);
+    if (!png) {
+        return;
+    }
+
+    // Noise in the top half, flat runs and a gradient below for the match finder
+    const uint32_t width = 67;
+    const uint32_t height = 45;
+    std::mt19937 random(99);
+    std::vector<uint8_t> rgba(size_t(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = &rgba[(size_t(y) * width + x) * 4];
+            if (y < height / 2) {
+                p[0] = static_cast<uint8_t>(random());
+                p[1] = static_cast<uint8_t>(random());
+                p[2] = static_cast<uint8_t>(random());
+            } else {
+                p[0] = static_cast<uint8_t>(x * 3);
+                p[1] = static_cast<uint8_t>(x < 30 ? 200 : 10);
+                p[2] = static_cast<uint8_t>(y);
+            }
+            p[3] = 255;
+        }
+    }
+
+    std::vector<uint8_t> encoded;
+    CHECK(png->encode(rgba.data(), width, height, encoded));
+
+    int decodedWidth = 0, decodedHeight = 0, channels = 0;
+    stbi_uc* decoded = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()),
+        &decodedWidth, &decodedHeight, &channels, 3);
+    CHECK(decoded != nullptr);
+    if (!decoded) {
+        return;
+    }
+
+    CHECK_EQ(decodedWidth, static_cast<int>(width));
+    CHECK_EQ(decodedHeight, static_cast<int>(height));
+    CHECK_EQ(channels, 3);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < size_t(width) * height; ++i) {
+        mismatches += memcmp(decoded + i * 3, rgba.data() + i * 4, 3) != 0;
+    }
+    CHECK_EQ(mismatches, 0u);
+    stbi_image_free(decoded);
+}
+
+} // namespace
+
+int main() {
+    TestToRGBA8();
+    TestI420();
+    TestPNG();
+    return test::Finish("frame_encode_test");
+}
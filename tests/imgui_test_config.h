@@ -0,0 +1,5 @@
+#pragma once
+
+// Included by imgui.h ahead of imconfig.h, which marks the API
+// __declspec(dllexport) for the Windows build of the loader
+#define __declspec(x)
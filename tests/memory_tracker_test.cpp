@@ -0,0 +1,146 @@
+// MemoryUsage: the memory tracker's accounting of allocations, resources and
+// binds by memory type, the HandleMap under it, and heap budget lookup.
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "include/handle_map.h"
+#include "include/memory_usage.h"
+#include "test.h"
+
+namespace {
+
+VkPhysicalDeviceMemoryProperties MakeProperties() {
+    // Two types on the device-local heap, one on the host heap
+    VkPhysicalDeviceMemoryProperties properties = {};
+    properties.memoryHeapCount = 2;
+    properties.memoryHeaps[0] = { 8ull << 30, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT };
+    properties.memoryHeaps[1] = { 16ull << 30, 0 };
+    properties.memoryTypeCount = 3;
+    properties.memoryTypes[0] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0 };
+    properties.memoryTypes[1] = { VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, 1 };
+    properties.memoryTypes[2] = { VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, 0 };
+    return properties;
+}
+
+void TestHandleMap() {
+    // Keys that share home slots, inserted and erased in an order that forces backward shifts
+    HandleMap<uint32_t> map;
+    std::unordered_map<uint64_t, uint32_t> reference;
+    uint64_t state = 12345;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const uint64_t key = ((state >> 40) % 4096 + 1) * 0x1000;
+        if (state & 0x10000) {
+            map.Insert(key, i);
+            reference[key] = i;
+        } else {
+            uint32_t value = 0;
+            const bool erased = map.Erase(key, &value);
+            CHECK_EQ(erased, reference.count(key) == 1);
+            if (erased) {
+                CHECK_EQ(value, reference[key]);
+                reference.erase(key);
+            }
+        }
+    }
+
+    CHECK_EQ(map.size(), reference.size());
+    for (const auto& [key, value] : reference) {
+        const uint32_t* found = map.Get(key);
+        CHECK(found && *found == value);
+    }
+    CHECK(map.Get(0x7) == nullptr);
+    CHECK(HandleMap<uint32_t>().Get(0x1000) == nullptr);
+}
+
+void TestAllocations() {
+    const VkPhysicalDeviceMemoryProperties properties = MakeProperties();
+    MemoryUsage usage;
+    usage.Allocate(0x10, 1000, 0);
+    usage.Allocate(0x20, 200, 2);
+    usage.Allocate(0x30, 30, 1);
+    usage.Allocate(0x40, 5, VK_MAX_MEMORY_TYPES); // Not a memory type; ignored
+    CHECK_EQ(usage.Allocations(), 3u);
+    CHECK_EQ(usage.Type(0).bytes, 1000u);
+    CHECK_EQ(usage.Type(2).count, 1u);
+    CHECK_EQ(usage.Type(VK_MAX_MEMORY_TYPES).bytes, 0u);
+
+    // Heap 0 holds types 0 and 2
+    CHECK_EQ(usage.HeapBytes(properties, 0), 1200u);
+    CHECK_EQ(usage.HeapBytes(properties, 1), 30u);
+    CHECK_EQ(usage.HeapBytes(properties, 5), 0u);
+
+    // A second free, of VK_NULL_HANDLE or of a handle never seen, changes nothing
+    CHECK(usage.Free(0x20));
+    CHECK(!usage.Free(0x20));
+    CHECK(!usage.Free(0));
+    CHECK(!usage.Free(0x40));
+    CHECK_EQ(usage.Type(2).bytes, 0u);
+    CHECK_EQ(usage.Type(2).count, 0u);
+    CHECK_EQ(usage.HeapBytes(properties, 0), 1000u);
+    CHECK_EQ(usage.Allocations(), 2u);
+}
+
+void TestBinds() {
+    MemoryUsage usage;
+    usage.Allocate(0x10, 1000, 0);
+    usage.AddBuffer(0xB1, 100);
+    usage.AddBuffer(0xB2, 300);
+    usage.AddImage(0x11, 400);
+    CHECK_EQ(usage.BufferBytes(), 400u);
+    CHECK_EQ(usage.ImageBytes(), 400u);
+    CHECK_EQ(usage.Type(0).bound, 0u); // Created, not yet bound
+
+    CHECK(usage.BindBuffer(0xB1, 0x10));
+    CHECK(usage.BindImage(0x11, 0x10));
+    CHECK(!usage.BindBuffer(0xB1, 0x10)); // Already bound
+    CHECK(!usage.BindBuffer(0xB3, 0x10)); // Unknown buffer
+    CHECK(!usage.BindBuffer(0xB2, 0x99)); // Unknown memory
+    CHECK_EQ(usage.Type(0).bound, 500u);
+
+    usage.RemoveBuffer(0xB1);
+    usage.RemoveBuffer(0xB1);
+    CHECK_EQ(usage.Buffers(), 1u);
+    CHECK_EQ(usage.BufferBytes(), 300u);
+    CHECK_EQ(usage.Type(0).bound, 400u);
+
+    // Freeing memory under a live image drops its bound bytes once; a new allocation
+    // reusing the handle is not charged when the image goes
+    CHECK(usage.Free(0x10));
+    CHECK_EQ(usage.Type(0).bound, 0u);
+    usage.Allocate(0x10, 2000, 0);
+    CHECK(usage.BindBuffer(0xB2, 0x10));
+    usage.RemoveImage(0x11);
+    CHECK_EQ(usage.Images(), 0u);
+    CHECK_EQ(usage.ImageBytes(), 0u);
+    CHECK_EQ(usage.Type(0).bound, 300u);
+    CHECK_EQ(usage.Type(0).bytes, 2000u);
+}
+
+void TestBudget() {
+    const VkPhysicalDeviceMemoryProperties properties = MakeProperties();
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, nullptr, 0), 8ull << 30);
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, nullptr, 1), 16ull << 30);
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, nullptr, 2), 0u);
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, nullptr, VK_MAX_MEMORY_HEAPS), 0u);
+
+    // The driver's budget wins where it reports one
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget = {};
+    budget.heapBudget[0] = 6ull << 30;
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, &budget, 0), 6ull << 30);
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, &budget, 1), 16ull << 30);
+    budget.heapBudget[2] = 1;
+    CHECK_EQ(MemoryUsage::HeapBudget(properties, &budget, 2), 0u);
+}
+
+} // namespace
+
+int main() {
+    TestHandleMap();
+    TestAllocations();
+    TestBinds();
+    TestBudget();
+    return test::Finish("memory_tracker_test");
+}
@@ -0,0 +1,176 @@
+// ModCommands: how mod secondaries are queued, published, executed in
+// submission order and handed out again, against stubbed Vulkan entry points
+// that record what the loader asks of them.
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "include/mod_commands.h"
+#include "test.h"
+
+namespace {
+
+template <typename Handle>
+Handle Fake(uintptr_t value) {
+    return reinterpret_cast<Handle>(value);
+}
+
+const VkDevice kDevice = Fake<VkDevice>(0x10);
+const VkRenderPass kRenderPass = Fake<VkRenderPass>(0x20);
+const VkCommandBuffer kPrimary = Fake<VkCommandBuffer>(0x30);
+const VkCommandBuffer kOverlay = Fake<VkCommandBuffer>(0x40);
+
+uintptr_t nextHandle = 0x1000;
+int poolsCreated = 0;
+int poolsDestroyed = 0;
+int buffersAllocated = 0;
+VkResult endResult = VK_SUCCESS;
+VkCommandBufferUsageFlags lastBeginFlags = 0;
+std::vector<VkCommandBuffer> executed;
+
+} // namespace
+
+extern "C" {
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateCommandPool(VkDevice, const VkCommandPoolCreateInfo*, const VkAllocationCallbacks*, VkCommandPool* pCommandPool) {
+    ++poolsCreated;
+    *pCommandPool = Fake<VkCommandPool>(nextHandle++);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyCommandPool(VkDevice, VkCommandPool, const VkAllocationCallbacks*) {
+    ++poolsDestroyed;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateCommandBuffers(VkDevice, const VkCommandBufferAllocateInfo* pAllocateInfo, VkCommandBuffer* pCommandBuffers) {
+    CHECK_EQ(pAllocateInfo->level, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    ++buffersAllocated;
+    *pCommandBuffers = Fake<VkCommandBuffer>(nextHandle++);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBeginCommandBuffer(VkCommandBuffer, const VkCommandBufferBeginInfo* pBeginInfo) {
+    CHECK(pBeginInfo->pInheritanceInfo != nullptr);
+    lastBeginFlags = pBeginInfo->flags;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkEndCommandBuffer(VkCommandBuffer) {
+    return endResult;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t count, const VkCommandBuffer* pCommandBuffers) {
+    CHECK(commandBuffer == kPrimary);
+    executed.assign(pCommandBuffers, pCommandBuffers + count);
+}
+}
+
+namespace {
+
+void Target() {
+    ModCommands::OnRenderTarget(kDevice, 0, kRenderPass, VK_FORMAT_B8G8R8A8_UNORM, { 1920, 1080 });
+}
+
+VkCommandBuffer BeginOnOtherThread() {
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    std::thread([&] { commandBuffer = ModCommands::Begin(); }).join();
+    return commandBuffer;
+}
+
+void TestQueue() {
+    ModRenderTarget target = {};
+    CHECK(!ModCommands::GetRenderTarget(target));
+    CHECK(ModCommands::Begin() == VK_NULL_HANDLE);
+
+    Target();
+    CHECK(ModCommands::GetRenderTarget(target));
+    CHECK(target.renderPass == kRenderPass);
+    CHECK_EQ(target.extent.width, 1920u);
+
+    // Mod buffers are re-executed while earlier frames are in flight
+    const VkCommandBuffer first = ModCommands::Begin();
+    CHECK(first != VK_NULL_HANDLE);
+    CHECK(lastBeginFlags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
+    CHECK(lastBeginFlags & VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+
+    // Every thread records from its own pool
+    const VkCommandBuffer second = BeginOnOtherThread();
+    CHECK(second != VK_NULL_HANDLE && second != first);
+    CHECK_EQ(poolsCreated, 2);
+
+    // Nothing is drawn until the UI frame publishes, then in submission order under the UI
+    ModCommands::Submit(second);
+    ModCommands::Submit(first);
+    CHECK(!ModCommands::HasCommands());
+    ModCommands::Publish();
+    CHECK(ModCommands::HasCommands());
+    ModCommands::Execute(kPrimary, 0, kOverlay);
+    CHECK((executed == std::vector<VkCommandBuffer>{ second, first, kOverlay }));
+
+    // Published buffers are drawn on every present until the next UI frame
+    ModCommands::Execute(kPrimary, 1, kOverlay);
+    CHECK((executed == std::vector<VkCommandBuffer>{ second, first, kOverlay }));
+    ModCommands::Publish();
+    CHECK(!ModCommands::HasCommands());
+
+    // A retired buffer comes back to its thread only once every frame executing it finished
+    const int allocated = buffersAllocated;
+    const VkCommandBuffer third = ModCommands::Begin();
+    CHECK(third != first);
+    CHECK_EQ(buffersAllocated, allocated + 1);
+    ModCommands::FrameDone(0);
+    CHECK(ModCommands::Begin() != first);
+    ModCommands::FrameDone(1);
+    CHECK(ModCommands::Begin() == first);
+    CHECK_EQ(buffersAllocated, allocated + 2);
+}
+
+void TestDropped() {
+    // A buffer begun for a previous render target is dropped on submit and reused
+    const VkCommandBuffer stale = ModCommands::Begin();
+    Target();
+    ModCommands::Submit(stale);
+    ModCommands::Publish();
+    CHECK(!ModCommands::HasCommands());
+    CHECK(ModCommands::Begin() == stale);
+
+    // So is one that failed to end, and one the loader never handed out is ignored
+    const VkCommandBuffer failed = ModCommands::Begin();
+    endResult = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    ModCommands::Submit(failed);
+    endResult = VK_SUCCESS;
+    ModCommands::Submit(kOverlay);
+    ModCommands::Submit(VK_NULL_HANDLE);
+    ModCommands::Publish();
+    CHECK(!ModCommands::HasCommands());
+    CHECK(ModCommands::Begin() == failed);
+
+    // A new render target takes back what was still published or in flight
+    const VkCommandBuffer inFlight = ModCommands::Begin();
+    ModCommands::Submit(inFlight);
+    ModCommands::Publish();
+    ModCommands::Execute(kPrimary, 2, kOverlay);
+    Target();
+    CHECK(!ModCommands::HasCommands());
+    CHECK(ModCommands::Begin() == inFlight);
+}
+
+void TestDestroyDevice() {
+    ModCommands::OnDestroyDevice(Fake<VkDevice>(0x99));
+    CHECK_EQ(poolsDestroyed, 0);
+    ModCommands::OnDestroyDevice(kDevice);
+    CHECK_EQ(poolsDestroyed, poolsCreated);
+
+    ModRenderTarget target = {};
+    CHECK(!ModCommands::GetRenderTarget(target));
+    CHECK(ModCommands::Begin() == VK_NULL_HANDLE);
+}
+
+} // namespace
+
+int main() {
+    TestQueue();
+    TestDropped();
+    TestDestroyDevice();
+    return test::Finish("mod_commands_test");
+}
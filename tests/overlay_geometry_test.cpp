@@ -0,0 +1,109 @@
+// OverlayGeometry: the vertex and index high-water mark, how it sizes the
+// backend's buffers, and how it is saved and loaded across runs.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#include <imgui.h>
+
+#include "include/json.hpp"
+#include "include/overlay_geometry.h"
+#include "test.h"
+
+// ImGui itself is not linked; the draw data only carries the totals here
+void ImDrawData::Clear() {
+    Valid = false;
+    CmdListsCount = TotalIdxCount = TotalVtxCount = 0;
+    OwnerViewport = nullptr;
+}
+
+void ImGui::MemFree(void* ptr) {
+    free(ptr);
+}
+
+namespace {
+
+constexpr const char* kMarkFile = "tsml_overlay_geometry.json";
+constexpr VkDeviceSize kKiB = 1024;
+constexpr VkDeviceSize kMiB = 1024 * kKiB;
+
+void Track(int vertices, int indices) {
+    ImDrawData drawData;
+    drawData.TotalVtxCount = vertices;
+    drawData.TotalIdxCount = indices;
+    OverlayGeometry::Track(&drawData);
+}
+
+void WriteMarks(const char* contents) {
+    std::ofstream(kMarkFile, std::ios::out | std::ios::trunc) << contents;
+}
+
+/**
+ * @brief Wait for the save on the shared pool to write both marks
+ */
+bool WaitForSave(uint64_t vertexBytes, uint64_t indexBytes) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::ifstream file(kMarkFile);
+        const nlohmann::json marks = nlohmann::json::parse(file, nullptr, false);
+        if (!marks.is_discarded() && marks.value("vertexBytes", uint64_t(0)) == vertexBytes &&
+            marks.value("indexBytes", uint64_t(0)) == indexBytes) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+void TestSizing() {
+    std::remove(kMarkFile);
+
+    // Without a saved mark the buffers start at the floor
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 64 * kKiB);
+    Track(0, 0);
+    OverlayGeometry::Track(nullptr);
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 64 * kKiB);
+
+    // Half again the larger of the two marks, rounded up to a power of two
+    Track(100'000, 30'000);
+    const uint64_t vertexBytes = 100'000 * sizeof(ImDrawVert);
+    CHECK(WaitForSave(vertexBytes, 30'000 * sizeof(ImDrawIdx)));
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 4 * kMiB);
+
+    // A smaller frame never lowers the mark
+    Track(10, 10);
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 4 * kMiB);
+
+    // The index mark grows on its own and is saved with the vertex mark
+    Track(10, 2'000'000);
+    CHECK(WaitForSave(vertexBytes, 2'000'000 * sizeof(ImDrawIdx)));
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 8 * kMiB);
+}
+
+void TestLoad() {
+    // A mark from an earlier run raises this one; a lower one is ignored
+    WriteMarks(R"({ "vertexBytes": 20000000, "indexBytes": 5 })");
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 32 * kMiB);
+    WriteMarks(R"({ "vertexBytes": 10, "indexBytes": 10 })");
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 32 * kMiB);
+
+    // A damaged file is reported and changes nothing, and no file can ask for more than the cap
+    WriteMarks("{ \"vertexBytes\": ");
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 32 * kMiB);
+    WriteMarks(R"({ "vertexBytes": 1000000000000 })");
+    CHECK_EQ(OverlayGeometry::MinAllocationSize(), 64 * kMiB);
+
+    std::remove(kMarkFile);
+}
+
+} // namespace
+
+int main() {
+    TestSizing();
+    TestLoad();
+    return test::Finish("overlay_geometry_test");
+}
@@ -0,0 +1,206 @@
+// OverlaySubmit: the batches of one frame, recorded by a mock dispatch table,
+// for each way the image and the game's semaphores reach the overlay.
+
+#include <cstdint>
+#include <vector>
+
+#include "include/overlay_submit.h"
+#include "include/trace.h"
+#include "test.h"
+
+// Tracing is never enabled here; the scopes only need the symbols
+namespace Trace {
+std::atomic<bool> enabled{ false };
+uint64_t Now() { return 0; }
+void Complete(const char*, uint64_t, const char*) {}
+} // namespace Trace
+
+namespace {
+
+template <typename Handle>
+Handle Fake(uintptr_t value) {
+    return reinterpret_cast<Handle>(value);
+}
+
+struct Batch {
+    VkQueue queue;
+    std::vector<VkSemaphore> waits;
+    std::vector<VkCommandBuffer> commands;
+    std::vector<VkSemaphore> signals;
+    uint64_t timelineValue; // 0 without a timeline signal
+    VkFence fence;
+};
+
+std::vector<Batch> batches;
+VkResult failAt = VK_SUCCESS; // Returned by the submit numbered failIndex
+size_t failIndex = 0;
+
+VKAPI_ATTR VkResult VKAPI_CALL RecordSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence) {
+    CHECK_EQ(submitCount, 1u);
+    const VkSubmitInfo& info = pSubmits[0];
+    Batch batch{ queue, {}, {}, {}, 0, fence };
+    batch.waits.assign(info.pWaitSemaphores, info.pWaitSemaphores + info.waitSemaphoreCount);
+    batch.commands.assign(info.pCommandBuffers, info.pCommandBuffers + info.commandBufferCount);
+    batch.signals.assign(info.pSignalSemaphores, info.pSignalSemaphores + info.signalSemaphoreCount);
+    for (uint32_t i = 0; i < info.waitSemaphoreCount; ++i) {
+        CHECK(info.pWaitDstStageMask[i] != 0);
+    }
+
+    const auto* timeline = static_cast<const VkTimelineSemaphoreSubmitInfo*>(info.pNext);
+    if (timeline) {
+        CHECK_EQ(timeline->sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+        CHECK_EQ(timeline->signalSemaphoreValueCount, info.signalSemaphoreCount);
+        batch.timelineValue = timeline->pSignalSemaphoreValues[info.signalSemaphoreCount - 1];
+    }
+
+    batches.push_back(std::move(batch));
+    return batches.size() == failIndex ? failAt : VK_SUCCESS;
+}
+
+const VkQueue presentQueue = Fake<VkQueue>(0x100);
+const VkQueue graphicsQueue = Fake<VkQueue>(0x200);
+const VkSemaphore gameWaits[2] = { Fake<VkSemaphore>(0x1), Fake<VkSemaphore>(0x2) };
+const VkSemaphore timeline = Fake<VkSemaphore>(0x7);
+
+OverlaySubmit::Frame MakeFrame(VkQueue queue, bool transfer, uint32_t gameWaitCount) {
+    OverlaySubmit::Frame frame = {};
+    frame.presentQueue = queue;
+    frame.graphicsQueue = graphicsQueue;
+    frame.gameWaitCount = gameWaitCount;
+    frame.gameWaits = gameWaits;
+    frame.transfer = transfer;
+    frame.overlay = Fake<VkCommandBuffer>(0x10);
+    frame.release = Fake<VkCommandBuffer>(0x11);
+    frame.acquire = Fake<VkCommandBuffer>(0x12);
+    frame.released = Fake<VkSemaphore>(0x20);
+    frame.drawn = Fake<VkSemaphore>(0x21);
+    frame.ready = Fake<VkSemaphore>(0x22);
+    frame.fence = Fake<VkFence>(0x30);
+    frame.timeline = timeline;
+    frame.timelineValue = 42;
+    return frame;
+}
+
+VkResult Run(const OverlaySubmit::Frame& frame, VkSemaphore& presentWait, bool& overlaySubmitted) {
+    VkLayerDispatchTable dispatch = {};
+    dispatch.QueueSubmit = RecordSubmit;
+    batches.clear();
+    presentWait = VK_NULL_HANDLE;
+    return OverlaySubmit::Submit(dispatch, frame, presentWait, overlaySubmitted);
+}
+
+void TestTransfer() {
+    // Release on the present queue, overlay on the graphics queue, acquire back on the present queue
+    const OverlaySubmit::Frame frame = MakeFrame(presentQueue, true, 2);
+    VkSemaphore presentWait;
+    bool overlaySubmitted;
+    CHECK_EQ(Run(frame, presentWait, overlaySubmitted), VK_SUCCESS);
+    CHECK(overlaySubmitted);
+    CHECK_EQ(batches.size(), 3u);
+    if (batches.size() != 3) {
+        return;
+    }
+
+    const Batch& release = batches[0];
+    CHECK(release.queue == presentQueue);
+    CHECK(release.waits == std::vector<VkSemaphore>(gameWaits, gameWaits + 2));
+    CHECK(release.commands == std::vector<VkCommandBuffer>{ frame.release });
+    CHECK(release.signals == std::vector<VkSemaphore>{ frame.released });
+    CHECK(release.fence == VK_NULL_HANDLE);
+
+    const Batch& overlay = batches[1];
+    CHECK(overlay.queue == graphicsQueue);
+    CHECK(overlay.waits == std::vector<VkSemaphore>{ frame.released });
+    CHECK(overlay.commands == std::vector<VkCommandBuffer>{ frame.overlay });
+    CHECK(overlay.signals == std::vector<VkSemaphore>{ frame.drawn });
+    CHECK_EQ(overlay.timelineValue, 0u);
+    CHECK(overlay.fence == VK_NULL_HANDLE);
+
+    // The frame is done, and its fence and timeline signalled, only once the image is back
+    const Batch& acquire = batches[2];
+    CHECK(acquire.queue == presentQueue);
+    CHECK(acquire.waits == std::vector<VkSemaphore>{ frame.drawn });
+    CHECK(acquire.commands == std::vector<VkCommandBuffer>{ frame.acquire });
+    CHECK((acquire.signals == std::vector<VkSemaphore>{ frame.ready, timeline }));
+    CHECK_EQ(acquire.timelineValue, 42u);
+    CHECK(acquire.fence == frame.fence);
+
+    CHECK(presentWait == frame.ready);
+}
+
+void TestSameQueue() {
+    // The overlay batch waits on the game's semaphores itself and finishes the frame
+    const OverlaySubmit::Frame frame = MakeFrame(graphicsQueue, false, 1);
+    VkSemaphore presentWait;
+    bool overlaySubmitted;
+    CHECK_EQ(Run(frame, presentWait, overlaySubmitted), VK_SUCCESS);
+    CHECK(overlaySubmitted);
+    CHECK_EQ(batches.size(), 1u);
+    if (batches.size() != 1) {
+        return;
+    }
+
+    const Batch& overlay = batches[0];
+    CHECK(overlay.queue == graphicsQueue);
+    CHECK(overlay.waits == std::vector<VkSemaphore>{ gameWaits[0] });
+    CHECK(overlay.commands == std::vector<VkCommandBuffer>{ frame.overlay });
+    CHECK((overlay.signals == std::vector<VkSemaphore>{ frame.drawn, timeline }));
+    CHECK_EQ(overlay.timelineValue, 42u);
+    CHECK(overlay.fence == frame.fence);
+    CHECK(presentWait == frame.drawn);
+}
+
+void TestOrderOnlyOtherQueue() {
+    // No semaphores from the game: an empty batch on its queue orders its work before the overlay
+    OverlaySubmit::Frame frame = MakeFrame(presentQueue, false, 0);
+    frame.timeline = VK_NULL_HANDLE;
+    VkSemaphore presentWait;
+    bool overlaySubmitted;
+    CHECK_EQ(Run(frame, presentWait, overlaySubmitted), VK_SUCCESS);
+    CHECK_EQ(batches.size(), 2u);
+    if (batches.size() != 2) {
+        return;
+    }
+
+    const Batch& release = batches[0];
+    CHECK(release.queue == presentQueue);
+    CHECK(release.waits.empty());
+    CHECK(release.commands.empty());
+    CHECK(release.signals == std::vector<VkSemaphore>{ frame.released });
+
+    const Batch& overlay = batches[1];
+    CHECK(overlay.queue == graphicsQueue);
+    CHECK(overlay.waits == std::vector<VkSemaphore>{ frame.released });
+    CHECK(overlay.signals == std::vector<VkSemaphore>{ frame.drawn });
+    CHECK_EQ(overlay.timelineValue, 0u);
+    CHECK(overlay.fence == frame.fence);
+    CHECK(presentWait == frame.drawn);
+}
+
+void TestFailedAcquire() {
+    // The overlay is queued, so a capture copy in it still has to be tracked
+    const OverlaySubmit::Frame frame = MakeFrame(presentQueue, true, 1);
+    failAt = VK_ERROR_DEVICE_LOST;
+    failIndex = 3;
+    VkSemaphore presentWait;
+    bool overlaySubmitted;
+    CHECK_EQ(Run(frame, presentWait, overlaySubmitted), VK_ERROR_DEVICE_LOST);
+    CHECK(overlaySubmitted);
+    CHECK(presentWait == VK_NULL_HANDLE);
+
+    failIndex = 1;
+    CHECK_EQ(Run(frame, presentWait, overlaySubmitted), VK_ERROR_DEVICE_LOST);
+    CHECK(!overlaySubmitted);
+    CHECK_EQ(batches.size(), 1u);
+    failIndex = 0;
+}
+
+} // namespace
+
+int main() {
+    TestTransfer();
+    TestSameQueue();
+    TestOrderOnlyOtherQueue();
+    TestFailedAcquire();
+    return test::Finish("overlay_submit_test");
+}
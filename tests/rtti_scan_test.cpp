@@ -0,0 +1,228 @@
+// RttiScan: section table, header hash, name demangling and the vtable scan
+// over a synthetic PE32+ image laid out like MSVC's x64 RTTI.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "include/rtti_scan.h"
+#include "test.h"
+
+namespace {
+
+constexpr uintptr_t kBase = 0x140000000;
+constexpr uint32_t kHeader = 0x80;
+constexpr uint32_t kText = 0x1000;
+constexpr uint32_t kRdata = 0x2000;
+constexpr uint32_t kImageSize = 0x4000;
+
+/**
+ * @brief A mapped image with .text and .rdata, filled in through a bump allocator in .rdata
+ */
+class ImageBuilder {
+public:
+    ImageBuilder() : data(kImageSize, 0) {
+        Put<uint32_t>(0x3C, kHeader);
+        Put<uint32_t>(kHeader, 0x00004550);          // "PE\0\0"
+        Put<uint16_t>(kHeader + 6, 2);               // Sections
+        Put<uint16_t>(kHeader + 20, 0xF0);           // Optional header size
+        Put<uint16_t>(kHeader + 24, 0x20B);          // PE32+
+        Put<uint32_t>(kHeader + 24 + 60, 0x200);     // SizeOfHeaders
+        AddSection(0, ".text", kText, 0x1000, 0x60000020);
+        AddSection(1, ".rdata", kRdata, 0x2000, 0x40000040);
+    }
+
+    template <typename T>
+    void Put(uint32_t rva, T value) {
+        memcpy(&data[rva], &value, sizeof(value));
+    }
+
+    uint32_t Take(uint32_t size, uint32_t align = 4) {
+        next = (next + align - 1) / align * align;
+        const uint32_t at = next;
+        next += size;
+        return at;
+    }
+
+    uint32_t TypeDescriptor(const std::string& decorated) {
+        const uint32_t rva = Take(16 + static_cast<uint32_t>(decorated.size()) + 1, 8);
+        memcpy(&data[rva + 16], decorated.c_str(), decorated.size() + 1);
+        return rva;
+    }
+
+    /**
+     * @brief Class Hierarchy Descriptor listing the class itself, then its bases
+     */
+    uint32_t Hierarchy(uint32_t self, const std::vector<uint32_t>& bases) {
+        std::vector<uint32_t> types = { self };
+        types.insert(types.end(), bases.begin(), bases.end());
+        const uint32_t array = Take(4 * static_cast<uint32_t>(types.size()));
+        for (size_t i = 0; i < types.size(); ++i) {
+            const uint32_t descriptor = Take(28);
+            Put<int32_t>(descriptor, static_cast<int32_t>(types[i]));
+            Put<int32_t>(array + static_cast<uint32_t>(i) * 4, static_cast<int32_t>(descriptor));
+        }
+        const uint32_t hierarchy = Take(16);
+        Put<uint32_t>(hierarchy + 8, static_cast<uint32_t>(types.size()));
+        Put<int32_t>(hierarchy + 12, static_cast<int32_t>(array));
+        return hierarchy;
+    }
+
+    /**
+     * @brief Complete Object Locator and the vtable after it
+     * @return RVA of the vtable's first slot
+     */
+    uint32_t VTable(uint32_t type, uint32_t hierarchy, uint32_t offset, uint32_t slots, int32_t self = -1) {
+        const uint32_t locator = Take(24);
+        Put<uint32_t>(locator, 1);
+        Put<uint32_t>(locator + 4, offset);
+        Put<int32_t>(locator + 12, static_cast<int32_t>(type));
+        Put<int32_t>(locator + 16, static_cast<int32_t>(hierarchy));
+        Put<int32_t>(locator + 20, self < 0 ? static_cast<int32_t>(locator) : self);
+
+        // Meta slot, the functions, and a null that ends the vtable
+        const uint32_t meta = Take(8 * (slots + 2), 8);
+        Put<uint64_t>(meta, kBase + locator);
+        for (uint32_t i = 0; i < slots; ++i) {
+            Put<uint64_t>(meta + 8 + i * 8, kBase + kText + 0x10 * (++functions));
+        }
+        return meta + 8;
+    }
+
+    RttiScan::Image Image(std::vector<RttiScan::Section> sections) const {
+        return { kBase, data.data(), data.size(), std::move(sections) };
+    }
+
+    std::vector<uint8_t> data;
+
+private:
+    void AddSection(uint32_t index, const char* name, uint32_t rva, uint32_t size, uint32_t characteristics) {
+        const uint32_t entry = kHeader + 24 + 0xF0 + index * 40;
+        memcpy(&data[entry], name, strlen(name));
+        Put<uint32_t>(entry + 8, size);
+        Put<uint32_t>(entry + 12, rva);
+        Put<uint32_t>(entry + 36, characteristics);
+    }
+
+    uint32_t next = kRdata;
+    uint32_t functions = 0;
+};
+
+const RttiScan::ClassInfo* Find(const std::vector<RttiScan::ClassInfo>& classes, const std::string& name, uint32_t offset) {
+    for (const RttiScan::ClassInfo& info : classes) {
+        if (info.name == name && info.offset == offset) return &info;
+    }
+    return nullptr;
+}
+
+void TestDemangle() {
+    CHECK(RttiScan::Demangle(".?AVEntity@@") == "class Entity");
+    CHECK(RttiScan::Demangle(".?AVButton@Widgets@UI@@") == "class UI::Widgets::Button");
+    CHECK(RttiScan::Demangle(".?AUListener@UI@@") == "struct UI::Listener");
+    // Templates and other names with nested decorations stay decorated
+    CHECK(RttiScan::Demangle(".?AV?$Vector@H@Game@@") == ".?AV?$Vector@H@Game@@");
+    CHECK(RttiScan::Demangle(".?AW4Mode@@") == ".?AW4Mode@@");
+    CHECK(RttiScan::Demangle(".?AV") == ".?AV");
+}
+
+void TestHeaders() {
+    ImageBuilder builder;
+    std::vector<RttiScan::Section> sections;
+    CHECK(RttiScan::ReadSections(builder.data.data(), builder.data.size(), sections));
+    CHECK_EQ(sections.size(), 2u);
+    if (sections.size() == 2) {
+        CHECK(sections[0].name == ".text" && sections[0].executable);
+        CHECK_EQ(sections[0].rva, kText);
+        CHECK(sections[1].name == ".rdata" && !sections[1].executable);
+        CHECK_EQ(sections[1].size, 0x2000u);
+    }
+
+    // Truncated headers and a PE32 image are refused
+    CHECK(!RttiScan::ReadSections(builder.data.data(), kHeader + 100, sections));
+    const uint64_t hash = RttiScan::HashHeaders(builder.data.data(), builder.data.size());
+    builder.Put<uint16_t>(kHeader + 24, 0x10B);
+    CHECK(!RttiScan::ReadSections(builder.data.data(), builder.data.size(), sections));
+
+    // Any change within the headers is a different build; past them it is not
+    CHECK(RttiScan::HashHeaders(builder.data.data(), builder.data.size()) != hash);
+    builder.Put<uint16_t>(kHeader + 24, 0x20B);
+    CHECK_EQ(RttiScan::HashHeaders(builder.data.data(), builder.data.size()), hash);
+    builder.Put<uint32_t>(0x300, 0xDEADBEEF);
+    CHECK_EQ(RttiScan::HashHeaders(builder.data.data(), builder.data.size()), hash);
+}
+
+void TestScan() {
+    ImageBuilder builder;
+
+    // Game::Entity, and Game::Player deriving from it alone
+    const uint32_t entity = builder.TypeDescriptor(".?AVEntity@Game@@");
+    const uint32_t entityVTable = builder.VTable(entity, builder.Hierarchy(entity, {}), 0, 3);
+    const uint32_t player = builder.TypeDescriptor(".?AVPlayer@Game@@");
+    const uint32_t playerVTable = builder.VTable(player, builder.Hierarchy(player, { entity }), 0, 5);
+
+    // UI::Widgets::Button : Game::Entity, UI::Listener, with the listener's vtable at +0x10
+    const uint32_t listener = builder.TypeDescriptor(".?AUListener@UI@@");
+    const uint32_t button = builder.TypeDescriptor(".?AVButton@Widgets@UI@@");
+    const uint32_t buttonHierarchy = builder.Hierarchy(button, { entity, listener });
+    const uint32_t buttonVTable = builder.VTable(button, buttonHierarchy, 0, 4);
+    const uint32_t buttonListenerVTable = builder.VTable(button, buttonHierarchy, 0x10, 2);
+
+    // Look-alikes: a locator that does not point back at itself, and one with no functions after it
+    const uint32_t decoy = builder.TypeDescriptor(".?AVDecoy@@");
+    builder.VTable(decoy, builder.Hierarchy(decoy, {}), 0, 3, 0x10);
+    builder.VTable(decoy, builder.Hierarchy(decoy, {}), 0, 0);
+
+    std::vector<RttiScan::Section> sections;
+    CHECK(RttiScan::ReadSections(builder.data.data(), builder.data.size(), sections));
+    const std::vector<RttiScan::ClassInfo> classes = RttiScan::Scan(builder.Image(sections));
+    CHECK_EQ(classes.size(), 4u);
+
+    const RttiScan::ClassInfo* info = Find(classes, "class Game::Entity", 0);
+    CHECK(info != nullptr);
+    if (info) {
+        CHECK_EQ(info->vtable, entityVTable);
+        CHECK_EQ(info->slots, 3u);
+        CHECK(info->bases.empty());
+    }
+
+    info = Find(classes, "class Game::Player", 0);
+    CHECK(info != nullptr);
+    if (info) {
+        CHECK(info->decorated == ".?AVPlayer@Game@@");
+        CHECK_EQ(info->vtable, playerVTable);
+        CHECK_EQ(info->slots, 5u);
+        CHECK(info->bases == std::vector<std::string>{ "class Game::Entity" });
+    }
+
+    info = Find(classes, "class UI::Widgets::Button", 0);
+    CHECK(info != nullptr);
+    if (info) {
+        CHECK_EQ(info->vtable, buttonVTable);
+        CHECK_EQ(info->slots, 4u);
+        CHECK((info->bases == std::vector<std::string>{ "class Game::Entity", "struct UI::Listener" }));
+    }
+
+    info = Find(classes, "class UI::Widgets::Button", 0x10);
+    CHECK(info != nullptr);
+    if (info) {
+        CHECK_EQ(info->vtable, buttonListenerVTable);
+        CHECK_EQ(info->slots, 2u);
+    }
+    CHECK(Find(classes, "class Decoy", 0) == nullptr);
+
+    // Without an executable section nothing counts as a virtual function
+    for (RttiScan::Section& section : sections) {
+        section.executable = false;
+    }
+    CHECK(RttiScan::Scan(builder.Image(sections)).empty());
+}
+
+} // namespace
+
+int main() {
+    TestDemangle();
+    TestHeaders();
+    TestScan();
+    return test::Finish("rtti_scan_test");
+}
@@ -0,0 +1,188 @@
+// SampleProfile: module lookup, per-thread aggregation and reports from
+// synthetic stacks, and .pdata lookup in a synthetic PE32+ image.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "include/sample_profile.h"
+#include "test.h"
+
+namespace {
+
+using SampleProfile::ModuleMap;
+
+ModuleMap MakeModules() {
+    // Unsorted, with an empty range and one overlapping Sky.exe that loses to it
+    ModuleMap modules;
+    modules.Assign({
+        { 0x7000, 0x8000, "loader.dll" },
+        { 0x1000, 0x5000, "Sky.exe" },
+        { 0x9000, 0x9000, "empty.dll" },
+        { 0x4000, 0x6000, "overlap.dll" },
+        { 0xA000, 0xB000, "mod.dll (mod)" },
+    });
+    return modules;
+}
+
+void TestModuleMap() {
+    const ModuleMap modules = MakeModules();
+    CHECK_EQ(modules.Size(), 3u);
+
+    CHECK_EQ(modules.Find(0x0FFF), -1);
+    CHECK(modules.Find(0x1000) >= 0 && modules.At(modules.Find(0x1000)).name == "Sky.exe");
+    CHECK(modules.Find(0x4FFF) >= 0 && modules.At(modules.Find(0x4FFF)).name == "Sky.exe");
+    CHECK_EQ(modules.Find(0x5000), -1);
+    CHECK(modules.Find(0x7ABC) >= 0 && modules.At(modules.Find(0x7ABC)).name == "loader.dll");
+    CHECK_EQ(modules.Find(0x9000), -1);
+    CHECK(modules.Find(0xAFFF) >= 0 && modules.At(modules.Find(0xAFFF)).name == "mod.dll (mod)");
+    CHECK_EQ(modules.Find(0xB000), -1);
+
+    CHECK(modules.Symbolize(0x1234) == "Sky.exe+0x234");
+    CHECK(modules.Symbolize(0x5555) == "0x5555");
+}
+
+const SampleProfile::ModuleShare* FindShare(const SampleProfile::Report& report, const std::string& name) {
+    for (const SampleProfile::ModuleShare& share : report.modules) {
+        if (share.name == name) return &share;
+    }
+    return nullptr;
+}
+
+void TestAggregator() {
+    const ModuleMap modules = MakeModules();
+    SampleProfile::Aggregator aggregator;
+
+    // Game code, twice at the same address, called from the game
+    const uintptr_t inGame[] = { 0x1100, 0x1200, 0x1300 };
+    aggregator.Add(modules, inGame, 3);
+    aggregator.Add(modules, inGame, 3);
+    // A mod's detour called by the loader, called by the game
+    const uintptr_t inMod[] = { 0xA010, 0x7010, 0x1400 };
+    aggregator.Add(modules, inMod, 3);
+    // Generated code called from the loader
+    const uintptr_t generated[] = { 0x5800, 0x7020 };
+    aggregator.Add(modules, generated, 2);
+    // A thread that could not be sampled adds nothing
+    aggregator.Add(modules, inGame, 0);
+
+    CHECK_EQ(aggregator.Samples(), 4u);
+    const SampleProfile::Report report = aggregator.Build(modules, 2);
+    CHECK_EQ(report.samples, 4u);
+    CHECK_EQ(report.unknown, 1u);
+
+    // Highest self first; a module counts once per sample however many of its frames are on the stack
+    CHECK_EQ(report.modules.size(), 3u);
+    CHECK(!report.modules.empty() && report.modules[0].name == "Sky.exe");
+    const SampleProfile::ModuleShare* game = FindShare(report, "Sky.exe");
+    const SampleProfile::ModuleShare* loader = FindShare(report, "loader.dll");
+    const SampleProfile::ModuleShare* mod = FindShare(report, "mod.dll (mod)");
+    CHECK(game && loader && mod);
+    if (game && loader && mod) {
+        CHECK_EQ(game->self, 2u);
+        CHECK_EQ(game->inclusive, 3u);
+        CHECK_EQ(loader->self, 0u);
+        CHECK_EQ(loader->inclusive, 2u);
+        CHECK_EQ(mod->self, 1u);
+        CHECK_EQ(mod->inclusive, 1u);
+    }
+
+    CHECK_EQ(report.hottest.size(), 2u);
+    if (!report.hottest.empty()) {
+        CHECK(report.hottest[0].symbol == "Sky.exe+0x100");
+        CHECK_EQ(report.hottest[0].samples, 2u);
+    }
+
+    // Counts are by name, so a module that moved is still reported under it
+    ModuleMap moved;
+    moved.Assign({ { 0x20000, 0x24000, "Sky.exe" } });
+    const SampleProfile::Report movedReport = aggregator.Build(moved, 8);
+    CHECK(FindShare(movedReport, "Sky.exe") && FindShare(movedReport, "Sky.exe")->self == 2);
+    CHECK_EQ(movedReport.hottest.size(), 3u);
+
+    aggregator.Reset();
+    CHECK_EQ(aggregator.Samples(), 0u);
+    const SampleProfile::Report empty = aggregator.Build(modules, 8);
+    CHECK_EQ(empty.samples, 0u);
+    CHECK(empty.modules.empty());
+    CHECK(empty.hottest.empty());
+}
+
+/**
+ * @brief A PE32+ image with headers and an exception directory, nothing else
+ */
+struct Image {
+    std::vector<uint32_t> words = std::vector<uint32_t>(0x2000 / 4);
+
+    uint8_t* Bytes() { return reinterpret_cast<uint8_t*>(words.data()); }
+    size_t Size() const { return words.size() * 4; }
+
+    void Put(size_t offset, uint32_t value) { memcpy(Bytes() + offset, &value, sizeof(value)); }
+
+    Image() {
+        constexpr uint32_t header = 0x80;
+        Put(0x3C, header);
+        Put(header, 0x00004550);
+        Put(header + 24, 0x20B);
+        Put(header + 24 + 108, 16);
+        Put(header + 24 + 112 + 3 * 8, 0x1000);
+        Put(header + 24 + 112 + 3 * 8 + 4, 3 * sizeof(SampleProfile::FunctionEntry));
+
+        // The second entry is a fragment of the first and shares its unwind data
+        const SampleProfile::FunctionEntry entries[] = {
+            { 0x1100, 0x1200, 0x1800 },
+            { 0x1200, 0x1250, 0x1000 | 1 },
+            { 0x1300, 0x1400, 0x1810 },
+        };
+        memcpy(Bytes() + 0x1000, entries, sizeof(entries));
+    }
+};
+
+void TestFunctionTable() {
+    Image image;
+    SampleProfile::FunctionTable table;
+    CHECK(table.Assign(image.Bytes(), image.Size()));
+    CHECK_EQ(table.Size(), 3u);
+
+    const SampleProfile::FunctionEntry* entry = table.Find(0x1100);
+    CHECK(entry && entry->unwind == 0x1800);
+    entry = table.Find(0x11FF);
+    CHECK(entry && entry->unwind == 0x1800);
+    entry = table.Find(0x1210);
+    CHECK(entry && entry->begin == 0x1100 && entry->unwind == 0x1800);
+    entry = table.Find(0x13FF);
+    CHECK(entry && entry->unwind == 0x1810);
+
+    // Leaf functions: before the first entry, between entries, after the last
+    CHECK(table.Find(0x10FF) == nullptr);
+    CHECK(table.Find(0x1250) == nullptr);
+    CHECK(table.Find(0x1400) == nullptr);
+
+    // An indirect entry pointing outside the image is not followed
+    image.Put(0x1000 + 12 + 8, 0x7FFFFFF1);
+    CHECK(table.Find(0x1210) == nullptr);
+
+    // Images without usable unwind data leave the table empty
+    Image noDirectory;
+    noDirectory.Put(0x80 + 24 + 108, 3);
+    CHECK(!table.Assign(noDirectory.Bytes(), noDirectory.Size()));
+    CHECK_EQ(table.Size(), 0u);
+    CHECK(table.Find(0x1100) == nullptr);
+
+    Image pe32;
+    pe32.Put(0x80 + 24, 0x10B);
+    CHECK(!table.Assign(pe32.Bytes(), pe32.Size()));
+
+    Image truncated;
+    CHECK(!table.Assign(truncated.Bytes(), 0x1010));
+}
+
+} // namespace
+
+int main() {
+    TestModuleMap();
+    TestAggregator();
+    TestFunctionTable();
+    return test::Finish("sample_profile_test");
+}
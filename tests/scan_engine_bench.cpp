@@ -0,0 +1,317 @@
+// ScanEngine: first and next scans checked against a plain reference scan,
+// with the AVX2 and scalar kernels, across chunk boundaries and both hit
+// encodings; then the throughput of First and Next over a synthetic buffer.
+//
+// Usage: scan_engine_bench [MiB]; the default keeps ctest quick, pass
+// several thousand to scan a multi-GB buffer. Configure with
+// -DCMAKE_BUILD_TYPE=Release for numbers comparable to the loader's build.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "include/scan_engine.h"
+#include "test.h"
+
+namespace {
+
+using ScanEngine::Query;
+using ScanEngine::ResultSet;
+
+constexpr size_t kChunkSize = 1u << 20; // ScanEngine's unit of work
+constexpr size_t kDefaultMiB = 64;
+
+using Hits = std::vector<std::pair<uintptr_t, std::vector<uint8_t>>>;
+
+void Fill(std::vector<uint8_t>& buffer, uint64_t seed) {
+    uint64_t state = seed;
+    size_t i = 0;
+    for (; i + 8 <= buffer.size(); i += 8) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        memcpy(&buffer[i], &state, 8);
+    }
+    for (; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<uint8_t>(i * 31);
+    }
+}
+
+template <typename T>
+void Put(std::vector<uint8_t>& buffer, size_t offset, T value) {
+    memcpy(&buffer[offset], &value, sizeof(value));
+}
+
+Query MakeQuery(ScanEngine::ValueType type, const void* value, size_t size, float tolerance = 0.0f) {
+    Query query;
+    query.type = type;
+    query.value.assign(static_cast<const uint8_t*>(value), static_cast<const uint8_t*>(value) + size);
+    query.tolerance = tolerance;
+    return query;
+}
+
+/**
+ * @brief Every hit a first scan of region should find, by reading it one position at a time
+ */
+Hits Reference(const ScanEngine::Region& region, const Query& query) {
+    Hits hits;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(region.base);
+    if (query.type == ScanEngine::VALUE_BYTES) {
+        const size_t length = query.value.size();
+        for (size_t i = 0; i + length <= region.size; ++i) {
+            if (memcmp(data + i, query.value.data(), length) == 0) {
+                hits.push_back({ region.base + i, query.value });
+            }
+        }
+        return hits;
+    }
+
+    for (size_t i = 0; i + 4 <= region.size; i += 4) {
+        bool match;
+        if (query.type == ScanEngine::VALUE_FLOAT) {
+            float v, wanted;
+            memcpy(&v, data + i, 4);
+            memcpy(&wanted, query.value.data(), 4);
+            match = std::fabs(v - wanted) <= query.tolerance;
+        } else {
+            match = memcmp(data + i, query.value.data(), 4) == 0;
+        }
+        if (match) {
+            hits.push_back({ region.base + i, std::vector<uint8_t>(data + i, data + i + 4) });
+        }
+    }
+    return hits;
+}
+
+/**
+ * @brief Decode every hit; for scans that keep no values, the query's value stands in
+ */
+Hits Collect(const ResultSet& results) {
+    Hits hits;
+    const size_t size = ScanEngine::ValueSize(results.query);
+    ScanEngine::ForEach(results, [&](uintptr_t address, const uint8_t* value) {
+        hits.push_back({ address, std::vector<uint8_t>(value, value + size) });
+        return true;
+    });
+    return hits;
+}
+
+/**
+ * @brief Compare addresses, and values unless the scan only promises the query's value
+ */
+bool SameHits(const Hits& actual, const Hits& expected, bool exactValues) {
+    if (actual.size() != expected.size()) {
+        fprintf(stderr, "%zu hits, expected %zu\n", actual.size(), expected.size());
+        return false;
+    }
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (actual[i].first != expected[i].first || (exactValues && actual[i].second != expected[i].second)) {
+            fprintf(stderr, "hit %zu at 0x%llx, expected 0x%llx\n", i,
+                static_cast<unsigned long long>(actual[i].first), static_cast<unsigned long long>(expected[i].first));
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Run a first scan with each kernel set the CPU has and check both against the reference
+ */
+void CheckFirst(const ScanEngine::Region& region, const Query& query, bool exactValues = false) {
+    const Hits expected = Reference(region, query);
+    CHECK(!expected.empty());
+    for (bool scalar : { false, true }) {
+        if (!scalar && !ScanEngine::HasAVX2()) {
+            continue;
+        }
+        ScanEngine::ForceScalar(scalar);
+        std::unique_ptr<ResultSet> results = ScanEngine::First({ region }, query);
+        CHECK(results != nullptr);
+        if (results) {
+            CHECK_EQ(results->count, expected.size());
+            CHECK(SameHits(Collect(*results), expected, exactValues));
+        }
+    }
+    ScanEngine::ForceScalar(false);
+}
+
+void TestChunkBoundaries() {
+    // Three chunks and a ragged tail, starting off alignment for the byte scan
+    std::vector<uint8_t> buffer(3 * kChunkSize + 4099 + 3);
+    Fill(buffer, 0x9E3779B97F4A7C15ull);
+    const ScanEngine::Region unaligned{ reinterpret_cast<uintptr_t>(buffer.data()) + 3, buffer.size() - 3 };
+    const size_t start = 3;
+
+    // A pattern straddling each chunk boundary, ending on one, and ending the region
+    const uint8_t pattern[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x42 };
+    for (size_t offset : { size_t(1), kChunkSize - 2, kChunkSize - 5, 2 * kChunkSize - 1, 3 * kChunkSize - 4,
+                           unaligned.size - sizeof(pattern) }) {
+        memcpy(&buffer[start + offset], pattern, sizeof(pattern));
+    }
+    CheckFirst(unaligned, MakeQuery(ScanEngine::VALUE_BYTES, pattern, sizeof(pattern)));
+
+    // A two-byte pattern takes the AVX2 path that confirms on first and last byte alone
+    const uint8_t pair[] = { 0x5A, 0xA5 };
+    memcpy(&buffer[start + kChunkSize - 1], pair, sizeof(pair));
+    CheckFirst(unaligned, MakeQuery(ScanEngine::VALUE_BYTES, pair, sizeof(pair)));
+
+    // Numbers at the first and last slot of every chunk and of the region
+    const ScanEngine::Region aligned{ reinterpret_cast<uintptr_t>(buffer.data()), buffer.size() };
+    const int32_t number = 0x12345678;
+    for (size_t chunk = 0; chunk < 4; ++chunk) {
+        Put(buffer, chunk * kChunkSize, number);
+        if (chunk < 3) Put(buffer, (chunk + 1) * kChunkSize - 4, number);
+    }
+    Put(buffer, (buffer.size() & ~size_t(3)) - 4, number);
+    CheckFirst(aligned, MakeQuery(ScanEngine::VALUE_INT32, &number, 4));
+
+    // Floats within tolerance match, NaN never does
+    const float health = 1.5f;
+    Put(buffer, 64, 1.5f);
+    Put(buffer, kChunkSize - 4, 1.5004f);
+    Put(buffer, 2 * kChunkSize, 1.4996f);
+    Put(buffer, 2 * kChunkSize + 4, 1.6f);
+    Put(buffer, 2 * kChunkSize + 8, std::numeric_limits<float>::quiet_NaN());
+    CheckFirst(aligned, MakeQuery(ScanEngine::VALUE_FLOAT, &health, 4, 0.001f));
+}
+
+void TestEncodings() {
+    // The first chunk is all hits and stored as a bitmap; the second has a few far apart, as LEB128 deltas
+    std::vector<uint8_t> buffer(2 * kChunkSize);
+    Fill(buffer, 42);
+    memset(buffer.data(), 0, kChunkSize);
+    const size_t sparse[] = { kChunkSize, kChunkSize + 4, kChunkSize + 512, kChunkSize + 300000, 2 * kChunkSize - 4 };
+    for (size_t offset : sparse) {
+        Put(buffer, offset, int32_t(0));
+    }
+
+    const ScanEngine::Region region{ reinterpret_cast<uintptr_t>(buffer.data()), buffer.size() };
+    const int32_t zero = 0;
+    std::unique_ptr<ResultSet> results = ScanEngine::First({ region }, MakeQuery(ScanEngine::VALUE_INT32, &zero, 4));
+    CHECK(results != nullptr);
+    if (!results) {
+        return;
+    }
+    CHECK_EQ(results->chunks.size(), 2u);
+    if (results->chunks.size() == 2) {
+        CHECK(results->chunks[0].bitmap);
+        CHECK(!results->chunks[1].bitmap);
+        CHECK_EQ(results->chunks[1].count, 5u);
+    }
+    CHECK(SameHits(Collect(*results), Reference(region, results->query), true));
+
+    // Raise every other dense hit and one sparse one; survivors keep their new values
+    for (size_t offset = 0; offset < kChunkSize; offset += 8) {
+        Put(buffer, offset, int32_t(offset / 8 + 1));
+    }
+    Put(buffer, kChunkSize + 512, int32_t(7));
+    CHECK(ScanEngine::Next(*results, ScanEngine::CONDITION_INCREASED));
+    Hits expected;
+    for (size_t offset = 0; offset < kChunkSize; offset += 8) {
+        const int32_t value = int32_t(offset / 8 + 1);
+        expected.push_back({ region.base + offset, std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(&value),
+                                                                          reinterpret_cast<const uint8_t*>(&value) + 4) });
+    }
+    const int32_t seven = 7;
+    expected.push_back({ region.base + kChunkSize + 512, std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(&seven),
+                                                                              reinterpret_cast<const uint8_t*>(&seven) + 4) });
+    CHECK_EQ(results->count, expected.size());
+    CHECK(SameHits(Collect(*results), expected, true));
+    if (results->chunks.size() == 2) {
+        CHECK(results->chunks[0].bitmap);
+        CHECK(!results->chunks[1].bitmap);
+    }
+
+    // Narrow to one value; the hits share it and store nothing
+    CHECK(ScanEngine::Next(*results, ScanEngine::CONDITION_EQUAL, expected.back().second));
+    CHECK_EQ(results->count, 2u);
+    const Hits sevens = Collect(*results);
+    CHECK(sevens.size() == 2 && sevens[0].first == region.base + 48 && sevens[1].first == region.base + kChunkSize + 512);
+    for (const ScanEngine::ChunkHits& hits : results->chunks) {
+        CHECK(hits.values.empty());
+    }
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Bench(size_t mib) {
+    std::vector<uint8_t> buffer(mib << 20);
+    Fill(buffer, 7);
+    const int32_t marker = 0x7E57AB1E;
+    for (size_t offset = 0; offset + 4 <= buffer.size(); offset += 4096) {
+        Put(buffer, offset, marker);
+    }
+
+    // Split like a process's memory map, into regions of a few sizes
+    std::vector<ScanEngine::Region> regions;
+    const size_t sizes[] = { 64u << 20, 3u << 20, 17u << 20, 256u << 10 };
+    for (size_t offset = 0, i = 0; offset < buffer.size(); ++i) {
+        const size_t size = std::min(sizes[i % 4], buffer.size() - offset);
+        regions.push_back({ reinterpret_cast<uintptr_t>(buffer.data()) + offset, size });
+        offset += size;
+    }
+
+    const float value = 1.0f;
+    const uint8_t pattern[] = { 0x1E, 0xAB, 0x57, 0x7E, 0x00 };
+    struct Case {
+        const char* name;
+        Query query;
+    } cases[] = {
+        { "int32", MakeQuery(ScanEngine::VALUE_INT32, &marker, 4) },
+        { "float", MakeQuery(ScanEngine::VALUE_FLOAT, &value, 4, 0.5f) },
+        { "bytes", MakeQuery(ScanEngine::VALUE_BYTES, pattern, 4) },
+    };
+
+    const double gigabytes = buffer.size() / 1e9;
+    for (const Case& test : cases) {
+        uint64_t counts[2] = {};
+        for (bool scalar : { false, true }) {
+            if (!scalar && !ScanEngine::HasAVX2()) {
+                continue;
+            }
+            ScanEngine::ForceScalar(scalar);
+            auto start = std::chrono::steady_clock::now();
+            std::unique_ptr<ResultSet> results = ScanEngine::First(regions, test.query);
+            const double first = Seconds(start);
+            CHECK(results != nullptr);
+            if (!results) {
+                continue;
+            }
+            counts[scalar] = results->count;
+
+            start = std::chrono::steady_clock::now();
+            CHECK(ScanEngine::Next(*results, ScanEngine::CONDITION_UNCHANGED));
+            const double next = Seconds(start);
+            printf("[+] %s %-6s First %7.2f GB/s, %llu hits in %zu KiB; Next %.1f ms\n", test.name,
+                scalar ? "scalar" : "AVX2", gigabytes / first, static_cast<unsigned long long>(counts[scalar]),
+                ScanEngine::Footprint(*results) >> 10, next * 1e3);
+        }
+        if (ScanEngine::HasAVX2()) {
+            CHECK_EQ(counts[0], counts[1]);
+        }
+    }
+    ScanEngine::ForceScalar(false);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t mib = argc > 1 ? strtoull(argv[1], nullptr, 10) : kDefaultMiB;
+    if (!ScanEngine::HasAVX2()) {
+        printf("[+] This CPU has no AVX2; only the scalar kernels are checked\n");
+    }
+
+    TestChunkBoundaries();
+    TestEncodings();
+    if (mib > 0) {
+        Bench(mib);
+    }
+    return test::Finish("scan_engine_bench");
+}
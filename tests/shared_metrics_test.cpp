@@ -0,0 +1,122 @@
+// SharedMetrics: the block's sequence lock, written and read through two
+// mappings of one POSIX shared-memory object as the loader and a tool would.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+#include "include/shared_metrics.h"
+#include "test.h"
+
+namespace {
+
+using SharedMetrics::Block;
+
+constexpr uint64_t kFrames = 200000;
+
+/**
+ * @brief Fill every field from one frame number, so a torn copy mixes numbers
+ */
+void Write(Block& block, uint64_t frame) {
+    const uint64_t writing = SharedMetrics::BeginWrite(block);
+    block.presents = frame;
+    block.timeUs = frame * 3;
+    block.frameMs = static_cast<float>(frame % 1000);
+    block.windowMessages = frame * 5;
+    block.logLines = frame * 7;
+    block.draws = static_cast<uint32_t>(frame);
+    block.submits = static_cast<uint32_t>(frame * 2);
+    block.modCount = SharedMetrics::kMaxMods;
+    for (SharedMetrics::ModMetrics& mod : block.mods) {
+        snprintf(mod.name, sizeof(mod.name), "mod %llu", static_cast<unsigned long long>(frame));
+        mod.renders = frame;
+    }
+    SharedMetrics::EndWrite(block, writing);
+}
+
+bool Consistent(const Block& copy) {
+    const uint64_t frame = copy.presents;
+    char name[48];
+    snprintf(name, sizeof(name), "mod %llu", static_cast<unsigned long long>(frame));
+    bool consistent = copy.timeUs == frame * 3 && copy.frameMs == static_cast<float>(frame % 1000) &&
+        copy.windowMessages == frame * 5 && copy.logLines == frame * 7 &&
+        copy.draws == static_cast<uint32_t>(frame) && copy.submits == static_cast<uint32_t>(frame * 2);
+    for (const SharedMetrics::ModMetrics& mod : copy.mods) {
+        consistent = consistent && mod.renders == frame && strcmp(mod.name, name) == 0;
+    }
+    return consistent;
+}
+
+void TestConcurrent(Block& writer, const Block& reader) {
+    // The segment starts zeroed, which is no frame the writer produces
+    Write(writer, 0);
+    std::atomic<bool> done{ false };
+    std::thread thread([&] {
+        for (uint64_t frame = 1; frame <= kFrames; ++frame) {
+            Write(writer, frame);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    // Every copy the reader accepts is one whole frame, and frames never go backwards
+    Block copy;
+    uint64_t snapshots = 0, torn = 0, last = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        if (!SharedMetrics::Snapshot(reader, copy)) {
+            continue;
+        }
+        ++snapshots;
+        torn += !Consistent(copy);
+        CHECK(copy.presents >= last);
+        last = copy.presents;
+    }
+    thread.join();
+
+    CHECK(snapshots > 0);
+    CHECK_EQ(torn, 0u);
+    CHECK(SharedMetrics::Snapshot(reader, copy));
+    CHECK_EQ(copy.presents, kFrames);
+    CHECK(Consistent(copy));
+}
+
+void TestInterruptedWrite(Block& writer, const Block& reader) {
+    // A loader that exited mid-write leaves the sequence odd; readers give up, the next loader recovers
+    SharedMetrics::BeginWrite(writer);
+    Block copy;
+    CHECK(!SharedMetrics::Snapshot(reader, copy));
+
+    Write(writer, 1);
+    CHECK(SharedMetrics::Snapshot(reader, copy));
+    CHECK_EQ(copy.presents, 1u);
+    CHECK_EQ(reader.sequence.load() & 1, 0u);
+}
+
+} // namespace
+
+int main() {
+    char name[64];
+    snprintf(name, sizeof(name), "/tsml_metrics_test_%d", static_cast<int>(getpid()));
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    CHECK(fd >= 0);
+    if (fd < 0) {
+        return test::Finish("shared_metrics_test");
+    }
+    shm_unlink(name);
+    CHECK_EQ(ftruncate(fd, sizeof(Block)), 0);
+
+    void* writer = mmap(nullptr, sizeof(Block), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void* reader = mmap(nullptr, sizeof(Block), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    CHECK(writer != MAP_FAILED && reader != MAP_FAILED);
+    if (writer != MAP_FAILED && reader != MAP_FAILED) {
+        TestConcurrent(*static_cast<Block*>(writer), *static_cast<const Block*>(reader));
+        TestInterruptedWrite(*static_cast<Block*>(writer), *static_cast<const Block*>(reader));
+        munmap(writer, sizeof(Block));
+        munmap(reader, sizeof(Block));
+    }
+    return test::Finish("shared_metrics_test");
+}
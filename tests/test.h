@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief Minimal checks for the tests; a failed check is reported and the test keeps going
+ */
+namespace test {
+    inline int failures = 0;
+
+    /**
+     * @brief Report the result; return it from main
+     */
+    inline int Finish(const char* name) {
+        if (failures > 0) {
+            fprintf(stderr, "[ERROR] %s: %d checks failed\n", name, failures);
+            return EXIT_FAILURE;
+        }
+        printf("[+] %s: all checks passed\n", name);
+        return EXIT_SUCCESS;
+    }
+} // namespace test
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++test::failures;                                                         \
+        }                                                                             \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                    \
+    do {                                                                              \
+        const auto actualValue = (actual);                                            \
+        const auto expectedValue = (expected);                                        \
+        if (!(actualValue == expectedValue)) {                                        \
+            fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, \
+                #actual, #expected, static_cast<long long>(actualValue), static_cast<long long>(expectedValue)); \
+            ++test::failures;                                                         \
+        }                                                                             \
+    } while (0)
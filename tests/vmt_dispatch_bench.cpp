@@ -0,0 +1,232 @@
+// VmtHooks: chain order through a patched vtable and a shadowed object,
+// then the cost of a call through chains of 1, 2 and 4 hooks against a plain
+// virtual call.
+//
+// Usage: vmt_dispatch_bench [calls]. libmem's VMT functions and the vtable
+// index are stubbed; hooks continue with VmtHooks::GetNext, which
+// ModApi::GetVmtNext forwards to.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <libmem.h>
+
+#include "include/vmt_hooks.h"
+#include "include/vtable_index.h"
+#include "test.h"
+
+// Writes the table in place and remembers the originals, as libmem does
+extern "C" {
+lm_bool_t LM_ProtMemory(lm_address_t, lm_size_t, lm_prot_t, lm_prot_t* oldprot) {
+    if (oldprot) *oldprot = LM_PROT_R;
+    return LM_TRUE;
+}
+
+lm_void_t LM_VmtNew(lm_address_t* vtable, lm_vmt_t* vmtbuf) {
+    vmtbuf->vtable = vtable;
+    vmtbuf->hkentries = nullptr;
+}
+
+lm_bool_t LM_VmtHook(lm_vmt_t* pvmt, lm_size_t fnindex, lm_address_t dst) {
+    pvmt->hkentries = new lm_vmt_entry_t{ pvmt->vtable[fnindex], fnindex, pvmt->hkentries };
+    pvmt->vtable[fnindex] = dst;
+    return LM_TRUE;
+}
+
+lm_void_t LM_VmtUnhook(lm_vmt_t* pvmt, lm_size_t fnindex) {
+    for (lm_vmt_entry_t** entry = &pvmt->hkentries; *entry; entry = &(*entry)->next) {
+        if ((*entry)->index == fnindex) {
+            lm_vmt_entry_t* found = *entry;
+            pvmt->vtable[fnindex] = found->orig_func;
+            *entry = found->next;
+            delete found;
+            return;
+        }
+    }
+}
+
+lm_address_t LM_VmtGetOriginal(const lm_vmt_t* pvmt, lm_size_t fnindex) {
+    for (const lm_vmt_entry_t* entry = pvmt->hkentries; entry; entry = entry->next) {
+        if (entry->index == fnindex) return entry->orig_func;
+    }
+    return pvmt->vtable[fnindex];
+}
+
+lm_void_t LM_VmtFree(lm_vmt_t* pvmt) {
+    while (pvmt->hkentries) {
+        lm_vmt_entry_t* next = pvmt->hkentries->next;
+        delete pvmt->hkentries;
+        pvmt->hkentries = next;
+    }
+}
+}
+
+namespace {
+
+constexpr size_t kSlots = 4;
+constexpr size_t kSlot = 2;
+constexpr size_t kDefaultCalls = 10'000'000;
+
+/**
+ * @brief An object as the game lays it out: the vtable pointer first
+ */
+struct Object {
+    uintptr_t* vtable;
+    uint32_t value;
+};
+
+using Fn = uint32_t (*)(Object*, uint32_t);
+
+uint32_t Original(Object* self, uint32_t x) {
+    return x + self->value;
+}
+
+uint32_t Other(Object*, uint32_t) {
+    return 0;
+}
+
+// Locator slot, then the functions
+uintptr_t classStorage[kSlots + 1];
+uintptr_t* const classVTable = &classStorage[1];
+
+ModVmtHook* handles[8];
+
+/**
+ * @brief Hook N continues the chain and appends its digit, so the result spells the order
+ */
+template <int N>
+uint32_t Hook(Object* self, uint32_t x) {
+    return reinterpret_cast<Fn>(VmtHooks::GetNext(handles[N]))(self, x) * 10 + N;
+}
+
+template <int N>
+ModVmtHook* AddClassHook(int priority = 0) {
+    handles[N] = VmtHooks::HookClass(reinterpret_cast<uintptr_t>(classVTable), kSlot, reinterpret_cast<void*>(&Hook<N>), priority);
+    return handles[N];
+}
+
+uint32_t Call(Object& object, uint32_t x) {
+    return reinterpret_cast<Fn>(object.vtable[kSlot])(&object, x);
+}
+
+void TestChains() {
+    Object first{ classVTable, 0 };
+    Object second{ classVTable, 0 };
+    CHECK_EQ(Call(first, 0), 0u);
+
+    // Unknown vtables and slots past the end are refused
+    CHECK(VmtHooks::HookClass(reinterpret_cast<uintptr_t>(&classStorage[0]), 0, reinterpret_cast<void*>(&Hook<1>), 0) == nullptr);
+    CHECK(VmtHooks::HookClass(reinterpret_cast<uintptr_t>(classVTable), kSlots, reinterpret_cast<void*>(&Hook<1>), 0) == nullptr);
+
+    // Equal priorities run in the order they were added
+    VmtHooks::BeginBatch();
+    CHECK(AddClassHook<1>() != nullptr);
+    CHECK(AddClassHook<2>() != nullptr);
+    CHECK_EQ(Call(first, 0), 0u); // Nothing is written until the batch ends
+    VmtHooks::EndBatch();
+    CHECK(AddClassHook<3>() != nullptr);
+    CHECK(AddClassHook<4>() != nullptr);
+    CHECK(VmtHooks::HookClass(reinterpret_cast<uintptr_t>(classVTable), kSlot, reinterpret_cast<void*>(&Hook<4>), 0) == nullptr); // Once per slot
+    CHECK_EQ(Call(first, 0), 4321u);
+
+    // Higher priority runs first; removing a hook closes the gap
+    CHECK(AddClassHook<5>(10) != nullptr);
+    CHECK_EQ(Call(first, 0), 43215u);
+    VmtHooks::Unhook(handles[5]);
+    VmtHooks::Unhook(handles[2]);
+    CHECK_EQ(Call(first, 0), 431u);
+
+    // An object's chain runs first and ends in its class's
+    handles[6] = VmtHooks::HookObject(&second, kSlot, reinterpret_cast<void*>(&Hook<6>), 0);
+    CHECK(handles[6] != nullptr);
+    CHECK(second.vtable != classVTable);
+    CHECK_EQ(Call(second, 0), 4316u);
+    CHECK_EQ(Call(first, 0), 431u);
+    CHECK(AddClassHook<2>() != nullptr);
+    CHECK_EQ(Call(second, 0), 24316u); // Added last among equals
+    VmtHooks::Unhook(handles[6]);
+    CHECK(second.vtable == classVTable);
+
+    // Off Windows every hook has no owner, so removing that module takes them all
+    VmtHooks::RemoveModule(nullptr);
+    CHECK_EQ(Call(first, 0), 0u);
+    CHECK(classVTable[kSlot] == reinterpret_cast<uintptr_t>(&Original));
+}
+
+double Measure(Object& object, size_t calls, uint32_t& sink) {
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t sum = 0;
+    for (size_t i = 0; i < calls; ++i) {
+        sum += Call(object, static_cast<uint32_t>(i));
+    }
+    sink += sum;
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+}
+
+/**
+ * @brief A compiled virtual call, kept opaque so the compiler cannot devirtualize it
+ */
+struct Native {
+    virtual ~Native() = default;
+    virtual uint32_t Call(uint32_t x) { return x + value; }
+    uint32_t value = 0;
+};
+
+void Bench(size_t calls) {
+    uint32_t sink = 0;
+    Native native;
+    Native* volatile opaque = &native;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+        sink += opaque->Call(static_cast<uint32_t>(i));
+    }
+    const double direct = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+    printf("[+] direct virtual call  %6.2f ns\n", direct);
+
+    Object object{ classVTable, 0 };
+    const double unhooked = Measure(object, calls, sink);
+    printf("[+] unhooked table       %6.2f ns\n", unhooked);
+
+    AddClassHook<1>();
+    const double one = Measure(object, calls, sink);
+    AddClassHook<2>();
+    const double two = Measure(object, calls, sink);
+    AddClassHook<3>();
+    AddClassHook<4>();
+    const double four = Measure(object, calls, sink);
+    // Per hook against the same call through the unhooked table
+    printf("[+] chain of 1           %6.2f ns, %+.2f ns per hook\n", one, one - unhooked);
+    printf("[+] chain of 2           %6.2f ns, %+.2f ns per hook\n", two, (two - unhooked) / 2);
+    printf("[+] chain of 4           %6.2f ns, %+.2f ns per hook\n", four, (four - unhooked) / 4);
+
+    handles[6] = VmtHooks::HookObject(&object, kSlot, reinterpret_cast<void*>(&Hook<6>), 0);
+    printf("[+] object + class of 4  %6.2f ns\n", Measure(object, calls, sink));
+
+    VmtHooks::RemoveModule(nullptr);
+    CHECK(object.vtable == classVTable);
+    printf("[+] (checksum %u)\n", sink);
+}
+
+} // namespace
+
+// Only classVTable is a vtable of "Sky.exe"
+namespace VTableIndex {
+size_t Slots(uintptr_t vtable) {
+    return vtable == reinterpret_cast<uintptr_t>(classVTable) ? kSlots : 0;
+}
+} // namespace VTableIndex
+
+int main(int argc, char** argv) {
+    const size_t calls = argc > 1 ? strtoull(argv[1], nullptr, 10) : kDefaultCalls;
+    classStorage[0] = 0x1234; // Stands in for the locator
+    for (size_t i = 0; i < kSlots; ++i) {
+        classVTable[i] = reinterpret_cast<uintptr_t>(i == kSlot ? &Original : &Other);
+    }
+
+    TestChains();
+    if (calls > 0) {
+        Bench(calls);
+    }
+    return test::Finish("vmt_dispatch_bench");
+}
@@ -0,0 +1,141 @@
+// WindowFilter: replays a stream of window messages through the window hook's
+// per-message decision, checks what it decides, and reports the cost per
+// message for mouse moves and raw input.
+//
+// Usage: window_filter_bench [messages]; configure with -DCMAKE_BUILD_TYPE=Release
+// for numbers comparable to the loader's own build.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#include "include/layer_config.h"
+#include "include/window_filter.h"
+#include "test.h"
+
+namespace {
+
+using namespace WindowFilter;
+
+constexpr uint32_t kMouseMove = 0x0200;
+constexpr uint32_t kInput = 0x00FF;
+constexpr uint32_t kSetCursor = 0x0020;
+constexpr uint32_t kNcHitTest = 0x0084;
+constexpr uint32_t kTimer = 0x0113;
+constexpr uint32_t kMouseWheel = 0x020A;
+
+struct Message {
+    uint32_t message;
+    uint64_t wParam;
+};
+
+void TestClassify() {
+    // Capture and trace are enabled by the config written in main
+    CHECK_EQ(Classify(kKeyDown, kMenuKey, false), ACTION_TOGGLE_MENU);
+    CHECK_EQ(Classify(kKeyDown, kMenuKey, true), ACTION_TOGGLE_MENU);
+    CHECK_EQ(Classify(kKeyDown, 0x7B, false), ACTION_SCREENSHOT);
+    CHECK_EQ(Classify(kKeyDown, 0x7A, true), ACTION_RECORDING);
+    CHECK_EQ(Classify(kKeyDown, 0x78, false), ACTION_TRACE);
+    CHECK_EQ(Classify(kKeyUp, 0x7B, false), ACTION_IMGUI);
+
+    // With the menu hidden only state ImGui has to keep up with reaches it; input
+    // messages are published on the way to the game, the rest pass straight through
+    CHECK_EQ(Classify(kMouseMove, 0, false), ACTION_GAME);
+    CHECK_EQ(Classify(kMouseWheel, 0, false), ACTION_GAME);
+    CHECK_EQ(Classify(kKeyDown, 'W', false), ACTION_GAME);
+    CHECK_EQ(Classify(kChar, 'w', false), ACTION_GAME);
+    CHECK_EQ(Classify(kInput, 0, false), ACTION_PASS);
+    CHECK_EQ(Classify(kSetCursor, 0, false), ACTION_PASS);
+    CHECK_EQ(Classify(kTimer, 0, false), ACTION_PASS);
+    CHECK_EQ(Classify(kLButtonUp, 0, false), ACTION_IMGUI);
+    CHECK_EQ(Classify(kKillFocus, 0, false), ACTION_IMGUI);
+    CHECK_EQ(Classify(kUser + 5, 0, false), ACTION_PASS);
+    CHECK_EQ(Classify(0xC123, 0, false), ACTION_PASS);
+
+    CHECK_EQ(Classify(kMouseMove, 0, true), ACTION_IMGUI);
+    CHECK_EQ(Classify(kUser + 5, 0, true), ACTION_IMGUI);
+}
+
+/**
+ * @brief What a game window sees while the player looks around: raw input and
+ *        mouse moves, with the odd hit test, cursor update, timer and key press
+ */
+std::vector<Message> Record(size_t count, uint32_t only) {
+    std::vector<Message> messages;
+    messages.reserve(count);
+    uint32_t random = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        random = random * 1664525u + 1013904223u;
+        if (only) {
+            messages.push_back({ only, 0 });
+            continue;
+        }
+        const uint32_t roll = (random >> 16) % 100;
+        if (roll < 45) messages.push_back({ kInput, 0 });
+        else if (roll < 85) messages.push_back({ kMouseMove, 0 });
+        else if (roll < 90) messages.push_back({ kNcHitTest, 0 });
+        else if (roll < 95) messages.push_back({ kSetCursor, 0 });
+        else if (roll < 97) messages.push_back({ kTimer, 0 });
+        else if (roll < 99) messages.push_back({ kKeyDown, 'W' });
+        else messages.push_back({ kKeyUp, 'W' });
+    }
+    return messages;
+}
+
+/**
+ * @brief The window hook up to the point it hands a message on, without the Win32 calls
+ * @return Messages that would have gone straight to the game
+ */
+size_t Replay(const std::vector<Message>& messages, bool menuVisible, uint64_t& counted) {
+    size_t game = 0;
+    for (const Message& message : messages) {
+        if (LayerConfig::IsEnabled(FEATURE_METRICS)) ++counted;
+        const Action action = Classify(message.message, message.wParam, menuVisible);
+        game += action == ACTION_GAME || action == ACTION_PASS;
+    }
+    return game;
+}
+
+void Bench(const char* name, uint32_t only, size_t count) {
+    const std::vector<Message> messages = Record(count, only);
+    for (bool menuVisible : { false, true }) {
+        uint64_t counted = 0;
+        Replay(messages, menuVisible, counted); // Warm up
+
+        const auto start = std::chrono::steady_clock::now();
+        const size_t game = Replay(messages, menuVisible, counted);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        // Nothing in these streams is a hotkey, and a visible menu sends everything to ImGui
+        if (menuVisible) {
+            CHECK_EQ(game, 0u);
+        } else if (only) {
+            CHECK_EQ(game, count);
+        }
+        printf("[+] %-12s menu %-7s %6.2f ns/message, %zu of %zu straight to the game\n", name,
+            menuVisible ? "visible" : "hidden", ns / count, game, count);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2000000;
+
+    {
+        std::ofstream config("window_filter_bench.json");
+        config << R"({ "layerFeatures": { "capture": true, "trace": true } })";
+    }
+    LayerConfig::Load("window_filter_bench.json");
+    std::remove("window_filter_bench.json");
+
+    TestClassify();
+    if (count > 0) {
+        Bench("WM_MOUSEMOVE", kMouseMove, count);
+        Bench("WM_INPUT", kInput, count);
+        Bench("mixed", 0, count);
+    }
+    return test::Finish("window_filter_bench");
+}
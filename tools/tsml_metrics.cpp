@@ -0,0 +1,73 @@
+// Prints the metrics a running loader publishes with the "sharedMetrics" layer feature.
+//
+// Usage: tsml_metrics [interval_ms]
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#define TSML_METRICS_READER
+#include "shared_metrics.h"
+
+using SharedMetrics::Block;
+
+namespace {
+
+void Print(const Block& block) {
+    printf("\x1b[H\x1b[J");
+    printf("TSML metrics  pid %u  presents %llu\n\n", block.processId, static_cast<unsigned long long>(block.presents));
+    printf("Frame         %7.2f ms  (avg %.2f, max %.2f)\n", block.frameMs, block.frameMsAverage, block.frameMsMax);
+    printf("Overlay       %7.2f ms\n", block.overlayMs);
+    printf("Draws         %7u      dispatches %u, submits %u\n", block.draws, block.dispatches, block.submits);
+    printf("Messages      %7llu\n", static_cast<unsigned long long>(block.windowMessages));
+    printf("Log lines     %7llu      %.1f/s\n\n", static_cast<unsigned long long>(block.logLines), block.logLinesPerSecond);
+
+    printf("%-32s %10s %10s %10s\n", "Mod", "renders", "last us", "avg us");
+    for (uint32_t i = 0; i < block.modCount && i < SharedMetrics::kMaxMods; ++i) {
+        const SharedMetrics::ModMetrics& mod = block.mods[i];
+        if (mod.renders == 0) {
+            continue;
+        }
+        printf("%-32.32s %10llu %10.1f %10.1f\n", mod.name, static_cast<unsigned long long>(mod.renders),
+            mod.renderUs, mod.renderUsAverage);
+    }
+    fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const DWORD interval = argc > 1 ? static_cast<DWORD>(strtoul(argv[1], nullptr, 10)) : 500;
+
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, SharedMetrics::kSegmentName);
+    if (!mapping) {
+        fprintf(stderr, "[ERROR] %s not found; is the game running with sharedMetrics enabled?\n", SharedMetrics::kSegmentName);
+        return EXIT_FAILURE;
+    }
+
+    const Block* shared = static_cast<const Block*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(Block)));
+    if (!shared) {
+        fprintf(stderr, "[ERROR] Failed to map %s: %lu\n", SharedMetrics::kSegmentName, GetLastError());
+        CloseHandle(mapping);
+        return EXIT_FAILURE;
+    }
+
+    Block block;
+    for (;;) {
+        if (SharedMetrics::Snapshot(*shared, block)) {
+            if (block.magic != SharedMetrics::kMagic || block.version != SharedMetrics::kVersion || block.size != sizeof(Block)) {
+                fprintf(stderr, "[ERROR] Metrics layout version %u does not match this reader (%u)\n",
+                    block.version, SharedMetrics::kVersion);
+                break;
+            }
+            Print(block);
+        }
+        Sleep(interval);
+    }
+
+    UnmapViewOfFile(shared);
+    CloseHandle(mapping);
+    return EXIT_FAILURE;
+}